@@ -0,0 +1,112 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "BootProfiler.hpp"
+#include <esp_timer.h>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseBoot";
+}
+
+BootProfiler BootProfile;
+
+BootProfiler::Scope::Scope(const char* name)
+    : index_(BootProfile.BeginPhase(name))
+{
+}
+
+BootProfiler::Scope::~Scope()
+{
+    BootProfile.EndPhase(index_);
+}
+
+int BootProfiler::BeginPhase(const char* name)
+{
+    // phases might get started concurrently (see ServiceStarter)
+    size_t index = phaseCount_++;
+    if (index >= kMaxPhases) {
+        phaseCount_ = kMaxPhases;
+        ESP_LOGD(kLoggingTag, "Boot report full, ignoring phase '%s'.", name);
+        return -1;
+    }
+
+    phases_[index].name = name;
+    phases_[index].startUs = esp_timer_get_time();
+    return index;
+}
+
+void BootProfiler::EndPhase(int index)
+{
+    if (index >= 0 && index < static_cast<int>(kMaxPhases))
+        phases_[index].endUs = esp_timer_get_time();
+}
+
+void BootProfiler::Finish()
+{
+    finishedUs_ = esp_timer_get_time();
+}
+
+bool BootProfiler::IsFinished() const
+{
+    return finishedUs_ != 0;
+}
+
+size_t BootProfiler::GetPhaseCount() const
+{
+    return phaseCount_.load();
+}
+
+const BootProfiler::Phase& BootProfiler::GetPhase(size_t index) const
+{
+    return phases_[index];
+}
+
+int64_t BootProfiler::GetTotalUs() const
+{
+    return finishedUs_;
+}
+
+void BootProfiler::Log() const
+{
+    ESP_LOGI(kLoggingTag, "*** Boot Report (ms since startup) ***");
+    for (size_t i = 0; i < GetPhaseCount(); i++) {
+        const Phase &phase = phases_[i];
+        int64_t endUs = getEndUs_(phase);
+        ESP_LOGI(kLoggingTag, "%-16s %6lld - %6lld  (%5lld ms)", phase.name, phase.startUs / 1000, endUs / 1000, (endUs - phase.startUs) / 1000);
+    }
+    ESP_LOGI(kLoggingTag, "Boot completed after %lld ms.", finishedUs_ / 1000);
+}
+
+void BootProfiler::ToJson(JsonObject root) const
+{
+    // fits easily into 32 bits, no need for ARDUINOJSON_USE_LONG_LONG
+    root["totalUs"] = static_cast<uint32_t>(finishedUs_);
+    JsonArray phases = root.createNestedArray("phases");
+    for (size_t i = 0; i < GetPhaseCount(); i++) {
+        const Phase &phase = phases_[i];
+        JsonObject phaseObject = phases.createNestedObject();
+        phaseObject["name"] = phase.name;
+        phaseObject["startUs"] = static_cast<uint32_t>(phase.startUs);
+        phaseObject["durationUs"] = static_cast<uint32_t>(getEndUs_(phase) - phase.startUs);
+    }
+}
+
+String BootProfiler::ToJsonString() const
+{
+    DynamicJsonDocument report(JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(kMaxPhases) + kMaxPhases * JSON_OBJECT_SIZE(3));
+    ToJson(report.to<JsonObject>());
+
+    String result;
+    serializeJson(report, result);
+    return result;
+}
+
+int64_t BootProfiler::getEndUs_(const Phase &phase) const
+{
+    // phases still running (e.g. Begin() waiting for readiness) are cut off at the end of the boot
+    return phase.endUs != 0 ? phase.endUs : (finishedUs_ != 0 ? finishedUs_ : phase.startUs);
+}
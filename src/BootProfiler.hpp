@@ -0,0 +1,65 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <Esp32Logging.hpp>
+#include <ArduinoJson.h>
+#include <atomic>
+
+
+// Records the timing of the boot phases (based on esp_timer, i.e. microseconds since startup) in a fixed-size report
+class BootProfiler {
+    public:
+        struct Phase {
+            const char* name;
+            int64_t startUs;
+            int64_t endUs;
+        };
+
+        // Measures the phase from construction until it goes out of scope
+        class Scope {
+            public:
+                explicit Scope(const char* name);
+                ~Scope();
+            private:
+                int index_;
+        };
+
+        static const constexpr size_t kMaxPhases = 24;
+
+        // Returns the phase index to be passed to EndPhase() or -1 if the report is full
+        int BeginPhase(const char* name);
+        void EndPhase(int index);
+        // Boot is considered complete with this call
+        void Finish();
+
+        bool IsFinished() const;
+        size_t GetPhaseCount() const;
+        const Phase& GetPhase(size_t index) const;
+        int64_t GetTotalUs() const;
+
+        void Log() const;
+        void ToJson(JsonObject root) const;
+        String ToJsonString() const;
+
+    private:
+        Phase phases_[kMaxPhases] = {};
+        std::atomic<size_t> phaseCount_{0};
+        int64_t finishedUs_ = 0;
+
+        int64_t getEndUs_(const Phase &phase) const;
+};
+
+extern BootProfiler BootProfile;
+
+#ifndef ESP32IOTBASE_NO_BOOT_PROFILER
+#define BOOT_PROFILER_CONCAT_(a, b) a##b
+#define BOOT_PROFILER_SCOPE_NAME_(line) BOOT_PROFILER_CONCAT_(bootPhaseScope, line)
+#define IOTBASE_BOOT_PHASE(name) BootProfiler::Scope BOOT_PROFILER_SCOPE_NAME_(__LINE__)(name)
+#else
+#define IOTBASE_BOOT_PHASE(name)
+#endif
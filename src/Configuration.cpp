@@ -5,6 +5,7 @@
    Licensed under GPLv3. See LICENSE for details.
    */
 #include "Configuration.hpp"
+#include "BootProfiler.hpp"
 
 namespace {
     const constexpr char* kLoggingTag = "IotBaseConfig";
@@ -16,6 +17,7 @@ Configuration::Configuration()
 }
 
 bool Configuration::Begin() {
+    IOTBASE_BOOT_PHASE("config");
 
     ESP_LOGD(kLoggingTag, "Initializing NVS flash");
     esp_err_t err = nvs_flash_init();
@@ -61,6 +63,7 @@ bool Configuration::Reset()
         ESP_LOGE(kLoggingTag, "Error erasing NVS flash: %#x (%s)", err, esp_err_to_name(err));
         return false;
     }
+    notifyChange_();
 
     return Save();
 }
@@ -86,6 +89,7 @@ void Configuration::Set(const char* key, const String &value) {
     if (err && err != ESP_ERR_NVS_NOT_FOUND) { // ESP_ERR_NVS_NOT_FOUND is to be expected when erasing
         ESP_LOGE(kLoggingTag, "Error writing or erasing string '%s' to NVS flash: %#x (%s)", key, err, esp_err_to_name(err));
     }
+    notifyChange_();
 }
 
 void Configuration::SetInt(const ConfigKey &key, int value) {
@@ -103,6 +107,7 @@ void Configuration::SetInt(const char* key, int value) {
     if (err) {
         ESP_LOGE(kLoggingTag, "Error writing int '%s' to NVS flash: %#x (%s)", key, err, esp_err_to_name(err));
     }
+    notifyChange_();
 }
 
 const String Configuration::Get(const ConfigKey &key, const String &defaultValue) const
@@ -187,3 +192,14 @@ int Configuration::GetInt(const char* key, int defaultValue) const
 
     return result;
 }
+
+void Configuration::OnChange(std::function<void()> changeFunc)
+{
+    changeFuncs_.push_back(changeFunc);
+}
+
+void Configuration::notifyChange_()
+{
+    for (const auto &changeFunc : changeFuncs_)
+        changeFunc();
+}
@@ -11,7 +11,9 @@
 #include <Esp32Logging.hpp>
 #include <nvs.h>
 #include <nvs_flash.h>
+#include <functional>
 #include <map>
+#include <vector>
 #include "enum.h"
 
 // 15 chars max due to NVS limit
@@ -57,6 +59,9 @@ class Configuration {
         int GetInt(const String &key, const int defaultValue = 0) const;
         int GetInt(const char* key, const int defaultValue = 0) const;
 
+        // called after every change (Set, SetInt, Reset), e.g. to invalidate cached data
+        void OnChange(std::function<void()> changeFunc);
+
         // unordered_map does not seem to work with String keys for whatever reason
         std::map<String, String> StringDefaults{
             {(+ConfigKey::SntpServer)._to_string(), "pool.ntp.org"},
@@ -64,6 +69,9 @@ class Configuration {
 
     private:
         nvs_handle nvsHandle_;
+        std::vector<std::function<void()>> changeFuncs_;
+
+        void notifyChange_();
 };
 
 #endif
\ No newline at end of file
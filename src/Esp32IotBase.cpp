@@ -5,16 +5,74 @@
    Licensed under GPLv3. See LICENSE for details.
    */
 
+#include <algorithm>
 #include <iomanip>
 #include "Esp32IotBase.hpp"
 #include "lwip/apps/sntp.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
 
 namespace {
     const constexpr char* kLoggingTag = "IotBase";
 
     const ulong kSystemInfoInterval = 1000UL * 60 * 5;   // 5 minutes
+    const ulong kStatusEventInterval = 1000UL * 5;          // only while anybody is listening at /events
+    // ArduinoOTA only offers polling (espota.py waits 10 seconds for its invitation to be answered)
+    const ulong kOtaPollInterval = 500;
 
-    std::vector<TaskHandle_t> tasksToWatch;
+    const constexpr EventBits_t kReadyBit = BIT0;
+
+#ifndef ESP32IOTBASE_NO_WEB
+    // static parts of the configuration UI, they stay in flash
+    constexpr UiElementDescriptor kUiHeading[] = {
+        { "heading", "h1", "", "#wrapper", nullptr, {{"class", "fat-border"}} },
+        { "logo", "img", "", "#heading", nullptr, {} },
+    };
+
+    constexpr UiElementDescriptor kUiConfigForm[] = {
+        // the configuration form, that will include all inputs for config data
+        { "configform", "form", "", "#wrapper", nullptr, {{"action", "#"}, {"onsubmit", "collectConfiguration()"}} },
+        { "infotext1", "p", "Configure your device with the following options (empty: use default value, space: override potential default with empty string):", "#configform", nullptr, {} },
+
+        UiFormInputDescriptor("DeviceName", "Device name", {"required", "1"}),
+
+        #ifndef ESP32IOTBASE_NETWORK_ETHERNET
+            UiFormInputDescriptor("WifiSsid", "WIFI SSID:"),
+            UiFormInputDescriptor("WifiPassword", "WIFI Password:", {"type", "password"}),
+        #endif
+
+        #ifndef ESP32IOTBASE_NO_SNTP
+            UiFormInputDescriptor("SntpServer", "SNTP Server"),
+            UiFormInputDescriptor("SntpTz", "SNTP TZ"),
+        #endif
+
+        #ifndef ESP32IOTBASE_NO_MQTT
+            UiFormInputDescriptor("MqttHost", "MQTT Host (format: host[:port]):"),
+            UiFormInputDescriptor("MqttUser", "MQTT User:"),
+            UiFormInputDescriptor("MqttPassword", "MQTT Password:", {"type", "password"}),
+            UiFormInputDescriptor("MqttTopicPrefix", "MQTT Topic Prefix (suggested 'esp32-iotbase'):"),
+            UiFormInputDescriptor("MqttHaDiscPref", "Home Assistant MQTT Discovery Topic Prefix (suggested 'homeassistant', empty to disable):"),
+        #endif
+
+        #ifndef ESP32IOTBASE_NO_OTA
+            UiFormInputDescriptor("OtaActive", "OTA Active:"),
+            UiFormInputDescriptor("OtaPassword", "OTA Password:", {"type", "password"}),
+        #endif
+
+        #ifndef ESP32IOTBASE_NO_SYSLOG
+            UiFormInputDescriptor("SyslogServer", "Syslog Server (space/empty to disable):"),
+        #endif
+
+        // save button that calls the JavaScript function collectConfiguration() on click
+        { "saveform", "button", "Save", "#configform", nullptr, {{"type", "submit"}} },
+    };
+
+    constexpr UiElementDescriptor kUiFooter[] = {
+        { "bootreport", "a", "Boot report", "#wrapper", nullptr, {{"href", "/bootreport.json"}} },
+        { "footer", "footer", "Powered by ", "body", nullptr, {} },
+        { "footerlink", "a", "Esp32IotBase", "footer", nullptr, {{"href", "https://github.com/felixstorm/Esp32IotBase"}, {"target", "_blank"}} },
+    };
+#endif
 }
 
 #ifndef ESP32IOTBASE_NO_SYSLOG
@@ -22,10 +80,14 @@ WiFiUDP Esp32ExtLogUdpClient;
 Esp32ExtendedLogging Esp32ExtLog;
 #endif
 
+// std::min() takes references
+const constexpr TickType_t Esp32IotBase::kMaxLoopWait;
+
 
-Esp32IotBase::Esp32IotBase(SetupModeWifiEncryption setupModeWifiEncryption, ConfigurationUI configurationUi) : 
+Esp32IotBase::Esp32IotBase(SetupModeWifiEncryption setupModeWifiEncryption, ConfigurationUI configurationUi, NetworkStartup networkStartup) : 
     setupModeWifiEncryption_(setupModeWifiEncryption), 
-    configurationUi_(configurationUi)
+    configurationUi_(configurationUi),
+    networkStartup_(networkStartup)
 {
 }
 
@@ -38,6 +100,33 @@ void Esp32IotBase::Begin(String fixedWiFiApEncryptionPassword)
     // esp_log_level_set("IotBaseMqtt", ESP_LOG_DEBUG);
 
     ESP_LOGI(kLoggingTag, "*** Esp32IotBase Startup ***");
+    IOTBASE_BOOT_PHASE("begin");
+
+    // Begin() gets called from the Arduino loop task
+    loopTask_ = xTaskGetCurrentTaskHandle();
+    readyEventGroup_ = xEventGroupCreate();
+    readyCallbacksMutex_ = xSemaphoreCreateMutex();
+
+    registerMetrics_();
+
+    // above loop(), so jobs are not delayed by whatever the sketch does there
+    Jobs.Begin();
+    xTaskCreateMonitored(JobScheduler::Run, "IotBaseJobs", 4096, &Jobs, 2);
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        Jobs.Every(TaskMonitor::kSampleInterval, [this]() { taskMonitor_.Sample(); }, "TaskSampling");
+    #endif
+    taskMonitor_.OnStall([this](const char* task, uint32_t lateMs, TaskMonitor::StallAction action)
+    {
+        String alert = String("{\"type\":\"taskStalled\",\"task\":\"") + task + "\",\"lateMs\":" + lateMs + ",\"action\":\""
+                       + TaskMonitor::GetStallActionName(action) + "\"}";
+        #ifndef ESP32IOTBASE_NO_MQTT
+            Mqtt.Publish(alert, false, "alert");
+        #endif
+        #ifndef ESP32IOTBASE_NO_WEB
+            Web.SendEvent("alert", alert);
+        #endif
+    });
+    Jobs.Every(TaskMonitor::kSupervisionInterval, [this]() { taskMonitor_.Supervise(); }, "TaskSupervision");
 
     Config.Begin();
 
@@ -46,10 +135,38 @@ void Esp32IotBase::Begin(String fixedWiFiApEncryptionPassword)
     IsConfigured = Config.Get(ConfigKey::DeviceName).length() > 0;
 
     // Have checkIfConfigNeedsReset() control if the device configuration should be reset or not.
-    handleQuickRebootsToResetConfig_();
+    {
+        IOTBASE_BOOT_PHASE("quickreboots");
+        handleQuickRebootsToResetConfig_();
+    }
+
+    // sketches typically react to the connection in loop(), registered before any network events can fire
+    Network.OnConnectionChange([this](bool connected, IPAddress localIp) { NotifyLoop(); });
+    // The callback lists are not guarded, so everything else reacting to network or MQTT events has to be registered here
+    // as well, before the event tasks start iterating them (SendEvent() does nothing as long as there are no clients).
+    #ifndef ESP32IOTBASE_NO_WEB
+        // live state for /events
+        Network.OnConnectionChange([this](bool connected, IPAddress localIp)
+        {
+                Web.SendEvent("network", String("{\"connected\":") + (connected ? "true" : "false") + ",\"ip\":\"" + localIp.toString() + "\"}");
+        });
+    #endif
+    #ifndef ESP32IOTBASE_NO_MQTT
+        #ifndef ESP32IOTBASE_NO_WEB
+            Mqtt.OnConnect([this]() { Web.SendEvent("mqtt", "{\"connected\":true}"); });
+            Mqtt.OnDisconnect([this]() { Web.SendEvent("mqtt", "{\"connected\":false}"); });
+        #endif
+        // will only ever fire if MQTT has been configured, setReady_() publishes it if already connected by then
+        Mqtt.OnConnect([this]()
+        {
+            if (BootProfile.IsFinished())
+                Mqtt.Publish(BootProfile.ToJsonString(), true, "bootreport");
+        });
+    #endif
 
     // Start network
-    Network.Begin(Config, Hostname, setupModeWifiEncryption_ == SetupModeWifiEncryption::secured, fixedWiFiApEncryptionPassword);
+    Network.Begin(Config, Hostname, setupModeWifiEncryption_ == SetupModeWifiEncryption::secured, fixedWiFiApEncryptionPassword,
+                  networkStartup_ == NetworkStartup::blocking);
 
     // Get MAC (WiFi STA or Ethernet)
     Mac = Network.GetMacAddress(":");
@@ -85,23 +202,113 @@ void Esp32IotBase::Begin(String fixedWiFiApEncryptionPassword)
     }
     ESP_LOGW(kLoggingTag, "***********************************************");
 
+    // bring up all services concurrently, each one as soon as its dependencies are available
+    // stack sizes include some headroom, the startup timeline logs how much has actually been used
+    auto network = startup_.Add("network", 0, [this]() {
+        // there is nothing to wait for in access point mode
+        if (Network.GetWiFiOperationMode() == NetworkControlBase::Mode::client) {
+            Network.WaitForConnection();
+            ESP_LOGI(kLoggingTag, "Network connected, IP-Address: %s", Network.GetIp().toString().c_str());
+        }
+    }, 3072);
     if (IsConfigured) {
-        checkConfigureSyslog_();
-        checkConfigureSntp_();
-        checkConfigureMqtt_();
-        checkConfigureOta_();
+        startup_.Add("syslog", network, [this]() { checkConfigureSyslog_(); }, 3072);
+        startup_.Add("sntp", network, [this]() { checkConfigureSntp_(); }, 3072);
+        // MQTT over TLS would additionally need to depend on SNTP (certificate validity)
+        startup_.Add("mqtt", network, [this]() { checkConfigureMqtt_(); }, 4096);
+        startup_.Add("ota", network, [this]() { checkConfigureOta_(); }, 4096);
     }
-    checkConfigureWebserver_();
+    // the web server and mDNS do not need an IP address to be set up
+    // (the web server builds the whole UI model and pre-renders the page prefix)
+    startup_.Add("webserver", 0, [this]() { checkConfigureWebserver_(); }, 8192);
+    startup_.Add("mdns", 0, [this]() { checkConfigureMdns_(); }, 4096);
+
+    startup_.Start([this]() {
+        startup_.LogTimeline();
+        setReady_();
+    }, kReadyStackSize);
+
+    if (networkStartup_ == NetworkStartup::blocking)
+        WaitUntilReady();
+}
+
+bool Esp32IotBase::IsReady()
+{
+    return readyEventGroup_ && (xEventGroupGetBits(readyEventGroup_) & kReadyBit);
+}
+
+bool Esp32IotBase::WaitUntilReady(TickType_t ticksToWait)
+{
+    if (!readyEventGroup_)
+        return false;
+
+    return (xEventGroupWaitBits(readyEventGroup_, kReadyBit, pdFALSE, pdTRUE, ticksToWait) & kReadyBit) != 0;
+}
+
+void Esp32IotBase::OnReady(std::function<void()> callback)
+{
+    // may be called before Begin()
+    bool isReady = false;
+    if (readyCallbacksMutex_)
+        xSemaphoreTake(readyCallbacksMutex_, portMAX_DELAY);
+    isReady = IsReady();
+    if (!isReady)
+        readyCallbacks_.push_back(callback);
+    if (readyCallbacksMutex_)
+        xSemaphoreGive(readyCallbacksMutex_);
+
+    // fire immediately if already ready
+    if (isReady)
+        callback();
+}
 
+void Esp32IotBase::setReady_()
+{
+    xSemaphoreTake(readyCallbacksMutex_, portMAX_DELAY);
+    xEventGroupSetBits(readyEventGroup_, kReadyBit);
+    std::vector<std::function<void()>> callbacks;
+    callbacks.swap(readyCallbacks_);
+    xSemaphoreGive(readyCallbacksMutex_);
+
+    ESP_LOGI(kLoggingTag, "*** Esp32IotBase Ready ***");
+
+    BootProfile.Finish();
+    BootProfile.Log();
+    #ifndef ESP32IOTBASE_NO_MQTT
+        // otherwise published by the callback registered in Begin() once connected
+        if (Mqtt.IsConnected())
+            Mqtt.Publish(BootProfile.ToJsonString(), true, "bootreport");
+    #endif
+
+    for (auto &callback : callbacks)
+        callback();
+    // e.g. to start polling OTA
+    NotifyLoop();
 }
 
 /**
  * This is the background task function for the Esp32IotBase class. To be called from Arduino loop.
  */
-void Esp32IotBase::Handle()
+void Esp32IotBase::Handle(TickType_t maxWait)
 {
+    // loop() must neither block forever (e.g. when there is nothing to poll) nor miss its own heartbeats
+    TickType_t wait = std::min(maxWait, kMaxLoopWait);
+    TickType_t heartbeatPeriod = TaskMonitor::GetHeartbeatPeriod();
+    if (heartbeatPeriod)
+        wait = std::min(wait, std::max<TickType_t>(heartbeatPeriod / 2, 1));
+    // ms until the next time something is due
+    auto waitAtMost = [&wait](ulong last, ulong interval) {
+        ulong elapsed = millis() - last;
+        wait = std::min(wait, pdMS_TO_TICKS(elapsed > interval ? 0 : interval - elapsed + 1));
+    };
+
     #ifndef ESP32IOTBASE_NO_OTA
-        ArduinoOTA.handle();
+        // OTA might still be getting started by the startup task
+        if (IsReady()) {
+            ArduinoOTA.handle();
+            if (otaConfigured_)
+                waitAtMost(millis(), kOtaPollInterval);
+        }
     #endif
 
     if (IsConfigured) {
@@ -111,36 +318,128 @@ void Esp32IotBase::Handle()
         {
             ESP_LOG_SYSINFO(ESP_LOG_INFO, lastSystemInfo == 0);
 
-            // when CONFIG_FREERTOS_USE_TRACE_FACILITY is defined, ESP_LOG_SYSINFO will already have included this
-            #ifndef CONFIG_FREERTOS_USE_TRACE_FACILITY
-                ESP_LOGI("SysInfo", "*** FreeRTOS Task Stack High Water Marks ***");
-                for(TaskHandle_t t : tasksToWatch) {
-                    ESP_LOGI("SysInfo", "%-15s (%p)  %u bytes", pcTaskGetTaskName(t), t, uxTaskGetStackHighWaterMark(t));
-                }
-            #endif
+            // ESP_LOG_SYSINFO includes the stack high water marks of all tasks with CONFIG_FREERTOS_USE_TRACE_FACILITY, but
+            // neither the placement nor the CPU usage
+            taskMonitor_.Log();
+
+            Jobs.LogStats();
+
+            ESP_LOGI("SysInfo", "*** Network Recovery Counters ***");
+            ESP_LOGI("SysInfo", "MQTT reconnect: %u, network reconnect: %u, network reinit: %u",
+                     Network.GetRecoveryCount(NetworkControlBase::RecoveryStage::mqttReconnect),
+                     Network.GetRecoveryCount(NetworkControlBase::RecoveryStage::networkReconnect),
+                     Network.GetRecoveryCount(NetworkControlBase::RecoveryStage::networkReinit));
+
+            if (lastSystemInfo) {
+                ESP_LOGI("SysInfo", "*** Main Loop ***");
+                ESP_LOGI("SysInfo", "Waiting %u%% of the time, %u wake-ups since the last report",
+                         static_cast<uint32_t>(systemInfoWaitTime_ / (10 * (millis() - lastSystemInfo))), systemInfoWakeups_);
+            }
+            systemInfoWaitTime_ = 0;
+            systemInfoWakeups_ = 0;
 
             lastSystemInfo = millis();
         }
+        waitAtMost(lastSystemInfo, kSystemInfoInterval);
     }
 
-    // be nice and let other tasks do stuff as well (although it does not seem to be strictly neccessary on core 1)
-    vTaskDelay(100 / portTICK_PERIOD_MS);
+    #ifndef ESP32IOTBASE_NO_WEB
+        static ulong lastStatusEvent = 0;
+        if (millis() - lastStatusEvent > kStatusEventInterval && Web.GetEventClientCount())
+        {
+            char status[160];
+            snprintf(status, sizeof(status), "{\"uptime\":%lu,\"heapFree\":%u,\"heapMin\":%u,\"connected\":%s"
+                     #ifndef ESP32IOTBASE_NETWORK_ETHERNET
+                         ",\"rssi\":%d"
+                     #endif
+                     "}", millis() / 1000, ESP.getFreeHeap(), ESP.getMinFreeHeap(), Network.IsConnected() ? "true" : "false"
+                     #ifndef ESP32IOTBASE_NETWORK_ETHERNET
+                         , WiFi.RSSI()
+                     #endif
+                     );
+            Web.SendEvent("status", status);
+            lastStatusEvent = millis();
+        }
+        // a client may connect at any time
+        waitAtMost(lastStatusEvent, kStatusEventInterval);
+    #endif
 
+    // sleeps until something is due or NotifyLoop() gets called
+    int64_t waitStart = esp_timer_get_time();
+    ulTaskNotifyTake(pdTRUE, wait);
+    int64_t waitTime = esp_timer_get_time() - waitStart;
+    loopWaitTime_ += waitTime;
+    loopWaitMetric_.Increment(loopWaitTime_ / 1000);
+    loopWaitTime_ %= 1000;
+    loopWakeupsMetric_.Increment();
+    systemInfoWaitTime_ += waitTime;
+    systemInfoWakeups_++;
 }
 
-// create tasks in a standardized fashion and add them to a watch list to be able to dump it's stack high water mark later on
-void Esp32IotBase::xTaskCreateMonitored(TaskFunction_t pvTaskCode, const char * const pcName, const uint32_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority)
+void Esp32IotBase::NotifyLoop()
 {
-    TaskHandle_t taskHandle;
-    int taskCreateResult;
-    // all our tasks (including AsyncTCP) run on core 1 for now (otherwise async_tcp task might sometimes block idle task on 0 causing watchdog exception)
-    if ((taskCreateResult = xTaskCreatePinnedToCore(pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, &taskHandle, CONFIG_ARDUINO_RUNNING_CORE)) != pdPASS)
+    if (!loopTask_)
+        return;
+    if (xPortInIsrContext()) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(loopTask_, &higherPriorityTaskWoken);
+        if (higherPriorityTaskWoken)
+            portYIELD_FROM_ISR();
+    } else {
+        xTaskNotifyGive(loopTask_);
+    }
+}
+
+// create tasks in a standardized fashion and add them to the task monitor to be able to dump their stack high water marks and CPU usage later on
+TaskHandle_t Esp32IotBase::xTaskCreateMonitored(TaskFunction_t pvTaskCode, const char * const pcName, const uint32_t usStackDepth, void * const pvParameters,
+                                                UBaseType_t uxPriority, BaseType_t xCoreID)
+{
+    TaskHandle_t taskHandle = taskMonitor_.Create(pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, xCoreID);
+    if (!taskHandle)
     {
-        ESP_LOGE(pcName, "ERROR calling xTaskCreate: %i, stopping.", taskCreateResult);
+        ESP_LOGE(pcName, "ERROR creating task, stopping.");
         for(;;);
     }
+    return taskHandle;
+}
 
-    tasksToWatch.push_back(taskHandle);
+void Esp32IotBase::registerMetrics_()
+{
+    MetricsRegistry::Gauge heapFree = Metrics.AddGauge("iotbase_heap_free_bytes", "Free heap");
+    MetricsRegistry::Gauge heapMinFree = Metrics.AddGauge("iotbase_heap_min_free_bytes", "Lowest free heap since startup");
+    MetricsRegistry::Gauge heapLargestBlock = Metrics.AddGauge("iotbase_heap_largest_free_block_bytes", "Largest allocatable block");
+    MetricsRegistry::Gauge uptime = Metrics.AddGauge("iotbase_uptime_seconds", "Time since startup");
+    MetricsRegistry::Gauge connected = Metrics.AddGauge("iotbase_network_connected", "Whether an IP address has been obtained");
+    #ifndef ESP32IOTBASE_NETWORK_ETHERNET
+        MetricsRegistry::Gauge rssi = Metrics.AddGauge("iotbase_wifi_rssi_dbm", "WiFi signal strength (0 if not connected)");
+    #endif
+    // maintained by NetworkControlBase, just mirrored on every scrape
+    const NetworkControlBase::RecoveryStage kRecoveryStages[] = { NetworkControlBase::RecoveryStage::mqttReconnect,
+        NetworkControlBase::RecoveryStage::networkReconnect, NetworkControlBase::RecoveryStage::networkReinit };
+    const char* kRecoveryStageLabels[] = { "stage=\"mqttReconnect\"", "stage=\"networkReconnect\"", "stage=\"networkReinit\"" };
+    MetricsRegistry::Counter recoveries[3];
+    for (size_t i = 0; i < 3; i++)
+        recoveries[i] = Metrics.AddCounter("iotbase_network_recoveries_total", "Network activity resumed after entering the recovery stage", kRecoveryStageLabels[i]);
+
+    Metrics.AddCollector([=]()
+    {
+        heapFree.Set(ESP.getFreeHeap());
+        heapMinFree.Set(ESP.getMinFreeHeap());
+        heapLargestBlock.Set(heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+        uptime.Set(esp_timer_get_time() / 1000000);
+        bool isConnected = Network.IsConnected();
+        connected.Set(isConnected);
+        #ifndef ESP32IOTBASE_NETWORK_ETHERNET
+            rssi.Set(isConnected ? WiFi.RSSI() : 0);
+        #endif
+        for (size_t i = 0; i < 3; i++)
+            recoveries[i].SetTotal(Network.GetRecoveryCount(kRecoveryStages[i]));
+    });
+
+    taskMonitor_.Begin();
+    taskMonitor_.Add(loopTask_, CONFIG_ARDUINO_RUNNING_CORE);
+    loopWaitMetric_ = Metrics.AddCounter("iotbase_loop_wait_milliseconds_total", "Time Handle() spent waiting for something to do");
+    loopWakeupsMetric_ = Metrics.AddCounter("iotbase_loop_wakeups_total", "Times Handle() has been woken");
 }
 
 String Esp32IotBase::getCleanHostnameFromDeviceName_()
@@ -248,6 +547,8 @@ void Esp32IotBase::checkConfigureMqtt_()
         ESP_LOGI(kLoggingTag, "* MQTT: Configuring & connecting ...");
         Mqtt.BeginWithHost(mqttHost, Config.Get(ConfigKey::MqttUser), Config.Get(ConfigKey::MqttPassword),
                            Hostname, Config.Get(ConfigKey::MqttHaDiscPref));
+        // first stage of the network recovery
+        Network.SetMqttReconnectFunction([this]() { Mqtt.Reconnect(); });
         ESP_LOGI(kLoggingTag, "* MQTT: -> Configuration completed.");
     } else {
         ESP_LOGI(kLoggingTag, "* MQTT: Not configured.");
@@ -273,6 +574,7 @@ void Esp32IotBase::checkConfigureOta_()
 
         // Set OTA hostname
         ArduinoOTA.setHostname(Hostname.c_str());
+        // ArduinoOTA writes straight to flash, compressed images and patches are only accepted by POST /update (see WebServer)
 
         // The following code is copied verbatim from the ESP32 BasicOTA.ino example
         // This is the callback for the beginning of the OTA process
@@ -306,6 +608,7 @@ void Esp32IotBase::checkConfigureOta_()
 
         // Start the OTA service
         ArduinoOTA.begin();
+        otaConfigured_ = true;
 
         ESP_LOGI(kLoggingTag, "* OTA: -> Configuration completed.");
     } else {
@@ -319,8 +622,7 @@ void Esp32IotBase::checkConfigureWebserver_()
 {
 #ifndef ESP32IOTBASE_NO_WEB
 
-    if (configurationUi_ == ConfigurationUI::always ||
-       (configurationUi_ == ConfigurationUI::accessPoint && Network.GetWiFiOperationMode() == NetworkControlBase::Mode::accessPoint))
+    if (isWebserverEnabled_())
     {
         ESP_LOGI(kLoggingTag, "* Web Server: Configuring ...");
 
@@ -333,72 +635,24 @@ void Esp32IotBase::checkConfigureWebserver_()
 
         Web.UiAddElement("title", "title", deviceName,"head");
 
-        // Add a webinterface element for the h1 that contains the device name. It is a child of the #wrapper-element.
-        Web.UiAddElement("heading", "h1", "", "#wrapper"); Web.UiSetLastEleAttr("class", "fat-border");
-        Web.UiAddElement("logo", "img", "", "#heading"); Web.UiSetLastEleAttr("src", "/logo.svg");
+        // h1 that contains the logo and the device name
+        Web.UiAddElements(kUiHeading);
+        Web.UiSetElementAttribute("logo", "src", String("/logo.svg?v=") + k_logo_svg_hash);
         Web.UiAddElement("devicename", "span", deviceName,"#heading");
 
-        // Add the configuration form, that will include all inputs for config data
-        Web.UiAddElement("configform", "form", "", "#wrapper"); Web.UiSetLastEleAttr("action", "#"); Web.UiSetLastEleAttr("onsubmit", "collectConfiguration()");
-        Web.UiAddElement("infotext1", "p", "Configure your device with the following options (empty: use default value, space: override potential default with empty string):", "#configform");
-
-        Web.UiAddFormInput(ConfigKey::DeviceName, "Device name"); Web.UiSetLastEleAttr("required", "1");
-
-        #ifndef ESP32IOTBASE_NETWORK_ETHERNET
-            // Add an input field for the WIFI data and link it to the corresponding configuration data
-            Web.UiAddFormInput(ConfigKey::WifiSsid, "WIFI SSID:");
-            Web.UiAddFormInput(ConfigKey::WifiPassword, "WIFI Password:"); Web.UiSetLastEleAttr("type", "password");
-        #endif
-
-        #ifndef ESP32IOTBASE_NO_SNTP
-            Web.UiAddFormInput(ConfigKey::SntpServer, "SNTP Server");
-            Web.UiAddFormInput(ConfigKey::SntpTz, "SNTP TZ");
-        #endif
-
-        #ifndef ESP32IOTBASE_NO_MQTT
-            // Add input fields for MQTT configurations
-            Web.UiAddFormInput(ConfigKey::MqttHost, "MQTT Host (format: host[:port]):");
-            Web.UiAddFormInput(ConfigKey::MqttUser, "MQTT User:");
-            Web.UiAddFormInput(ConfigKey::MqttPassword, "MQTT Password:"); Web.UiSetLastEleAttr("type", "password");
-            Web.UiAddFormInput(ConfigKey::MqttTopicPrefix, "MQTT Topic Prefix (suggested 'esp32-iotbase'):");
-            Web.UiAddFormInput(ConfigKey::MqttHaDiscPref, "Home Assistant MQTT Discovery Topic Prefix (suggested 'homeassistant', empty to disable):");
-        #endif
-
-        #ifndef ESP32IOTBASE_NO_OTA
-            Web.UiAddFormInput(ConfigKey::OtaActive, "OTA Active:");
-            Web.UiAddFormInput(ConfigKey::OtaPassword, "OTA Password:"); Web.UiSetLastEleAttr("type", "password");
-        #endif
-
-        #ifndef ESP32IOTBASE_NO_SYSLOG
-            Web.UiAddFormInput(ConfigKey::SyslogServer, "Syslog Server (space/empty to disable):");
-        #endif
-
-        // Add a save button that calls the JavaScript function collectConfiguration() on click
-        Web.UiAddElement("saveform", "button", "Save", "#configform"); Web.UiSetLastEleAttr("type", "submit");
+        Web.UiAddElements(kUiConfigForm);
 
         // Show the devices MAC in the Webinterface
         Web.UiAddElement("infotext2", "p", "This device has the MAC-Address: " + Mac, "#wrapper");
 
-        Web.UiAddElement("footer", "footer", "Powered by ", "body");
-        Web.UiAddElement("footerlink", "a", "Esp32IotBase", "footer"); Web.UiSetLastEleAttr("href", "https://github.com/felixstorm/Esp32IotBase"); Web.UiSetLastEleAttr("target", "_blank");
-
-        #ifndef ESP32IOTBASE_NO_MDNS
-                ESP_LOGI(kLoggingTag, "* MDNS responder: Configuring ...");
-                if (MDNS.begin(Hostname.c_str())) {
-                    MDNS.addService("http", "tcp", 80);
-                    ESP_LOGI(kLoggingTag, "* MDNS responder: -> Configuration completed.");
-                } else {
-                    ESP_LOGE(kLoggingTag, "* MDNS responder: -> ERROR: Configuration failed!");
-                }
-        #endif
+        Web.UiAddElements(kUiFooter);
 
         #ifndef ESP32IOTBASE_NO_CAPTIVE_PORTAL
             if (Network.GetWiFiOperationMode() == NetworkControlBase::Mode::accessPoint) {
                 ESP_LOGI(kLoggingTag, "* Initializing captive portal (web request handler & wildcard DNS server)");
                 IPAddress softApIp = Network.GetSoftApIp();
                 Web.AddCaptiveRequestHandler(softApIp);
-                dnsServer_.start(53, "*", softApIp);
-                xTaskCreatePinnedToCore(&dnsHandlerTask_, "IotBaseDns", 4096, (void*) &dnsServer_, 5, NULL, CONFIG_ARDUINO_RUNNING_CORE);
+                CaptiveDns.Begin(softApIp);
             }
         #endif
 
@@ -408,6 +662,18 @@ void Esp32IotBase::checkConfigureWebserver_()
             delay(2000);
             ESP.restart();
         };
+        Web.SetConfigApplyFunction([this](const ConfigKey &key)
+        {
+                #ifndef ESP32IOTBASE_NO_SNTP
+                    if (key == +ConfigKey::SntpTz) {
+                        setenv("TZ", Config.Get(ConfigKey::SntpTz).c_str(), 1);
+                        tzset();
+                        return true;
+                    }
+                #endif
+                // everything else only gets read during startup
+                return false;
+        });
         Web.Begin(Config, restartAfterSubmit);
 
         ESP_LOGI(kLoggingTag, "* Web Server: -> Configuration completed.");
@@ -418,17 +684,31 @@ void Esp32IotBase::checkConfigureWebserver_()
 #endif
 }
 
-// handles DNS requests from clients for the captive portal
-void Esp32IotBase::dnsHandlerTask_(void* dnsServerPointer)
+void Esp32IotBase::checkConfigureMdns_()
 {
-    #ifndef ESP32IOTBASE_NO_CAPTIVE_PORTAL
-        DNSServer* DnsServer = (DNSServer*) dnsServerPointer;
-        while(1) {
-            DnsServer->processNextRequest();
-            vTaskDelay(100);
+#if !(defined(ESP32IOTBASE_NO_WEB) || defined(ESP32IOTBASE_NO_MDNS))
+
+    // only needed to find the web server
+    if (isWebserverEnabled_()) {
+        ESP_LOGI(kLoggingTag, "* MDNS responder: Configuring ...");
+        if (MDNS.begin(Hostname.c_str())) {
+            MDNS.addService("http", "tcp", 80);
+            ESP_LOGI(kLoggingTag, "* MDNS responder: -> Configuration completed.");
+        } else {
+            ESP_LOGE(kLoggingTag, "* MDNS responder: -> ERROR: Configuration failed!");
         }
-    #endif
-};
+    } else {
+        ESP_LOGI(kLoggingTag, "* MDNS responder: Not configured.");
+    }
+
+#endif
+}
+
+bool Esp32IotBase::isWebserverEnabled_()
+{
+    return configurationUi_ == ConfigurationUI::always ||
+           (configurationUi_ == ConfigurationUI::accessPoint && Network.GetWiFiOperationMode() == NetworkControlBase::Mode::accessPoint);
+}
 
 void IotBase_ResetNetworkConnectedWatchdog()
 {
@@ -7,7 +7,12 @@
 #pragma once
 
 #include <Esp32ExtendedLogging.hpp>
+#include "BootProfiler.hpp"
+#include "JobScheduler.hpp"
+#include "Metrics.hpp"
+#include "TaskMonitor.hpp"
 #include "Configuration.hpp"
+#include "ServiceStarter.hpp"
 #include <rom/rtc.h>
 
 #ifndef ESP32IOTBASE_NETWORK_ETHERNET
@@ -35,7 +40,7 @@
 #endif
 
 #if !(defined(ESP32IOTBASE_NO_WEB) || defined(ESP32IOTBASE_NO_CAPTIVE_PORTAL))
-#include <DNSServer.h>
+#include "WebServer/CaptiveDnsServer.hpp"
 #endif
 
 class Esp32IotBase
@@ -55,9 +60,17 @@ class Esp32IotBase
             accessPoint,        ///< Only start the server if acting as an access  (first setup mode)
         };
 
+        // Whether Begin() waits for the network connection
+        enum class NetworkStartup
+        {
+            blocking,           ///< Begin() returns once the network is connected and all services have been started
+            nonBlocking,        ///< Begin() returns immediately, network dependent services start once an IP has been obtained
+        };
+
         explicit Esp32IotBase(Esp32IotBase::SetupModeWifiEncryption setupModeWifiEncryption =
             Esp32IotBase::SetupModeWifiEncryption::none,
-            Esp32IotBase::ConfigurationUI configurationUi = Esp32IotBase::ConfigurationUI::always);
+            Esp32IotBase::ConfigurationUI configurationUi = Esp32IotBase::ConfigurationUI::always,
+            Esp32IotBase::NetworkStartup networkStartup = Esp32IotBase::NetworkStartup::blocking);
 
         ~Esp32IotBase() = default;
 
@@ -67,7 +80,30 @@ class Esp32IotBase
          * SetupModeWifiEncryption will be overriden to SetupModeWifiEncryption::secure.
         */
         void Begin(String fixedWiFiApEncryptionPassword = {});
-        void Handle();
+        /** To be called from loop().
+         * Does whatever is due and then blocks until woken by NotifyLoop(), the next internal deadline or maxWait. So by
+         * default loop() runs at least once a second rather than every 100 ms as with older versions, pass e.g.
+         * pdMS_TO_TICKS(100) if the sketch itself polls something in loop(). Never blocks for more than kMaxLoopWait, nor
+         * for more than half the heartbeat period if loop() has called ExpectHeartbeats().
+        */
+        static const constexpr TickType_t kDefaultLoopWait = pdMS_TO_TICKS(1000);
+        static const constexpr TickType_t kMaxLoopWait = pdMS_TO_TICKS(60 * 1000);
+        void Handle(TickType_t maxWait = kDefaultLoopWait);
+        /** Wakes Handle() (and thus loop()), e.g. from callbacks running on other tasks. May be called from ISRs.
+         * Uses the loop task's notification value, which the sketch must not use otherwise.
+        */
+        void NotifyLoop();
+
+        /** Readiness (network connected and all services started).
+         * Only relevant for NetworkStartup::nonBlocking, as Begin() will not return before that otherwise.
+         * Callbacks are run on a startup task (or immediately if already ready), which has a stack of kReadyStackSize
+         * bytes shared with the boot report - anything heavier should be handed over to a task of its own.
+         * The startup timeline in the log shows how much of it has been used.
+        */
+        static const constexpr uint32_t kReadyStackSize = 8192;
+        bool IsReady();
+        bool WaitUntilReady(TickType_t ticksToWait = portMAX_DELAY);
+        void OnReady(std::function<void()> callback);
 
         Configuration Config;
         String Hostname;
@@ -89,14 +125,51 @@ class Esp32IotBase
         WebServer Web;
 #endif
 
-        void xTaskCreateMonitored(TaskFunction_t pvTaskCode, const char * const pcName, const uint32_t usStackDepth, void * const pvParameters, UBaseType_t uxPriority);
+#if !(defined(ESP32IOTBASE_NO_WEB) || defined(ESP32IOTBASE_NO_CAPTIVE_PORTAL))
+        CaptiveDnsServer CaptiveDns;
+#endif
+
+        /** Short periodic or one-shot jobs of the application, all run on one task (started by Begin()).
+         * Cheaper than a task per job (see xTaskCreateMonitored()) as long as no job blocks for long.
+        */
+        JobScheduler Jobs;
+
+        /** Creates a task and keeps track of its stack (and CPU usage, see TaskMonitor), halts if that fails.
+         * xCoreID: 0, 1, tskNO_AFFINITY or TaskMonitor::kLeastLoadedCore. The default keeps everything off core 0, where
+         * a busy task (e.g. async_tcp) might starve the idle task and thus trigger the task watchdog.
+        */
+        TaskHandle_t xTaskCreateMonitored(TaskFunction_t pvTaskCode, const char * const pcName, const uint32_t usStackDepth, void * const pvParameters,
+                                          UBaseType_t uxPriority, BaseType_t xCoreID = CONFIG_ARDUINO_RUNNING_CORE);
+        /** To be called by a monitored task (or loop()) that then has to call Heartbeat() at least every periodMs.
+         * Missed heartbeats are published as alert (MQTT topic suffix 'alert' and 'alert' event on /events) and may
+         * restart the task or the device. Tasks running on Jobs cannot be supervised, as that is where supervision runs.
+        */
+        bool ExpectHeartbeats(uint32_t periodMs, TaskMonitor::StallAction action = TaskMonitor::StallAction::alert) { return taskMonitor_.ExpectHeartbeats(periodMs, action); }
+        static void Heartbeat() { TaskMonitor::Heartbeat(); }
         void ResetNetworkConnectedWatchdog() { Network.ResetNetworkConnectedWatchdog(); }
 
     private:
         SetupModeWifiEncryption setupModeWifiEncryption_;
         ConfigurationUI configurationUi_;
+        NetworkStartup networkStartup_;
+
+        TaskHandle_t loopTask_ = 0;
+        TaskMonitor taskMonitor_;
+        bool otaConfigured_ = false;
+        int64_t loopWaitTime_ = 0;              ///< not yet counted in loopWaitMetric_ (us)
+        int64_t systemInfoWaitTime_ = 0;        ///< since the last system information dump (us)
+        uint32_t systemInfoWakeups_ = 0;
+        MetricsRegistry::Counter loopWaitMetric_;
+        MetricsRegistry::Counter loopWakeupsMetric_;
+
+        EventGroupHandle_t readyEventGroup_ = 0;
+        SemaphoreHandle_t readyCallbacksMutex_ = 0;
+        std::vector<std::function<void()>> readyCallbacks_;
+        ServiceStarter startup_;
+        void setReady_();
 
         String getCleanHostnameFromDeviceName_();
+        void registerMetrics_();
 
         void handleQuickRebootsToResetConfig_();
         static void resetquickRebootCounterTimer_(TimerHandle_t xTimer);
@@ -106,11 +179,8 @@ class Esp32IotBase
         void checkConfigureMqtt_();
         void checkConfigureOta_();
         void checkConfigureWebserver_();
-
-#if !(defined(ESP32IOTBASE_NO_WEB) || defined(ESP32IOTBASE_NO_CAPTIVE_PORTAL))
-        DNSServer dnsServer_;
-        static void dnsHandlerTask_(void* dnsServerPointer);
-#endif
+        void checkConfigureMdns_();
+        bool isWebserverEnabled_();
 };
 
 extern Esp32IotBase IotBase;
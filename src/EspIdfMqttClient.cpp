@@ -3,6 +3,8 @@
 
 namespace {
     const constexpr char* kLoggingTag = "IotBaseMqtt";
+
+    const constexpr uint32_t kPublishSizeBounds[] = {64, 256, 1024, 4096};
 }
 
 EspIdfMqttClient& EspIdfMqttClient::BeginWithHost(const String& mqttHost, const String& mqttUser, const String& mqttPassword, const String& deviceName, const String& haDiscoveryTopicPrefix, const String& baseTopic)
@@ -28,6 +30,8 @@ EspIdfMqttClient& EspIdfMqttClient::BeginWithUri(const String& mqttUri, const St
              mqttUri.c_str(), deviceName.c_str(), haDiscoveryTopicPrefix.c_str(), baseTopic.c_str());
 
     if (!mqttUri.isEmpty()) {
+        registerMetrics_();
+
         uint8_t rawMac[6];
         char macString[sizeof(rawMac) * 2 + 1];
         esp_read_mac(rawMac, ESP_MAC_WIFI_STA);
@@ -68,6 +72,24 @@ EspIdfMqttClient& EspIdfMqttClient::OnConnect(OnConnectUserCallback callback) {
 
 }
 
+EspIdfMqttClient& EspIdfMqttClient::OnDisconnect(OnDisconnectUserCallback callback) {
+
+  _onDisconnectUserCallbacks.push_back(callback);
+  return *this;
+
+}
+
+void EspIdfMqttClient::Reconnect()
+{
+    if (!mqttClient)
+        return;
+
+    ESP_LOGW(kLoggingTag, "Reconnecting");
+    esp_mqtt_client_stop(mqttClient);
+    isConnected_ = false;
+    esp_mqtt_client_start(mqttClient);
+}
+
 esp_err_t EspIdfMqttClient::StaticEventHandler(esp_mqtt_event_handle_t event)
 {
     ESP_LOGD(kLoggingTag, "Event received: %d", event->event_id);
@@ -85,6 +107,7 @@ esp_err_t EspIdfMqttClient::EventHandler(esp_mqtt_event_handle_t event)
         ESP_LOGI(kLoggingTag, "Connected");
         IotBase_ResetNetworkConnectedWatchdog();
         isConnected_ = true;
+        connectsMetric_.Increment();
         for (auto callback : _onConnectUserCallbacks)
             callback();
         break;
@@ -92,10 +115,17 @@ esp_err_t EspIdfMqttClient::EventHandler(esp_mqtt_event_handle_t event)
     case MQTT_EVENT_DISCONNECTED:
         ESP_LOGI(kLoggingTag, "Disconnected");
         isConnected_ = false;
+        disconnectsMetric_.Increment();
+        for (auto callback : _onDisconnectUserCallbacks)
+            callback();
         break;
     
-    case MQTT_EVENT_PUBLISHED:
     case MQTT_EVENT_DATA:
+        receivedMetric_.Increment();
+        IotBase_ResetNetworkConnectedWatchdog();
+        break;
+
+    case MQTT_EVENT_PUBLISHED:
         IotBase_ResetNetworkConnectedWatchdog();
         break;
 
@@ -121,6 +151,10 @@ void EspIdfMqttClient::Publish(const String& message, bool retain /* = false */,
         if (isConnected_ && publishResult >= 0)
             IotBase_ResetNetworkConnectedWatchdog();
     }
+    if (publishResult >= 0)
+        publishSizeMetric_.Observe(message.length());
+    else
+        publishFailuresMetric_.Increment();
 
     ESP_LOGI(kLoggingTag, "publish result: %i", publishResult);
 }
@@ -221,3 +255,17 @@ void EspIdfMqttClient::cleanIdStringForHomeAssistant(String& haIdString)
 
     ESP_LOGD(kLoggingTag, "After: %s", haIdString.c_str());
 };
+
+void EspIdfMqttClient::registerMetrics_()
+{
+    // once only, even if the client gets started again
+    if (metricsRegistered_)
+        return;
+    metricsRegistered_ = true;
+
+    connectsMetric_ = Metrics.AddCounter("iotbase_mqtt_connects_total", "Connections established to the MQTT broker");
+    disconnectsMetric_ = Metrics.AddCounter("iotbase_mqtt_disconnects_total", "Connections lost to the MQTT broker");
+    receivedMetric_ = Metrics.AddCounter("iotbase_mqtt_received_total", "MQTT messages received");
+    publishFailuresMetric_ = Metrics.AddCounter("iotbase_mqtt_publish_failures_total", "MQTT messages that could not be queued for publishing");
+    publishSizeMetric_ = Metrics.AddHistogram("iotbase_mqtt_publish_size_bytes", "Payload size of the MQTT messages published", kPublishSizeBounds);
+}
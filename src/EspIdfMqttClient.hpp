@@ -4,14 +4,19 @@
 #include <ArduinoJson.h>
 #include <functional>
 #include <mqtt_client.h>
+#include "Metrics.hpp"
 
 typedef std::function<void()> OnConnectUserCallback;
+typedef std::function<void()> OnDisconnectUserCallback;
 
 class EspIdfMqttClient {
     public:
         EspIdfMqttClient& BeginWithHost(const String& mqttHost, const String& mqttUser, const String& mqttPassword, const String& deviceName = {}, const String& haDiscoveryTopicPrefix = {}, const String& baseTopic = {});
         EspIdfMqttClient& BeginWithUri(const String& mqttUri, const String& deviceName = {}, const String& haDiscoveryTopicPrefix = {}, const String& baseTopic = {});
         EspIdfMqttClient& OnConnect(OnConnectUserCallback callback);
+        EspIdfMqttClient& OnDisconnect(OnDisconnectUserCallback callback);
+        bool IsConnected() const { return isConnected_; }
+        void Reconnect();
         void Publish(const String& message, bool retain = false, const String& topicSuffix = {}, const String& topic = {});
         void Publish(JsonDocument message, bool retain = false, const String& topicSuffix = {}, const String& topic = {});
         void PublishHaDiscoveryInformation(bool isBinary, const String &unitOfMeasurement, const String &deviceClass, int expireAfter, const String &valueTemplate,
@@ -25,8 +30,16 @@ class EspIdfMqttClient {
         static esp_err_t StaticEventHandler(esp_mqtt_event_handle_t event);
         esp_err_t EventHandler(esp_mqtt_event_handle_t event);
         std::vector<OnConnectUserCallback> _onConnectUserCallbacks;
+        std::vector<OnDisconnectUserCallback> _onDisconnectUserCallbacks;
         void cleanIdStringForHomeAssistant(String& haIdString);
         bool isConnected_;
+        bool metricsRegistered_ = false;
+        MetricsRegistry::Counter connectsMetric_;
+        MetricsRegistry::Counter disconnectsMetric_;
+        MetricsRegistry::Counter receivedMetric_;
+        MetricsRegistry::Counter publishFailuresMetric_;
+        MetricsRegistry::Histogram publishSizeMetric_;
+        void registerMetrics_();
 };
 
 void IotBase_ResetNetworkConnectedWatchdog();
@@ -0,0 +1,211 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "FirmwareDelta.hpp"
+#include <algorithm>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseDelta";
+
+    const constexpr uint8_t kMagic[] = { 'I', 'B', 'D', '1' };
+}
+
+FirmwareDelta::FirmwareDelta(FirmwareUpdater &updater)
+    : updater_(updater)
+{
+}
+
+bool FirmwareDelta::IsDelta(const uint8_t* data, size_t length)
+{
+    return length >= sizeof(kMagic) && memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+void FirmwareDelta::Reset(const uint8_t* expectedSha256, std::function<void(size_t written)> progressFunc)
+{
+    state_ = State::Header;
+    pendingLength_ = 0;
+    checkSha256_ = expectedSha256 != nullptr;
+    if (checkSha256_)
+        memcpy(expectedSha256_, expectedSha256, FirmwareUpdater::kSha256Length);
+    progressFunc_ = progressFunc;
+    imageSize_ = 0;
+    produced_ = 0;
+    dataRemaining_ = 0;
+    error_ = nullptr;
+}
+
+bool FirmwareDelta::Write(const uint8_t* data, size_t length)
+{
+    while (length && state_ != State::Failed) {
+        switch (state_) {
+            case State::Header:
+                if (!collect_(data, length, kHeaderLength))
+                    break;
+                pendingLength_ = 0;
+                if (!beginImage_())
+                    return false;
+                break;
+
+            case State::Command:
+                // the opcode first, its arguments depend on it
+                if (!collect_(data, length, 1 + (pendingLength_ ? getArgumentsLength_(pending_[0]) : 0))
+                    || pendingLength_ < 1 + getArgumentsLength_(pending_[0]))
+                    break;
+                pendingLength_ = 0;
+                if (!executeCommand_())
+                    return false;
+                break;
+
+            case State::Data: {
+                size_t chunkLength = std::min(length, dataRemaining_);
+                if (!produce_(chunkLength))
+                    return false;
+                bool written = adding_ ? updater_.WriteAdded(sourceOffset_, data, chunkLength) : updater_.Write(data, chunkLength);
+                if (!written) {
+                    state_ = State::Failed;
+                    return false;
+                }
+                sourceOffset_ += chunkLength;
+                dataRemaining_ -= chunkLength;
+                data += chunkLength;
+                length -= chunkLength;
+                if (!dataRemaining_)
+                    state_ = State::Command;
+                break;
+            }
+
+            case State::Done:
+                return fail_("Data after the end of the patch.");
+
+            case State::Failed:
+                break;
+        }
+    }
+    return state_ != State::Failed;
+}
+
+bool FirmwareDelta::IsComplete() const
+{
+    return state_ == State::Done;
+}
+
+size_t FirmwareDelta::GetImageSize() const
+{
+    return imageSize_;
+}
+
+const char* FirmwareDelta::GetError() const
+{
+    return error_;
+}
+
+// appends to pending_ until it holds needed bytes, returns true once it does
+bool FirmwareDelta::collect_(const uint8_t* &data, size_t &length, size_t needed)
+{
+    size_t chunkLength = std::min(length, needed - pendingLength_);
+    memcpy(pending_ + pendingLength_, data, chunkLength);
+    pendingLength_ += chunkLength;
+    data += chunkLength;
+    length -= chunkLength;
+    return pendingLength_ == needed;
+}
+
+size_t FirmwareDelta::getArgumentsLength_(uint8_t command)
+{
+    switch (command) {
+        case kCopy:
+        case kAdd:
+            return 8;
+        case kInsert:
+            return 4;
+        default:
+            // unknown commands fail right away
+            return 0;
+    }
+}
+
+bool FirmwareDelta::beginImage_()
+{
+    const uint8_t* header = pending_;
+    if (!IsDelta(header, kHeaderLength))
+        return fail_("Not a firmware patch.");
+    size_t sourceSize = readUint32_(header + 4);
+    const uint8_t* sourceSha256 = header + 8;
+    imageSize_ = readUint32_(header + 8 + FirmwareUpdater::kSha256Length);
+    const uint8_t* imageSha256 = header + 12 + FirmwareUpdater::kSha256Length;
+    if (checkSha256_ && memcmp(imageSha256, expectedSha256_, FirmwareUpdater::kSha256Length) != 0)
+        return fail_("SHA-256 does not match the patch.");
+
+    ESP_LOGI(kLoggingTag, "Applying patch for a %u byte image to the running %u byte image.", imageSize_, sourceSize);
+    if (!updater_.Begin(imageSize_, imageSha256, progressFunc_, sourceSize, sourceSha256)) {
+        state_ = State::Failed;
+        return false;
+    }
+    state_ = State::Command;
+    return true;
+}
+
+bool FirmwareDelta::executeCommand_()
+{
+    switch (pending_[0]) {
+        case kEnd:
+            if (produced_ != imageSize_)
+                return fail_("Patch ended before the image was complete.");
+            state_ = State::Done;
+            return true;
+
+        case kCopy: {
+            size_t copyLength = readUint32_(pending_ + 5);
+            if (!produce_(copyLength))
+                return false;
+            if (!updater_.WriteCopied(readUint32_(pending_ + 1), copyLength)) {
+                state_ = State::Failed;
+                return false;
+            }
+            return true;
+        }
+
+        case kAdd:
+            adding_ = true;
+            sourceOffset_ = readUint32_(pending_ + 1);
+            dataRemaining_ = readUint32_(pending_ + 5);
+            break;
+
+        case kInsert:
+            adding_ = false;
+            dataRemaining_ = readUint32_(pending_ + 1);
+            break;
+
+        default:
+            return fail_("Unknown patch command.");
+    }
+    if (dataRemaining_)
+        state_ = State::Data;
+    return true;
+}
+
+// keeps track of the image size, so a broken patch cannot write beyond it
+bool FirmwareDelta::produce_(size_t length)
+{
+    if (length > imageSize_ - produced_)
+        return fail_("Patch produces more than the image size.");
+    produced_ += length;
+    return true;
+}
+
+bool FirmwareDelta::fail_(const char* error)
+{
+    ESP_LOGE(kLoggingTag, "%s", error);
+    error_ = error;
+    state_ = State::Failed;
+    return false;
+}
+
+uint32_t FirmwareDelta::readUint32_(const uint8_t* data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
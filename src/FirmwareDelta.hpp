@@ -0,0 +1,73 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <functional>
+#include "FirmwareUpdater.hpp"
+
+
+// Applies a patch against the running firmware (as created by tools/firmware_delta.py) while it is being received,
+// the new image gets streamed into the updater without ever being held in RAM.
+//
+// Patch format (all numbers uint32 little endian):
+//   header    "IBD1", old image size, old image SHA-256, new image size, new image SHA-256
+//   commands  0x00                            end of patch
+//             0x01 offset length              copy from the old image
+//             0x02 offset length <bytes>      old image bytes plus the given bytes (mod 256)
+//             0x03 length <bytes>             the given bytes
+// The old image has to match its hash (checked before anything gets written), the new one gets verified by the updater.
+class FirmwareDelta {
+    public:
+        static const constexpr size_t kHeaderLength = 4 + 4 + FirmwareUpdater::kSha256Length + 4 + FirmwareUpdater::kSha256Length;
+
+        explicit FirmwareDelta(FirmwareUpdater &updater);
+
+        // checks the first bytes of an upload
+        static bool IsDelta(const uint8_t* data, size_t length);
+
+        // starts a new patch, the updater gets started as soon as the header is complete
+        // expectedSha256: new image hash to require (has to match the one in the patch), nullptr to use the one from the patch
+        void Reset(const uint8_t* expectedSha256 = nullptr, std::function<void(size_t written)> progressFunc = nullptr);
+        // returns false as soon as the patch is invalid or the updater has failed
+        bool Write(const uint8_t* data, size_t length);
+        // the end command has been received
+        bool IsComplete() const;
+        // new image size from the header (0 before)
+        size_t GetImageSize() const;
+        // describes what is wrong with the patch, nullptr if it is fine (or the updater has failed)
+        const char* GetError() const;
+
+    private:
+        enum class State { Header, Command, Data, Done, Failed };
+
+        static const constexpr uint8_t kEnd = 0x00;
+        static const constexpr uint8_t kCopy = 0x01;
+        static const constexpr uint8_t kAdd = 0x02;
+        static const constexpr uint8_t kInsert = 0x03;
+
+        FirmwareUpdater &updater_;
+        State state_ = State::Failed;
+        uint8_t pending_[kHeaderLength];    ///< header or command being received
+        size_t pendingLength_ = 0;
+        bool checkSha256_ = false;
+        uint8_t expectedSha256_[FirmwareUpdater::kSha256Length];
+        std::function<void(size_t written)> progressFunc_;
+        size_t imageSize_ = 0;
+        size_t produced_ = 0;
+        size_t dataRemaining_ = 0;          ///< of the current add/insert command
+        uint32_t sourceOffset_ = 0;         ///< of the current add command
+        bool adding_ = false;
+        const char* error_ = nullptr;
+
+        bool collect_(const uint8_t* &data, size_t &length, size_t needed);
+        static size_t getArgumentsLength_(uint8_t command);
+        bool beginImage_();
+        bool executeCommand_();
+        bool produce_(size_t length);
+        bool fail_(const char* error);
+        static uint32_t readUint32_(const uint8_t* data);
+};
@@ -0,0 +1,474 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "FirmwareUpdater.hpp"
+#include <mbedtls/sha256.h>
+#include <algorithm>
+#include <new>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseUpdate";
+
+    const constexpr size_t kProgressInterval = 64 * 1024;
+    // the writer only ever works on a single sector at a time (erasing one takes up to a few hundred ms), so this leaves
+    // plenty of margin while keeping the async_tcp task well within its watchdog
+    const constexpr TickType_t kBufferTimeout = pdMS_TO_TICKS(2 * 1000);
+    // both buffers, a few copies and the end marker
+    const constexpr UBaseType_t kCommandQueueLength = 8;
+}
+
+// std::min() takes references
+const constexpr size_t FirmwareUpdater::kSourceChunkSize;
+
+FirmwareUpdater::FirmwareUpdater()
+{
+    progressMetric_ = Metrics.AddGauge("iotbase_firmware_update_written_bytes", "Bytes written to flash by the current (or last) firmware update");
+    imageSizeMetric_ = Metrics.AddGauge("iotbase_firmware_update_size_bytes", "Image size of the current (or last) firmware update (0 if unknown)");
+    successMetric_ = Metrics.AddCounter("iotbase_firmware_updates_total", "Firmware updates", "result=\"success\"");
+    failureMetric_ = Metrics.AddCounter("iotbase_firmware_updates_total", "Firmware updates", "result=\"failure\"");
+}
+
+bool FirmwareUpdater::Begin(size_t imageSize, const uint8_t* expectedSha256, std::function<void(size_t written)> progressFunc,
+                            size_t sourceSize, const uint8_t* expectedSourceSha256)
+{
+    if (!Poll()) {
+        ESP_LOGW(kLoggingTag, "Update already running.");
+        return false;
+    }
+
+    partition_ = esp_ota_get_next_update_partition(nullptr);
+    if (!partition_ || (imageSize && imageSize > partition_->size)) {
+        ESP_LOGE(kLoggingTag, "No OTA partition or image too large (%u bytes).", imageSize);
+        return false;
+    }
+    sourcePartition_ = esp_ota_get_running_partition();
+    if (!sourcePartition_ || sourceSize > sourcePartition_->size) {
+        ESP_LOGE(kLoggingTag, "Running firmware smaller than expected (%u bytes).", sourceSize);
+        return false;
+    }
+
+    for (auto &buffer : buffers_) {
+        buffer.data.reset(new (std::nothrow) uint8_t[kBufferSize]);
+        buffer.length = 0;
+        buffer.sourceOffset = kNoSource;
+    }
+    sourceBuffer_.reset(new (std::nothrow) uint8_t[kSourceChunkSize]);
+    erased_.reset(new (std::nothrow) uint32_t[(partition_->size / kBufferSize + 31) / 32]());
+    freeQueue_ = xQueueCreate(2, sizeof(uint8_t));
+    commandQueue_ = xQueueCreate(kCommandQueueLength, sizeof(Command));
+    writerDone_ = xSemaphoreCreateBinary();
+    if (!buffers_[0].data || !buffers_[1].data || !sourceBuffer_ || !erased_ || !freeQueue_ || !commandQueue_ || !writerDone_) {
+        ESP_LOGE(kLoggingTag, "Out of memory.");
+        error_ = ESP_ERR_NO_MEM;
+        failureMetric_.Increment();
+        release_();
+        return false;
+    }
+    for (uint8_t index = 0; index < 2; index++)
+        xQueueSend(freeQueue_, &index, 0);
+
+    imageSize_ = imageSize;
+    sourceSize_ = sourceSize ? sourceSize : sourcePartition_->size;
+    checkSha256_ = expectedSha256 != nullptr;
+    if (checkSha256_)
+        memcpy(expectedSha256_, expectedSha256, kSha256Length);
+    checkSourceSha256_ = expectedSourceSha256 != nullptr;
+    if (checkSourceSha256_)
+        memcpy(expectedSourceSha256_, expectedSourceSha256, kSha256Length);
+    progressFunc_ = progressFunc;
+    filling_ = -1;
+    queued_ = 0;
+    error_ = ESP_OK;
+    written_ = 0;
+    aborted_ = false;
+    progressMetric_.Set(0);
+    imageSizeMetric_.Set(imageSize);
+
+    ESP_LOGI(kLoggingTag, "Updating partition '%s' at %#x (image size %u).", partition_->label, partition_->address, imageSize);
+    // checking the source reads the whole running firmware, so even that happens on the writer task
+    if (xTaskCreate(writerTask_, "IotBaseOtaWrite", 4096, this, 2, nullptr) != pdPASS) {
+        ESP_LOGE(kLoggingTag, "Out of memory.");
+        error_ = ESP_ERR_NO_MEM;
+        failureMetric_.Increment();
+        release_();
+        return false;
+    }
+    running_ = true;
+    ending_ = false;
+    return true;
+}
+
+bool FirmwareUpdater::Write(const uint8_t* data, size_t length)
+{
+    return append_(kNoSource, data, length);
+}
+
+bool FirmwareUpdater::WriteCopied(size_t sourceOffset, size_t length)
+{
+    if (!running_ || ending_ || !reserve_(length))
+        return false;
+    if (filling_ >= 0 && buffers_[filling_].length)
+        flush_();
+
+    // read and written by the writer task, without going through any buffer here
+    Command command = { kNoBuffer, sourceOffset, queued_, length };
+    queued_ += length;
+    if (length && error_ == ESP_OK)
+        send_(command);
+    return error_ == ESP_OK;
+}
+
+bool FirmwareUpdater::WriteAdded(size_t sourceOffset, const uint8_t* delta, size_t length)
+{
+    if (sourceOffset >= kNoSource)
+        return false;
+    return append_(sourceOffset, delta, length);
+}
+
+void FirmwareUpdater::End()
+{
+    if (!running_ || ending_)
+        return;
+    if (filling_ >= 0 && buffers_[filling_].length)
+        flush_();
+    ending_ = true;
+    // the writer takes commands between sectors, so this does not block for long either
+    Command endMarker = { kEndMarker, kNoSource, 0, 0 };
+    xQueueSend(commandQueue_, &endMarker, portMAX_DELAY);
+}
+
+bool FirmwareUpdater::Poll()
+{
+    if (!running_)
+        return true;
+    if (!ending_ || xSemaphoreTake(writerDone_, 0) != pdTRUE)
+        return false;
+    release_();
+    return true;
+}
+
+void FirmwareUpdater::Abort()
+{
+    if (!running_)
+        return;
+    ESP_LOGW(kLoggingTag, "Update aborted after %u bytes.", written_.load());
+    aborted_ = true;
+    if (!ending_) {
+        ending_ = true;
+        Command endMarker = { kEndMarker, kNoSource, 0, 0 };
+        xQueueSend(commandQueue_, &endMarker, portMAX_DELAY);
+    }
+    // the writer checks for aborts after every sector
+    xSemaphoreTake(writerDone_, portMAX_DELAY);
+    release_();
+}
+
+bool FirmwareUpdater::IsRunning() const
+{
+    return running_;
+}
+
+size_t FirmwareUpdater::GetWritten() const
+{
+    return written_;
+}
+
+const uint8_t* FirmwareUpdater::GetSha256() const
+{
+    return sha256_;
+}
+
+esp_err_t FirmwareUpdater::GetError() const
+{
+    return error_;
+}
+
+// releases everything once the writer task has stopped (or if it has not been started)
+void FirmwareUpdater::release_()
+{
+    for (auto &buffer : buffers_)
+        buffer.data.reset();
+    sourceBuffer_.reset();
+    erased_.reset();
+    if (freeQueue_)
+        vQueueDelete(freeQueue_);
+    if (commandQueue_)
+        vQueueDelete(commandQueue_);
+    if (writerDone_)
+        vSemaphoreDelete(writerDone_);
+    freeQueue_ = commandQueue_ = 0;
+    writerDone_ = 0;
+    filling_ = -1;
+    progressFunc_ = nullptr;
+    running_ = false;
+    ending_ = false;
+}
+
+// sourceOffset: kNoSource for data to be written as it is
+bool FirmwareUpdater::append_(uint32_t sourceOffset, const uint8_t* data, size_t length)
+{
+    if (!running_ || ending_ || !reserve_(length))
+        return false;
+
+    // a buffer holds only one kind of data, added data has to continue the source contiguously
+    if (filling_ >= 0 && buffers_[filling_].length) {
+        const Buffer &buffer = buffers_[filling_];
+        bool isAdded = buffer.sourceOffset != kNoSource;
+        if (isAdded != (sourceOffset != kNoSource) || (isAdded && buffer.sourceOffset + buffer.length != sourceOffset))
+            flush_();
+    }
+
+    while (length && error_ == ESP_OK) {
+        if (filling_ < 0) {
+            uint8_t index;
+            if (xQueueReceive(freeQueue_, &index, kBufferTimeout) != pdTRUE) {
+                setError_(ESP_ERR_TIMEOUT);
+                break;
+            }
+            filling_ = index;
+            buffers_[filling_].length = 0;
+        }
+
+        Buffer &buffer = buffers_[filling_];
+        if (!buffer.length) {
+            buffer.offset = queued_;
+            buffer.sourceOffset = sourceOffset;
+        }
+        size_t chunkLength = std::min(length, kBufferSize - buffer.length);
+        memcpy(buffer.data.get() + buffer.length, data, chunkLength);
+        buffer.length += chunkLength;
+        queued_ += chunkLength;
+        data += chunkLength;
+        length -= chunkLength;
+        if (sourceOffset != kNoSource)
+            sourceOffset += chunkLength;
+        if (buffer.length == kBufferSize)
+            flush_();
+    }
+    return error_ == ESP_OK;
+}
+
+// the image has to fit into the partition (and must not exceed its size if known)
+bool FirmwareUpdater::reserve_(size_t length)
+{
+    size_t limit = imageSize_ ? imageSize_ : partition_->size;
+    if (length > limit - queued_) {
+        ESP_LOGE(kLoggingTag, "Image larger than %u bytes.", limit);
+        setError_(ESP_ERR_INVALID_SIZE);
+    }
+    return error_ == ESP_OK;
+}
+
+void FirmwareUpdater::flush_()
+{
+    const Buffer &buffer = buffers_[filling_];
+    Command command = { static_cast<uint8_t>(filling_), buffer.sourceOffset, buffer.offset, buffer.length };
+    filling_ = -1;
+    send_(command);
+}
+
+bool FirmwareUpdater::send_(const Command &command)
+{
+    if (xQueueSend(commandQueue_, &command, kBufferTimeout) != pdTRUE) {
+        setError_(ESP_ERR_TIMEOUT);
+        return false;
+    }
+    return true;
+}
+
+// keeps the first error only
+void FirmwareUpdater::setError_(esp_err_t error)
+{
+    esp_err_t expected = ESP_OK;
+    error_.compare_exchange_strong(expected, error);
+}
+
+void FirmwareUpdater::writerTask_(void* updaterPointer)
+{
+    FirmwareUpdater* updater = static_cast<FirmwareUpdater*>(updaterPointer);
+    updater->write_();
+    xSemaphoreGive(updater->writerDone_);
+    vTaskDelete(nullptr);
+}
+
+void FirmwareUpdater::write_()
+{
+    // before erasing anything, a patch for another firmware would only produce garbage
+    checkSource_();
+
+    // Buffers get written right away (and handed back for Write()), copies only piece by piece whenever nothing else is
+    // waiting - they may be much larger than the buffers and Write() must never have to wait for them.
+    std::deque<Command> copies;
+    bool ending = false;
+    size_t nextProgress = kProgressInterval;
+    while (true) {
+        Command command;
+        if (xQueueReceive(commandQueue_, &command, copies.empty() && !ending ? portMAX_DELAY : 0) == pdTRUE) {
+            if (command.buffer == kEndMarker) {
+                ending = true;
+            } else if (command.buffer == kNoBuffer) {
+                if (error_ == ESP_OK && !aborted_)
+                    copies.push_back(command);
+            } else {
+                // keeps draining after errors, so Write() never gets stuck
+                writeBuffer_(command);
+                xQueueSend(freeQueue_, &command.buffer, 0);
+            }
+        } else if (!copies.empty()) {
+            copyPiece_(copies);
+        } else {
+            break;
+        }
+
+        if (written_ >= nextProgress && progressFunc_) {
+            progressFunc_(written_);
+            nextProgress = written_ + kProgressInterval;
+        }
+    }
+
+    complete_();
+}
+
+void FirmwareUpdater::writeBuffer_(const Command &command)
+{
+    if (error_ != ESP_OK || aborted_)
+        return;
+
+    uint8_t* data = buffers_[command.buffer].data.get();
+    if (command.sourceOffset != kNoSource) {
+        for (uint32_t offset = 0; offset < command.length && error_ == ESP_OK; offset += kSourceChunkSize) {
+            size_t chunkLength = std::min<size_t>(command.length - offset, kSourceChunkSize);
+            setError_(readSource_(command.sourceOffset + offset, sourceBuffer_.get(), chunkLength));
+            for (size_t i = 0; i < chunkLength; i++)
+                data[offset + i] += sourceBuffer_[i];
+        }
+    }
+    if (error_ == ESP_OK)
+        writeFlash_(command.offset, data, command.length);
+}
+
+// copies from the first pending copy up to the end of the sector it continues in
+void FirmwareUpdater::copyPiece_(std::deque<Command> &copies)
+{
+    if (error_ != ESP_OK || aborted_) {
+        copies.clear();
+        return;
+    }
+
+    Command &copy = copies.front();
+    size_t pieceLength = std::min<size_t>(copy.length, kBufferSize - copy.offset % kBufferSize);
+    for (size_t offset = 0; offset < pieceLength && error_ == ESP_OK; offset += kSourceChunkSize) {
+        size_t chunkLength = std::min(pieceLength - offset, kSourceChunkSize);
+        setError_(readSource_(copy.sourceOffset + offset, sourceBuffer_.get(), chunkLength));
+        if (error_ == ESP_OK)
+            writeFlash_(copy.offset + offset, sourceBuffer_.get(), chunkLength);
+    }
+    copy.sourceOffset += pieceLength;
+    copy.offset += pieceLength;
+    copy.length -= pieceLength;
+    if (!copy.length)
+        copies.pop_front();
+}
+
+void FirmwareUpdater::writeFlash_(uint32_t offset, const uint8_t* data, size_t length)
+{
+    // as parts of the image may be written out of order, every sector gets erased right before it is first written to
+    esp_err_t err = ESP_OK;
+    for (uint32_t sector = offset / kBufferSize; sector <= (offset + length - 1) / kBufferSize && err == ESP_OK; sector++) {
+        uint32_t mask = 1u << (sector % 32);
+        if (erased_[sector / 32] & mask)
+            continue;
+        err = esp_partition_erase_range(partition_, sector * kBufferSize, kBufferSize);
+        if (err == ESP_OK)
+            erased_[sector / 32] |= mask;
+    }
+    if (err == ESP_OK)
+        err = esp_partition_write(partition_, offset, data, length);
+
+    if (err == ESP_OK) {
+        written_ += length;
+        progressMetric_.Set(written_);
+    } else {
+        ESP_LOGE(kLoggingTag, "Error writing to flash at offset %u: %#x (%s)", offset, err, esp_err_to_name(err));
+        setError_(err);
+    }
+}
+
+// hashes what has actually been written, activates the new image if everything is fine
+void FirmwareUpdater::complete_()
+{
+    size_t written = written_;
+    if (imageSize_ && written != imageSize_ && !aborted_)
+        setError_(ESP_ERR_INVALID_SIZE);
+
+    if (error_ == ESP_OK && !aborted_) {
+        mbedtls_sha256_context sha256;
+        mbedtls_sha256_init(&sha256);
+        mbedtls_sha256_starts_ret(&sha256, 0);
+        for (size_t offset = 0; offset < written && error_ == ESP_OK && !aborted_; offset += kSourceChunkSize) {
+            size_t chunkLength = std::min(written - offset, kSourceChunkSize);
+            setError_(esp_partition_read(partition_, offset, sourceBuffer_.get(), chunkLength));
+            if (error_ == ESP_OK)
+                mbedtls_sha256_update_ret(&sha256, sourceBuffer_.get(), chunkLength);
+        }
+        mbedtls_sha256_finish_ret(&sha256, sha256_);
+        mbedtls_sha256_free(&sha256);
+
+        if (error_ == ESP_OK && checkSha256_ && memcmp(sha256_, expectedSha256_, kSha256Length) != 0) {
+            ESP_LOGE(kLoggingTag, "SHA-256 mismatch, not activating the new image.");
+            setError_(ESP_ERR_INVALID_CRC);
+        }
+    }
+    // verifies the image (segments and checksum) before switching to it
+    if (error_ == ESP_OK && !aborted_)
+        setError_(esp_ota_set_boot_partition(partition_));
+
+    if (error_ == ESP_OK && !aborted_) {
+        ESP_LOGW(kLoggingTag, "Update successful (%u bytes), active after restart.", written);
+        successMetric_.Increment();
+    } else {
+        ESP_LOGE(kLoggingTag, "Update failed: %#x (%s)", error_.load(), esp_err_to_name(error_));
+        failureMetric_.Increment();
+    }
+}
+
+// returns false if the running firmware does not match the expected hash
+bool FirmwareUpdater::checkSource_()
+{
+    if (!checkSourceSha256_)
+        return true;
+
+    mbedtls_sha256_context sha256;
+    mbedtls_sha256_init(&sha256);
+    mbedtls_sha256_starts_ret(&sha256, 0);
+    esp_err_t err = ESP_OK;
+    for (size_t offset = 0; offset < sourceSize_ && err == ESP_OK; offset += kSourceChunkSize) {
+        size_t chunkLength = std::min(sourceSize_ - offset, kSourceChunkSize);
+        err = readSource_(offset, sourceBuffer_.get(), chunkLength);
+        if (err == ESP_OK)
+            mbedtls_sha256_update_ret(&sha256, sourceBuffer_.get(), chunkLength);
+    }
+    uint8_t sourceSha256[kSha256Length];
+    mbedtls_sha256_finish_ret(&sha256, sourceSha256);
+    mbedtls_sha256_free(&sha256);
+
+    if (err == ESP_OK && memcmp(sourceSha256, expectedSourceSha256_, kSha256Length) != 0) {
+        ESP_LOGE(kLoggingTag, "The running firmware is not the one expected.");
+        err = ESP_ERR_INVALID_VERSION;
+    }
+    setError_(err);
+    return err == ESP_OK;
+}
+
+esp_err_t FirmwareUpdater::readSource_(uint32_t offset, uint8_t* data, size_t length)
+{
+    if (offset > sourceSize_ || length > sourceSize_ - offset) {
+        ESP_LOGE(kLoggingTag, "Reading beyond the running firmware (%u bytes at %u).", length, offset);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return esp_partition_read(sourcePartition_, offset, data, length);
+}
@@ -0,0 +1,129 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <Esp32Logging.hpp>
+#include <esp_ota_ops.h>
+#include <esp_spi_flash.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include "Metrics.hpp"
+
+
+// Streams a firmware image into the inactive OTA partition. Write() only copies into one of two buffers while a separate
+// task flashes the other one, so receiving and flash writes overlap. Like Arduino's Update, every sector gets erased only
+// right before it is first written to (instead of erasing the whole partition up front), so the caller never waits for
+// more than a few sector erases - important when running on the async_tcp task.
+// Parts of the image may also be taken from the running firmware (see WriteCopied(), WriteAdded(), FirmwareDelta). These
+// copies are done whenever the writer has nothing else to do, buffered data gets written to its place in the image first.
+// The image gets hashed (SHA-256) as it is in flash once complete and verified before being activated.
+// Only one update at a time, Begin() to Poll()/Abort() may be called from different tasks but not concurrently.
+class FirmwareUpdater {
+    public:
+        static const constexpr size_t kBufferSize = SPI_FLASH_SEC_SIZE;    ///< one flash sector
+        static const constexpr size_t kSha256Length = 32;
+        static const constexpr size_t kSourceChunkSize = 1024;     ///< reads from the running firmware
+
+        // registers the metrics, so not meant to be a global object
+        FirmwareUpdater();
+
+        // imageSize: 0 if unknown, expectedSha256: nullptr to skip the check
+        // progressFunc: called from the flash writer task every 64 KB
+        // sourceSize: size of the running firmware image, parts beyond are refused (0: the whole partition)
+        // expectedSourceSha256: the running firmware image has to match (checked before anything gets written), nullptr to skip
+        bool Begin(size_t imageSize, const uint8_t* expectedSha256 = nullptr, std::function<void(size_t written)> progressFunc = nullptr,
+                   size_t sourceSize = 0, const uint8_t* expectedSourceSha256 = nullptr);
+        // blocks only while both buffers are busy (i.e. for about a sector erase), returns false as soon as anything has failed
+        bool Write(const uint8_t* data, size_t length);
+        // appends the given part of the running firmware image
+        bool WriteCopied(size_t sourceOffset, size_t length);
+        // appends the given part of the running firmware image with delta added to every byte
+        bool WriteAdded(size_t sourceOffset, const uint8_t* delta, size_t length);
+        // Hands the rest to the writer task, which then hashes, verifies and activates the new image (effective after the
+        // next restart). Does not wait for that (reading the whole image takes a while), see Poll().
+        void End();
+        // returns true once no update is running (anymore), i.e. after End() the new image has been activated or the update
+        // has failed (see GetError()), releases everything then - so has to be called until it returns true
+        bool Poll();
+        // waits for the writer task to stop, which takes at most a few sector erases
+        void Abort();
+
+        // true from Begin() until Poll() has returned true (or Abort())
+        bool IsRunning() const;
+        size_t GetWritten() const;
+        // after Poll() has returned true: hash of the new image (if everything has been written)
+        const uint8_t* GetSha256() const;
+        // ESP_OK if nothing has failed (yet)
+        esp_err_t GetError() const;
+
+    private:
+        static const constexpr uint8_t kNoBuffer = 0xfe;
+        static const constexpr uint8_t kEndMarker = 0xff;
+        static const constexpr uint32_t kNoSource = 0xffffffff;
+
+        struct Buffer {
+            std::unique_ptr<uint8_t[]> data;
+            size_t length = 0;
+            uint32_t offset = 0;                ///< where it goes in the new image
+            uint32_t sourceOffset = kNoSource;  ///< WriteAdded(): where the data to add to starts
+        };
+
+        // for the writer task: a buffer to write (as it is or added to the source) or a copy from the source
+        struct Command {
+            uint8_t buffer;                     ///< buffer index, kNoBuffer or kEndMarker
+            uint32_t sourceOffset;              ///< kNoSource if the buffer is to be written as it is
+            uint32_t offset;                    ///< where it goes in the new image
+            uint32_t length;
+        };
+
+        bool running_ = false;
+        bool ending_ = false;                   ///< End() has been called
+        Buffer buffers_[2];
+        int filling_ = -1;                      ///< buffer being filled by Write(), -1 if none
+        size_t queued_ = 0;                     ///< image bytes handed to the writer (or being buffered)
+        QueueHandle_t freeQueue_ = 0;           ///< buffers ready to be filled
+        QueueHandle_t commandQueue_ = 0;        ///< for the writer task
+        SemaphoreHandle_t writerDone_ = 0;
+        std::unique_ptr<uint8_t[]> sourceBuffer_;
+        std::unique_ptr<uint32_t[]> erased_;    ///< bitmap of the partition's sectors erased so far (writer task only)
+
+        const esp_partition_t* partition_ = nullptr;
+        const esp_partition_t* sourcePartition_ = nullptr;
+        size_t imageSize_ = 0;
+        size_t sourceSize_ = 0;
+        bool checkSha256_ = false;
+        uint8_t expectedSha256_[kSha256Length];
+        bool checkSourceSha256_ = false;
+        uint8_t expectedSourceSha256_[kSha256Length];
+        uint8_t sha256_[kSha256Length];
+        std::function<void(size_t written)> progressFunc_;
+        std::atomic<esp_err_t> error_{ESP_OK};
+        std::atomic<size_t> written_{0};
+        std::atomic<bool> aborted_{false};
+
+        MetricsRegistry::Gauge progressMetric_;
+        MetricsRegistry::Gauge imageSizeMetric_;
+        MetricsRegistry::Counter successMetric_;
+        MetricsRegistry::Counter failureMetric_;
+
+        void release_();
+        bool append_(uint32_t sourceOffset, const uint8_t* data, size_t length);
+        bool reserve_(size_t length);
+        void flush_();
+        bool send_(const Command &command);
+        void setError_(esp_err_t error);
+        static void writerTask_(void* updaterPointer);
+        void write_();
+        void writeBuffer_(const Command &command);
+        void copyPiece_(std::deque<Command> &copies);
+        void writeFlash_(uint32_t offset, const uint8_t* data, size_t length);
+        void complete_();
+        bool checkSource_();
+        esp_err_t readSource_(uint32_t offset, uint8_t* data, size_t length);
+};
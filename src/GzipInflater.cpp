@@ -0,0 +1,192 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "GzipInflater.hpp"
+#include <Esp32Logging.hpp>
+#include <algorithm>
+#include <new>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseGzip";
+
+    // see RFC 1952
+    const constexpr uint8_t kMagic[] = { 0x1f, 0x8b };
+    const constexpr uint8_t kMethodDeflate = 8;
+    const constexpr uint8_t kFlagHeaderCrc = 0x02;
+    const constexpr uint8_t kFlagExtra = 0x04;
+    const constexpr uint8_t kFlagName = 0x08;
+    const constexpr uint8_t kFlagComment = 0x10;
+}
+
+bool GzipInflater::IsGzip(const uint8_t* data, size_t length)
+{
+    return length >= sizeof(kMagic) && memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool GzipInflater::Begin(OutputFunc outputFunc)
+{
+    decompressor_.reset(new (std::nothrow) tinfl_decompressor);
+    window_.reset(new (std::nothrow) uint8_t[kWindowSize]);
+    if (!decompressor_ || !window_) {
+        ESP_LOGE(kLoggingTag, "Out of memory.");
+        End();
+        return false;
+    }
+    tinfl_init(decompressor_.get());
+    windowPosition_ = 0;
+    outputFunc_ = outputFunc;
+    state_ = State::Header;
+    headerLength_ = 0;
+    outputLength_ = 0;
+    error_ = nullptr;
+    return true;
+}
+
+bool GzipInflater::Write(const uint8_t* data, size_t length)
+{
+    while (length && state_ != State::Done && state_ != State::Failed) {
+        if (!(state_ == State::Data ? inflate_(data, length) : parseHeader_(data, length)))
+            return false;
+    }
+    // the trailer gets ignored
+    return state_ != State::Failed;
+}
+
+bool GzipInflater::IsComplete() const
+{
+    return state_ == State::Done;
+}
+
+const char* GzipInflater::GetError() const
+{
+    return error_;
+}
+
+size_t GzipInflater::GetOutputLength() const
+{
+    return outputLength_;
+}
+
+void GzipInflater::End()
+{
+    decompressor_.reset();
+    window_.reset();
+    outputFunc_ = nullptr;
+}
+
+// consumes as much of the header as there is, returns false if it is invalid
+bool GzipInflater::parseHeader_(const uint8_t* &data, size_t &length)
+{
+    switch (state_) {
+        case State::Header: {
+            size_t chunkLength = std::min(length, sizeof(header_) - headerLength_);
+            memcpy(header_ + headerLength_, data, chunkLength);
+            headerLength_ += chunkLength;
+            data += chunkLength;
+            length -= chunkLength;
+            if (headerLength_ < sizeof(header_))
+                return true;
+            if (!IsGzip(header_, headerLength_) || header_[2] != kMethodDeflate)
+                return fail_("Not gzip data.");
+            flags_ = header_[3];
+            headerLength_ = 0;
+            skipLength_ = 0;
+            state_ = State::Extra;
+            return true;
+        }
+
+        case State::Extra:
+            // 2 bytes length (little endian), then as many bytes to skip
+            if (flags_ & kFlagExtra) {
+                while (length && headerLength_ < 2) {
+                    skipLength_ |= *data++ << (8 * headerLength_++);
+                    length--;
+                }
+                size_t chunkLength = std::min(length, skipLength_);
+                data += chunkLength;
+                length -= chunkLength;
+                skipLength_ -= chunkLength;
+                if (headerLength_ < 2 || skipLength_)
+                    return true;
+            }
+            headerLength_ = 0;
+            state_ = State::Name;
+            return true;
+
+        case State::Name:
+        case State::Comment:
+            // both zero terminated
+            if (flags_ & (state_ == State::Name ? kFlagName : kFlagComment)) {
+                while (length) {
+                    length--;
+                    if (!*data++) {
+                        state_ = state_ == State::Name ? State::Comment : State::HeaderCrc;
+                        return true;
+                    }
+                }
+                return true;
+            }
+            state_ = state_ == State::Name ? State::Comment : State::HeaderCrc;
+            return true;
+
+        case State::HeaderCrc:
+            if (flags_ & kFlagHeaderCrc) {
+                while (length && headerLength_ < 2) {
+                    data++;
+                    length--;
+                    headerLength_++;
+                }
+                if (headerLength_ < 2)
+                    return true;
+            }
+            state_ = State::Data;
+            return true;
+
+        default:
+            return true;
+    }
+}
+
+// decompresses as much as possible, returns false if the data is invalid or the output function has failed
+bool GzipInflater::inflate_(const uint8_t* &data, size_t &length)
+{
+    while (true) {
+        size_t inputLength = length;
+        size_t outputLength = kWindowSize - windowPosition_;
+        tinfl_status status = tinfl_decompress(decompressor_.get(), data, &inputLength, window_.get(), window_.get() + windowPosition_,
+                                               &outputLength, TINFL_FLAG_HAS_MORE_INPUT);
+        data += inputLength;
+        length -= inputLength;
+
+        if (outputLength) {
+            outputLength_ += outputLength;
+            if (!outputFunc_(window_.get() + windowPosition_, outputLength)) {
+                state_ = State::Failed;
+                return false;
+            }
+            windowPosition_ = (windowPosition_ + outputLength) & (kWindowSize - 1);
+        }
+
+        if (status == TINFL_STATUS_DONE) {
+            state_ = State::Done;
+            return true;
+        }
+        if (status < 0)
+            return fail_("Invalid compressed data.");
+        // otherwise all of the input has been consumed
+        if (status != TINFL_STATUS_HAS_MORE_OUTPUT)
+            return true;
+    }
+}
+
+bool GzipInflater::fail_(const char* error)
+{
+    ESP_LOGE(kLoggingTag, "%s", error);
+    error_ = error;
+    state_ = State::Failed;
+    return false;
+}
@@ -0,0 +1,57 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <rom/miniz.h>
+#include <functional>
+#include <memory>
+
+
+// Decompresses gzip data (e.g. gzip -9 firmware.bin) while it is being received, using the inflater in ROM and a fixed
+// 32 KB window (plus about 11 KB of decompressor state), both only allocated between Begin() and End().
+// The trailer (CRC-32 and size) is not checked, the output has to be verified by its consumer (as the updater does anyway).
+class GzipInflater {
+    public:
+        static const constexpr size_t kWindowSize = TINFL_LZ_DICT_SIZE;
+
+        // gets all output in chunks of up to kWindowSize, returns false to stop
+        typedef std::function<bool(const uint8_t* data, size_t length)> OutputFunc;
+
+        // checks the first bytes of an upload
+        static bool IsGzip(const uint8_t* data, size_t length);
+
+        // returns false if out of memory
+        bool Begin(OutputFunc outputFunc);
+        // returns false as soon as the data is invalid or the output function has failed
+        bool Write(const uint8_t* data, size_t length);
+        // the end of the compressed data has been reached
+        bool IsComplete() const;
+        // describes what is wrong with the data, nullptr if it is fine (or the output function has failed)
+        const char* GetError() const;
+        size_t GetOutputLength() const;
+        // releases the memory
+        void End();
+
+    private:
+        enum class State { Header, Extra, Name, Comment, HeaderCrc, Data, Done, Failed };
+
+        std::unique_ptr<tinfl_decompressor> decompressor_;
+        std::unique_ptr<uint8_t[]> window_;
+        size_t windowPosition_ = 0;
+        OutputFunc outputFunc_;
+        State state_ = State::Failed;
+        uint8_t flags_ = 0;
+        uint8_t header_[10];
+        size_t headerLength_ = 0;       ///< of the part of the header being received
+        size_t skipLength_ = 0;         ///< of the extra field
+        size_t outputLength_ = 0;
+        const char* error_ = nullptr;
+
+        bool parseHeader_(const uint8_t* &data, size_t &length);
+        bool inflate_(const uint8_t* &data, size_t &length);
+        bool fail_(const char* error);
+};
@@ -0,0 +1,276 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "JobScheduler.hpp"
+#include <esp_timer.h>
+#include <algorithm>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseJobs";
+
+    const uint32_t kJitterBounds[] = { 100, 500, 1000, 5000, 10000, 50000, 100000 };
+}
+
+JobScheduler::JobScheduler(const char* name)
+    : name_(name)
+{
+    for (auto &slot : slots_)
+        slot = kNone;
+}
+
+void JobScheduler::Begin()
+{
+    mutex_ = xSemaphoreCreateMutex();
+    String labels = String("scheduler=\"") + name_ + "\"";
+    runsMetric_ = Metrics.AddCounter("iotbase_jobs_runs_total", "Jobs run by the scheduler", labels);
+    overrunsMetric_ = Metrics.AddCounter("iotbase_jobs_overruns_total", "Job runs skipped because the job was running late by a whole period", labels);
+    jitterMetric_ = Metrics.AddHistogram("iotbase_jobs_jitter_microseconds", "How late jobs started", kJitterBounds, labels);
+}
+
+void JobScheduler::Run(void* scheduler)
+{
+    static_cast<JobScheduler*>(scheduler)->run_();
+}
+
+JobScheduler::JobId JobScheduler::Every(uint32_t periodMs, std::function<void()> func, const char* name)
+{
+    if (!periodMs)
+        return kInvalidJob;
+    return add_(periodMs, periodMs, func, name);
+}
+
+JobScheduler::JobId JobScheduler::After(uint32_t delayMs, std::function<void()> func, const char* name)
+{
+    return add_(delayMs, 0, func, name);
+}
+
+bool JobScheduler::Cancel(JobId job)
+{
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    Job* entry = find_(job);
+    if (entry) {
+        if (entry->slot != kNone) {
+            unlink_(entry - jobs_);
+            entry->func = nullptr;
+            entry->used = false;
+        } else {
+            // gets released by the scheduler task once the current run has finished
+            entry->cancelled = true;
+        }
+    }
+    xSemaphoreGive(mutex_);
+    return entry != nullptr;
+}
+
+bool JobScheduler::GetStats(JobId job, Stats &stats)
+{
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    Job* entry = find_(job);
+    if (entry)
+        stats = entry->stats;
+    xSemaphoreGive(mutex_);
+    return entry != nullptr;
+}
+
+void JobScheduler::LogStats()
+{
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    bool headerLogged = false;
+    for (const Job &job : jobs_) {
+        if (!job.used)
+            continue;
+        if (!headerLogged) {
+            ESP_LOGI(kLoggingTag, "*** %s: Jobs (period, runs, overruns, jitter avg/max, run time max) ***", name_);
+            headerLogged = true;
+        }
+        const Stats &stats = job.stats;
+        ESP_LOGI(kLoggingTag, "%-20s %7u ms %8u %6u %7u/%7u us %7u us", job.name ? job.name : "?", static_cast<uint32_t>(job.periodUs / 1000),
+                 stats.runs, stats.overruns,
+                 stats.runs ? static_cast<uint32_t>(stats.totalJitterUs / stats.runs) : 0, stats.maxJitterUs, stats.maxRunTimeUs);
+    }
+    xSemaphoreGive(mutex_);
+}
+
+JobScheduler::JobId JobScheduler::add_(uint32_t delayMs, uint32_t periodMs, std::function<void()> func, const char* name)
+{
+    JobId result = kInvalidJob;
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    for (uint8_t index = 0; index < kMaxJobs; index++) {
+        Job &job = jobs_[index];
+        if (job.used)
+            continue;
+        job.func = func;
+        job.name = name;
+        job.due = esp_timer_get_time() + static_cast<int64_t>(delayMs) * 1000;
+        job.periodUs = static_cast<int64_t>(periodMs) * 1000;
+        job.generation++;
+        job.used = true;
+        job.cancelled = false;
+        job.stats = {};
+        insert_(index);
+        result = (job.generation << 8) | index;
+        break;
+    }
+    // the scheduler has to reconsider how long to sleep
+    if (task_)
+        xTaskNotifyGive(task_);
+    xSemaphoreGive(mutex_);
+
+    if (result == kInvalidJob)
+        ESP_LOGE(kLoggingTag, "%s: No room for job '%s'.", name_, name ? name : "?");
+    return result;
+}
+
+void JobScheduler::run_()
+{
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    task_ = xTaskGetCurrentTaskHandle();
+    xSemaphoreGive(mutex_);
+
+    while (true) {
+        uint8_t due[kMaxJobs];
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        size_t dueCount = collectDue_(esp_timer_get_time(), due);
+        xSemaphoreGive(mutex_);
+
+        // jobs may add or cancel jobs, so the mutex must not be held while they run
+        for (size_t i = 0; i < dueCount; i++) {
+            xSemaphoreTake(mutex_, portMAX_DELAY);
+            bool cancelled = jobs_[due[i]].cancelled;
+            xSemaphoreGive(mutex_);
+            int64_t started = esp_timer_get_time();
+            if (!cancelled)
+                jobs_[due[i]].func();
+            finish_(due[i], started, esp_timer_get_time());
+        }
+
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        TickType_t wait = getWaitTime_(esp_timer_get_time());
+        xSemaphoreGive(mutex_);
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+// takes all due jobs off the wheel, ordered by due time
+size_t JobScheduler::collectDue_(int64_t now, uint8_t* due)
+{
+    // a slot holds jobs due up to the end of its tick, so the one of the current tick has to be looked at as well
+    int64_t nowTick = now / kTickUs;
+    int64_t lastSlotTick = std::min(nowTick + 1, lastTick_ + static_cast<int64_t>(kWheelSlots));
+    size_t dueCount = 0;
+    for (int64_t tick = lastTick_ + 1; tick <= lastSlotTick; tick++) {
+        uint8_t index = slots_[tick % kWheelSlots];
+        while (index != kNone) {
+            uint8_t next = jobs_[index].next;
+            if (jobs_[index].due <= now) {
+                unlink_(index);
+                due[dueCount++] = index;
+            }
+            index = next;
+        }
+    }
+    // all jobs left in the slots up to the current tick belong to later rounds
+    lastTick_ = std::max(lastTick_, nowTick);
+
+    std::sort(due, due + dueCount, [this](uint8_t a, uint8_t b) { return jobs_[a].due < jobs_[b].due; });
+    return dueCount;
+}
+
+void JobScheduler::finish_(uint8_t index, int64_t started, int64_t finished)
+{
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    Job &job = jobs_[index];
+    if (job.cancelled) {
+        job.func = nullptr;
+        job.used = false;
+        xSemaphoreGive(mutex_);
+        return;
+    }
+    Stats &stats = job.stats;
+    uint32_t jitter = std::min<int64_t>(started - job.due, UINT32_MAX);
+    stats.runs++;
+    stats.totalJitterUs += jitter;
+    stats.maxJitterUs = std::max(stats.maxJitterUs, jitter);
+    stats.maxRunTimeUs = std::max<uint32_t>(stats.maxRunTimeUs, std::min<int64_t>(finished - started, UINT32_MAX));
+    runsMetric_.Increment();
+    jitterMetric_.Observe(jitter);
+
+    if (job.periodUs) {
+        // drift-free, i.e. keeps the phase, but only catches up on a single run
+        job.due += job.periodUs;
+        if (finished - job.due >= job.periodUs) {
+            uint32_t missed = (finished - job.due) / job.periodUs;
+            job.due += missed * job.periodUs;
+            if (!stats.overruns)
+                ESP_LOGW(kLoggingTag, "%s: Job '%s' is overrunning its period of %u ms.", name_, job.name ? job.name : "?",
+                         static_cast<uint32_t>(job.periodUs / 1000));
+            stats.overruns += missed;
+            overrunsMetric_.Increment(missed);
+        }
+        insert_(index);
+    } else {
+        job.func = nullptr;
+        job.used = false;
+    }
+    xSemaphoreGive(mutex_);
+}
+
+// until the next job is due
+TickType_t JobScheduler::getWaitTime_(int64_t now)
+{
+    int64_t nextDue = INT64_MAX;
+    // the first slot holding a job due within the current round of the wheel has the next one
+    int64_t nowTick = now / kTickUs;
+    for (int64_t tick = nowTick; tick < nowTick + static_cast<int64_t>(kWheelSlots) && nextDue == INT64_MAX; tick++) {
+        for (uint8_t index = slots_[tick % kWheelSlots]; index != kNone; index = jobs_[index].next) {
+            if (jobs_[index].due < (tick + 1) * kTickUs)
+                nextDue = std::min(nextDue, jobs_[index].due);
+        }
+    }
+    // otherwise the earliest of all
+    if (nextDue == INT64_MAX) {
+        for (const Job &job : jobs_) {
+            if (job.used && job.slot != kNone)
+                nextDue = std::min(nextDue, job.due);
+        }
+    }
+
+    if (nextDue == INT64_MAX)
+        return portMAX_DELAY;
+    if (nextDue <= now)
+        return 0;
+    // rounded up, it is better to be a tick late than to wake up for nothing (and portMAX_DELAY would mean forever)
+    return std::min<int64_t>(((nextDue - now) * configTICK_RATE_HZ + 999999) / 1000000, portMAX_DELAY - 1);
+}
+
+void JobScheduler::insert_(uint8_t index)
+{
+    Job &job = jobs_[index];
+    // the slot covering the end of the tick the job is due in, but never one that has been processed already
+    int64_t tick = std::max((job.due + kTickUs - 1) / kTickUs, lastTick_ + 1);
+    job.slot = tick % kWheelSlots;
+    job.next = slots_[job.slot];
+    slots_[job.slot] = index;
+}
+
+void JobScheduler::unlink_(uint8_t index)
+{
+    Job &job = jobs_[index];
+    uint8_t* link = &slots_[job.slot];
+    while (*link != index)
+        link = &jobs_[*link].next;
+    *link = job.next;
+    job.slot = kNone;
+}
+
+JobScheduler::Job* JobScheduler::find_(JobId job)
+{
+    if (job < 0 || (job & 0xff) >= static_cast<JobId>(kMaxJobs))
+        return nullptr;
+    Job &entry = jobs_[job & 0xff];
+    return entry.used && !entry.cancelled && entry.generation == static_cast<uint16_t>(job >> 8) ? &entry : nullptr;
+}
@@ -0,0 +1,88 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <Esp32Logging.hpp>
+#include <functional>
+#include "Metrics.hpp"
+
+
+// Runs periodic and one-shot jobs on a single task instead of a task (and stack) per job, so jobs have to be short and
+// must not block for long. Due times live on a hashed timer wheel, the task sleeps until the next job is due.
+// Periods are drift-free (based on the previous due time, not on when the job actually ran), a job running late by a
+// whole period or more skips the missed runs and counts them as overruns.
+// More schedulers (e.g. for another priority or core) can be created as needed.
+class JobScheduler {
+    public:
+        typedef int JobId;                  ///< negative if invalid
+        static const constexpr JobId kInvalidJob = -1;
+
+        static const constexpr size_t kMaxJobs = 32;
+        static const constexpr size_t kWheelSlots = 64;
+        static const constexpr int64_t kTickUs = 10 * 1000;
+
+        struct Stats {
+            uint32_t runs;
+            uint32_t overruns;              ///< runs skipped because the job was running late by a whole period
+            uint32_t maxJitterUs;           ///< how late a run started at most
+            uint64_t totalJitterUs;
+            uint32_t maxRunTimeUs;
+        };
+
+        // name: also used for the task and as metric label (has to stay valid)
+        explicit JobScheduler(const char* name = "IotBaseJobs");
+
+        // registers the metrics, has to be called before the task gets started (see Run())
+        void Begin();
+        // the task function, e.g. xTaskCreateMonitored(JobScheduler::Run, "IotBaseJobs", 4096, &scheduler, 2)
+        static void Run(void* scheduler);
+
+        // first run after one period, name has to stay valid (used for statistics only, may be nullptr)
+        JobId Every(uint32_t periodMs, std::function<void()> func, const char* name = nullptr);
+        JobId After(uint32_t delayMs, std::function<void()> func, const char* name = nullptr);
+        // safe to call from within jobs (including the job itself), returns false if the job does not exist (anymore)
+        bool Cancel(JobId job);
+
+        bool GetStats(JobId job, Stats &stats);
+        void LogStats();
+
+    private:
+        static const constexpr uint8_t kNone = 0xff;
+
+        struct Job {
+            std::function<void()> func;
+            const char* name = nullptr;
+            int64_t due = 0;                ///< us (esp_timer_get_time())
+            int64_t periodUs = 0;           ///< 0 for one-shot jobs (periods beyond 71 min do not fit 32 bits)
+            uint16_t generation = 0;        ///< part of the id, so ids of finished jobs do not hit reused entries
+            uint8_t slot = kNone;           ///< kNone while not on the wheel (i.e. being run)
+            uint8_t next = kNone;           ///< within the slot
+            bool used = false;
+            bool cancelled = false;         ///< while being run
+            Stats stats = {};
+        };
+
+        const char* name_;
+        SemaphoreHandle_t mutex_ = 0;
+        TaskHandle_t task_ = 0;
+        Job jobs_[kMaxJobs];
+        uint8_t slots_[kWheelSlots];        ///< first job per slot
+        int64_t lastTick_ = 0;              ///< all slots up to this one have been processed
+
+        MetricsRegistry::Counter runsMetric_;
+        MetricsRegistry::Counter overrunsMetric_;
+        MetricsRegistry::Histogram jitterMetric_;
+
+        JobId add_(uint32_t delayMs, uint32_t periodMs, std::function<void()> func, const char* name);
+        void run_();
+        size_t collectDue_(int64_t now, uint8_t* due);
+        void finish_(uint8_t index, int64_t started, int64_t finished);
+        TickType_t getWaitTime_(int64_t now);
+        void insert_(uint8_t index);
+        void unlink_(uint8_t index);
+        Job* find_(JobId job);
+};
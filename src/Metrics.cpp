@@ -0,0 +1,216 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "Metrics.hpp"
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseMetrics";
+
+    const char* typeName(MetricsRegistry::Type type)
+    {
+        switch (type) {
+            case MetricsRegistry::Type::counter:    return "counter";
+            case MetricsRegistry::Type::gauge:      return "gauge";
+            default:                                return "histogram";
+        }
+    }
+}
+
+MetricsRegistry Metrics;
+
+void MetricsRegistry::Counter::Increment(uint32_t amount) const
+{
+    if (metric_)
+        metric_->value.fetch_add(static_cast<int32_t>(amount), std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Counter::SetTotal(uint32_t total) const
+{
+    if (metric_)
+        metric_->value.store(static_cast<int32_t>(total), std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Gauge::Set(int32_t value) const
+{
+    if (metric_)
+        metric_->value.store(value, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Gauge::Add(int32_t amount) const
+{
+    if (metric_)
+        metric_->value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Histogram::Observe(uint32_t value) const
+{
+    if (!metric_)
+        return;
+
+    size_t bucket = 0;
+    while (bucket < metric_->boundCount && value > metric_->bounds[bucket])
+        bucket++;
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    metric_->value.fetch_add(static_cast<int32_t>(value), std::memory_order_relaxed);
+}
+
+MetricsRegistry::MetricsRegistry()
+{
+    mutex_ = xSemaphoreCreateMutex();
+}
+
+MetricsRegistry::Counter MetricsRegistry::AddCounter(const char* name, const char* help, const String &labels)
+{
+    Counter counter;
+    counter.metric_ = add_(name, help, labels, Type::counter, nullptr, 0);
+    return counter;
+}
+
+MetricsRegistry::Gauge MetricsRegistry::AddGauge(const char* name, const char* help, const String &labels)
+{
+    Gauge gauge;
+    gauge.metric_ = add_(name, help, labels, Type::gauge, nullptr, 0);
+    return gauge;
+}
+
+MetricsRegistry::Histogram MetricsRegistry::AddHistogram(const char* name, const char* help, const uint32_t* bounds, size_t boundCount, const String &labels)
+{
+    Histogram histogram;
+    histogram.metric_ = add_(name, help, labels, Type::histogram, bounds, boundCount);
+    if (histogram.metric_)
+        histogram.buckets_ = &buckets_[histogram.metric_->firstBucket];
+    return histogram;
+}
+
+bool MetricsRegistry::AddCollector(std::function<void()> collectFunc)
+{
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    bool added = collectorCount_ < kMaxCollectors;
+    if (added)
+        collectors_[collectorCount_++] = collectFunc;
+    xSemaphoreGive(mutex_);
+
+    if (!added)
+        ESP_LOGW(kLoggingTag, "Too many collectors, ignoring.");
+    return added;
+}
+
+void MetricsRegistry::Collect()
+{
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    for (size_t i = 0; i < collectorCount_; i++)
+        collectors_[i]();
+    xSemaphoreGive(mutex_);
+}
+
+size_t MetricsRegistry::GetMetricCount() const
+{
+    return metricCount_.load(std::memory_order_acquire);
+}
+
+bool MetricsRegistry::WritePrometheusFamily(size_t index, String &output) const
+{
+    size_t count = GetMetricCount();
+    if (index >= count)
+        return false;
+
+    const Metric &first = metrics_[index];
+    for (size_t i = 0; i < index; i++) {
+        // already written along with the first one of that name
+        if (strcmp(metrics_[i].name, first.name) == 0)
+            return true;
+    }
+
+    output += "# HELP ";
+    output += first.name;
+    output += ' ';
+    output += first.help;
+    output += "\n# TYPE ";
+    output += first.name;
+    output += ' ';
+    output += typeName(first.type);
+    output += '\n';
+
+    for (size_t i = index; i < count; i++) {
+        const Metric &metric = metrics_[i];
+        if (strcmp(metric.name, first.name) != 0)
+            continue;
+
+        int32_t value = metric.value.load(std::memory_order_relaxed);
+        if (metric.type == Type::gauge) {
+            writeSample_(output, metric.name, "", metric.labels, nullptr, String(value));
+        } else if (metric.type == Type::counter) {
+            writeSample_(output, metric.name, "", metric.labels, nullptr, String(static_cast<uint32_t>(value)));
+        } else {
+            // Prometheus buckets are cumulative
+            uint32_t cumulative = 0;
+            for (size_t bucket = 0; bucket <= metric.boundCount; bucket++) {
+                cumulative += buckets_[metric.firstBucket + bucket].load(std::memory_order_relaxed);
+                String le = bucket < metric.boundCount ? String(metric.bounds[bucket]) : String("+Inf");
+                writeSample_(output, metric.name, "_bucket", metric.labels, le.c_str(), String(cumulative));
+            }
+            writeSample_(output, metric.name, "_sum", metric.labels, nullptr, String(static_cast<uint32_t>(value)));
+            writeSample_(output, metric.name, "_count", metric.labels, nullptr, String(cumulative));
+        }
+    }
+    return true;
+}
+
+MetricsRegistry::Metric* MetricsRegistry::add_(const char* name, const char* help, const String &labels, Type type, const uint32_t* bounds, size_t boundCount)
+{
+    if (labels.length() >= kMaxLabelsLength) {
+        ESP_LOGW(kLoggingTag, "Labels of metric '%s' too long, ignoring: %s", name, labels.c_str());
+        return nullptr;
+    }
+
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    Metric* metric = nullptr;
+    size_t index = metricCount_.load(std::memory_order_relaxed);
+    size_t bucketCount = type == Type::histogram ? boundCount + 1 : 0;
+    if (index < kMaxMetrics && bucketCount_ + bucketCount <= kMaxHistogramBuckets) {
+        metric = &metrics_[index];
+        metric->name = name;
+        metric->help = help;
+        strcpy(metric->labels, labels.c_str());
+        metric->type = type;
+        metric->bounds = bounds;
+        metric->boundCount = boundCount;
+        metric->firstBucket = bucketCount_;
+        metric->value.store(0, std::memory_order_relaxed);
+        for (size_t bucket = 0; bucket < bucketCount; bucket++)
+            buckets_[bucketCount_ + bucket].store(0, std::memory_order_relaxed);
+        bucketCount_ += bucketCount;
+        // readers only look at published entries
+        metricCount_.store(index + 1, std::memory_order_release);
+    }
+    xSemaphoreGive(mutex_);
+
+    if (!metric)
+        ESP_LOGW(kLoggingTag, "Metrics registry full, ignoring metric '%s'.", name);
+    return metric;
+}
+
+void MetricsRegistry::writeSample_(String &output, const char* name, const char* suffix, const char* labels, const char* le, const String &value)
+{
+    output += name;
+    output += suffix;
+    if (*labels || le) {
+        output += '{';
+        output += labels;
+        if (le) {
+            if (*labels)
+                output += ',';
+            output += "le=\"";
+            output += le;
+            output += '"';
+        }
+        output += '}';
+    }
+    output += ' ';
+    output += value;
+    output += '\n';
+}
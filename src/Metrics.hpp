@@ -0,0 +1,103 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <Esp32Logging.hpp>
+#include <atomic>
+#include <functional>
+
+
+// Fixed-size registry of counters, gauges and histograms. Registration takes a mutex (and must not happen before the
+// scheduler is running, i.e. not from constructors of global objects), updating and reading are lock-free atomic operations.
+class MetricsRegistry {
+    public:
+        enum class Type : uint8_t {counter, gauge, histogram};
+
+        static const constexpr size_t kMaxMetrics = 64;
+        static const constexpr size_t kMaxHistogramBuckets = 32;   ///< shared by all histograms, including +Inf
+        static const constexpr size_t kMaxCollectors = 16;
+        static const constexpr size_t kMaxLabelsLength = 32;
+
+    private:
+        struct Metric {
+            const char* name;
+            const char* help;
+            char labels[kMaxLabelsLength];
+            Type type;
+            // histograms only
+            const uint32_t* bounds;
+            uint8_t boundCount;
+            uint8_t firstBucket;
+            // current value for counters and gauges, sum for histograms
+            std::atomic<int32_t> value;
+        };
+
+    public:
+        // Handles are cheap to copy. If the metric could not be registered (registry full), all updates are ignored.
+        class Counter {
+            public:
+                void Increment(uint32_t amount = 1) const;
+                // for totals maintained elsewhere, meant to be called from a collector
+                void SetTotal(uint32_t total) const;
+            private:
+                friend class MetricsRegistry;
+                Metric* metric_ = nullptr;
+        };
+
+        class Gauge {
+            public:
+                void Set(int32_t value) const;
+                void Add(int32_t amount) const;
+            private:
+                friend class MetricsRegistry;
+                Metric* metric_ = nullptr;
+        };
+
+        class Histogram {
+            public:
+                void Observe(uint32_t value) const;
+            private:
+                friend class MetricsRegistry;
+                Metric* metric_ = nullptr;
+                std::atomic<uint32_t>* buckets_ = nullptr;
+        };
+
+        MetricsRegistry();
+
+        // name and help have to stay valid (literals), labels (e.g. 'task="loopTask"') get copied.
+        // Metrics sharing the same name (but with different labels) need to be of the same type.
+        Counter AddCounter(const char* name, const char* help, const String &labels = {});
+        Gauge AddGauge(const char* name, const char* help, const String &labels = {});
+        // bounds: ascending upper bounds (static), the +Inf bucket gets added automatically
+        Histogram AddHistogram(const char* name, const char* help, const uint32_t* bounds, size_t boundCount, const String &labels = {});
+        template<size_t N> Histogram AddHistogram(const char* name, const char* help, const uint32_t (&bounds)[N], const String &labels = {}) {
+            return AddHistogram(name, help, bounds, N, labels);
+        }
+
+        // called before every scrape, e.g. to sample gauges, has to return quickly
+        bool AddCollector(std::function<void()> collectFunc);
+        void Collect();
+
+        // Prometheus text format, one family (all metrics of the same name) for the first metric of each name,
+        // nothing for the others. Returns false if the index is out of range.
+        size_t GetMetricCount() const;
+        bool WritePrometheusFamily(size_t index, String &output) const;
+
+    private:
+        SemaphoreHandle_t mutex_ = 0;
+        Metric metrics_[kMaxMetrics];
+        std::atomic<size_t> metricCount_{0};
+        std::atomic<uint32_t> buckets_[kMaxHistogramBuckets];
+        size_t bucketCount_ = 0;
+        std::function<void()> collectors_[kMaxCollectors];
+        size_t collectorCount_ = 0;
+
+        Metric* add_(const char* name, const char* help, const String &labels, Type type, const uint32_t* bounds, size_t boundCount);
+        static void writeSample_(String &output, const char* name, const char* suffix, const char* labels, const char* le, const String &value);
+};
+
+extern MetricsRegistry Metrics;
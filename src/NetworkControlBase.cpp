@@ -6,11 +6,37 @@
    */
 
 #include "NetworkControlBase.hpp"
+#include <algorithm>
 
 namespace {
     const constexpr char* kLoggingTag = "IotBaseNetwork";
 
-    const ulong kNetworkConnectedWdtTimeout = 1000UL * 60 * 15; // 15 minutes
+    // default escalation adds up to the 15 minutes we previously waited before restarting right away
+    const ulong kRecoveryMqttReconnectTimeout = 1000UL * 60 * 5;    // 5 minutes without activity
+    const ulong kRecoveryNetworkReconnectTimeout = 1000UL * 60 * 3; // + 3 minutes
+    const ulong kRecoveryNetworkReinitTimeout = 1000UL * 60 * 3;    // + 3 minutes
+    const ulong kRecoveryRebootTimeout = 1000UL * 60 * 4;           // + 4 minutes
+
+    const char* recoveryStageName(NetworkControlBase::RecoveryStage stage)
+    {
+        switch (stage) {
+            case NetworkControlBase::RecoveryStage::none: return "none";
+            case NetworkControlBase::RecoveryStage::mqttReconnect: return "MQTT reconnect";
+            case NetworkControlBase::RecoveryStage::networkReconnect: return "network reconnect";
+            case NetworkControlBase::RecoveryStage::networkReinit: return "network reinit";
+            case NetworkControlBase::RecoveryStage::reboot: return "reboot";
+        }
+        return "unknown";
+    }
+}
+
+NetworkControlBase::NetworkControlBase()
+{
+    recoveryTimeouts_[static_cast<size_t>(RecoveryStage::mqttReconnect)] = kRecoveryMqttReconnectTimeout;
+    recoveryTimeouts_[static_cast<size_t>(RecoveryStage::networkReconnect)] = kRecoveryNetworkReconnectTimeout;
+    recoveryTimeouts_[static_cast<size_t>(RecoveryStage::networkReinit)] = kRecoveryNetworkReinitTimeout;
+    recoveryTimeouts_[static_cast<size_t>(RecoveryStage::reboot)] = kRecoveryRebootTimeout;
+    recoveryMutex_ = xSemaphoreCreateMutex();
 }
 
 bool NetworkControlBase::IsConnected()
@@ -35,35 +61,202 @@ void NetworkControlBase::ResetNetworkConnectedWatchdog()
 {
     ESP_LOGD(kLoggingTag, "Entered function, networkConnectedWdtHandle_: %p", networkConnectedWdtHandle_);
 
-    if (networkConnectedWdtHandle_)
+    if (!networkConnectedWdtHandle_)
+        return;
+
+    RecoveryStage stage = recoveryStage_.exchange(RecoveryStage::none);
+    if (stage == RecoveryStage::none) {
         xTimerReset(networkConnectedWdtHandle_, (TickType_t)0);
+    } else {
+        recoveryCounts_[static_cast<size_t>(stage)]++;
+        ESP_LOGW(kLoggingTag, "Network activity resumed after recovery stage '%s' (%u times so far).",
+                 recoveryStageName(stage), recoveryCounts_[static_cast<size_t>(stage)].load());
+        // start over with the first stage (xTimerChangePeriod also restarts the timer)
+        xSemaphoreTake(recoveryMutex_, portMAX_DELAY);
+        xTimerChangePeriod(networkConnectedWdtHandle_, getStageTimeout_(nextEnabledStage_(RecoveryStage::none)), (TickType_t)0);
+        xSemaphoreGive(recoveryMutex_);
+    }
+}
+
+void NetworkControlBase::SetRecoveryTimeout(RecoveryStage stage, ulong timeoutMs)
+{
+    if (stage == RecoveryStage::none)
+        return;
+    // reboot is the last resort and cannot be skipped
+    if (stage == RecoveryStage::reboot && timeoutMs == 0)
+        timeoutMs = 1;
+    xSemaphoreTake(recoveryMutex_, portMAX_DELAY);
+    recoveryTimeouts_[static_cast<size_t>(stage)] = timeoutMs;
+    updateWdtPeriod_();
+    xSemaphoreGive(recoveryMutex_);
+}
+
+void NetworkControlBase::SetMqttReconnectFunction(std::function<void()> mqttReconnectFunc)
+{
+    // typically only once MQTT has been configured, i.e. with the watchdog already waiting for the following stage
+    xSemaphoreTake(recoveryMutex_, portMAX_DELAY);
+    mqttReconnectFunc_ = mqttReconnectFunc;
+    updateWdtPeriod_();
+    xSemaphoreGive(recoveryMutex_);
+}
+
+NetworkControlBase::RecoveryStage NetworkControlBase::GetRecoveryStage() const
+{
+    return recoveryStage_.load();
+}
+
+uint32_t NetworkControlBase::GetRecoveryCount(RecoveryStage stage) const
+{
+    return recoveryCounts_[static_cast<size_t>(stage)].load();
 }
 
 IPAddress NetworkControlBase::localIp_;
+EventGroupHandle_t NetworkControlBase::connectionEventGroup_ = 0;
+std::vector<std::function<void(bool connected, IPAddress localIp)>> NetworkControlBase::connectionChangeFuncs_;
+
+void NetworkControlBase::OnConnectionChange(std::function<void(bool connected, IPAddress localIp)> connectionChangeFunc)
+{
+    connectionChangeFuncs_.push_back(connectionChangeFunc);
+}
+
+bool NetworkControlBase::WaitForConnection(TickType_t ticksToWait)
+{
+    if (!connectionEventGroup_)
+        return IsConnected();
+
+    return (xEventGroupWaitBits(connectionEventGroup_, kConnectedBit, pdFALSE, pdTRUE, ticksToWait) & kConnectedBit) != 0;
+}
+
+void NetworkControlBase::setConnected_(IPAddress localIp)
+{
+    localIp_ = localIp;
+    if (connectionEventGroup_)
+        xEventGroupSetBits(connectionEventGroup_, kConnectedBit);
+    for (auto &connectionChangeFunc : connectionChangeFuncs_)
+        connectionChangeFunc(true, localIp);
+}
+
+void NetworkControlBase::setDisconnected_()
+{
+    localIp_ = (uint32_t)0;
+    if (connectionEventGroup_)
+        xEventGroupClearBits(connectionEventGroup_, kConnectedBit);
+    for (auto &connectionChangeFunc : connectionChangeFuncs_)
+        connectionChangeFunc(false, localIp_);
+}
+
+void NetworkControlBase::createConnectionEventGroup_()
+{
+    // needs to be in place before the event handlers get registered
+    if (!connectionEventGroup_)
+        connectionEventGroup_ = xEventGroupCreate();
+}
 
 void NetworkControlBase::configureNetworkConnectionWdt_()
 {
+    // recovery actions may block for a while, so they are run on a separate task instead of the timer service task
+    xTaskCreatePinnedToCore(&recoveryTask_, "IotBaseNetRecov", 3072, (void*) this, 5, &recoveryTaskHandle_, CONFIG_ARDUINO_RUNNING_CORE);
+
     // prepare Network Connected WDT
-    networkConnectedWdtHandle_ = xTimerCreate("NetConnWdt", pdMS_TO_TICKS(kNetworkConnectedWdtTimeout), pdFALSE, (void *)0, networkConnectedWdtElapsed_);
+    xSemaphoreTake(recoveryMutex_, portMAX_DELAY);
+    networkConnectedWdtHandle_ = xTimerCreate("NetConnWdt", getStageTimeout_(nextEnabledStage_(RecoveryStage::none)), pdFALSE, (void *)this, networkConnectedWdtElapsed_);
     xTimerStart(networkConnectedWdtHandle_, 0);
+    xSemaphoreGive(recoveryMutex_);
 }
 
 void NetworkControlBase::waitForConnection_()
 {
     // make sure we are fully connected when we return from begin()
-    while (!IsConnected()) {
-        ESP_LOGI(kLoggingTag, "Waiting for connection...");
-        delay(1000);
-    }
-    delay(1000);
+    ESP_LOGI(kLoggingTag, "Waiting for connection...");
+    WaitForConnection();
     ESP_LOGI(kLoggingTag, "Successfully connected.");
 }
 
 void NetworkControlBase::networkConnectedWdtElapsed_(TimerHandle_t xTimer)
 {
-    // apparently something is broken with the network, so we reset and hope that this will solve it...
-    ESP_LOGW(kLoggingTag, "Network connected WDT expirered, restarting!");
+    NetworkControlBase* networkControl = (NetworkControlBase*) pvTimerGetTimerID(xTimer);
+    xTaskNotifyGive(networkControl->recoveryTaskHandle_);
+}
+
+void NetworkControlBase::recoveryTask_(void* networkControlPointer)
+{
+    NetworkControlBase* networkControl = (NetworkControlBase*) networkControlPointer;
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        networkControl->escalateRecovery_();
+    }
+}
+
+void NetworkControlBase::escalateRecovery_()
+{
+    // apparently something is broken with the network, so we try to fix it with increasingly drastic measures
+    RecoveryStage currentStage = recoveryStage_.load();
+    xSemaphoreTake(recoveryMutex_, portMAX_DELAY);
+    RecoveryStage nextStage = nextEnabledStage_(currentStage);
+    xSemaphoreGive(recoveryMutex_);
+
+    // network activity might have been reported in the meantime
+    if (!recoveryStage_.compare_exchange_strong(currentStage, nextStage)) {
+        ESP_LOGD(kLoggingTag, "Network activity resumed in the meantime, not escalating.");
+        return;
+    }
+
+    ESP_LOGW(kLoggingTag, "Network connected WDT expired, entering recovery stage '%s'.", recoveryStageName(nextStage));
+
+    switch (nextStage) {
+        case RecoveryStage::mqttReconnect: {
+            // set on another task
+            xSemaphoreTake(recoveryMutex_, portMAX_DELAY);
+            std::function<void()> mqttReconnectFunc = mqttReconnectFunc_;
+            xSemaphoreGive(recoveryMutex_);
+            if (mqttReconnectFunc)
+                mqttReconnectFunc();
+            break;
+        }
+        case RecoveryStage::networkReconnect:
+            reconnect_();
+            break;
+        case RecoveryStage::networkReinit:
+            reinit_();
+            break;
+        default:
+            delay(2000);
+            ESP.restart();
+            break;
+    }
+
+    // the following stage is entered if there is still no activity after its timeout
+    xSemaphoreTake(recoveryMutex_, portMAX_DELAY);
+    if (recoveryStage_.load() == nextStage)
+        xTimerChangePeriod(networkConnectedWdtHandle_, getStageTimeout_(nextEnabledStage_(nextStage)), (TickType_t)0);
+    xSemaphoreGive(recoveryMutex_);
+}
+
+// applies changed timeouts (or a changed set of enabled stages) to the stage currently being waited for, has to be called
+// with recoveryMutex_ held
+void NetworkControlBase::updateWdtPeriod_()
+{
+    // not while escalating, which sets the period for the following stage afterwards
+    if (!networkConnectedWdtHandle_ || !xTimerIsTimerActive(networkConnectedWdtHandle_))
+        return;
+    // restarts the timer, so the stage gets entered a bit later than configured (by the time it had already been running)
+    xTimerChangePeriod(networkConnectedWdtHandle_, getStageTimeout_(nextEnabledStage_(recoveryStage_.load())), (TickType_t)0);
+}
+
+// has to be called with recoveryMutex_ held
+TickType_t NetworkControlBase::getStageTimeout_(RecoveryStage stage) const
+{
+    return std::max<TickType_t>(pdMS_TO_TICKS(recoveryTimeouts_[static_cast<size_t>(stage)]), 1);
+}
+
+NetworkControlBase::RecoveryStage NetworkControlBase::nextEnabledStage_(RecoveryStage stage) const
+{
+    size_t stageIndex = static_cast<size_t>(stage);
+    do {
+        stageIndex++;
+    } while (stageIndex < static_cast<size_t>(RecoveryStage::reboot) &&
+             (recoveryTimeouts_[stageIndex] == 0 ||
+              (stageIndex == static_cast<size_t>(RecoveryStage::mqttReconnect) && !mqttReconnectFunc_)));
 
-    delay(2000);
-    ESP.restart();
+    return stageIndex < kRecoveryStageCount ? static_cast<RecoveryStage>(stageIndex) : RecoveryStage::reboot;
 }
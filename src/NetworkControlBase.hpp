@@ -10,8 +10,12 @@
 #include <Esp32Logging.hpp>
 #include "Configuration.hpp"
 
+#include <array>
+#include <atomic>
+#include <functional>
 #include <iomanip>
 #include <sstream>
+#include <vector>
 
 
 class NetworkControlBase {
@@ -22,25 +26,57 @@ class NetworkControlBase {
             client,
         };
 
-        NetworkControlBase(){};
-        virtual void Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword) = 0;
+        // Stages the network connected watchdog escalates through as long as no network activity is reported
+        enum class RecoveryStage {
+            none,
+            mqttReconnect,      ///< Reconnect the MQTT client only
+            networkReconnect,   ///< Reassociate WiFi / restart Ethernet DHCP
+            networkReinit,      ///< Shut down and reinitialize the network interface
+            reboot,             ///< Last resort: restart the device
+        };
+
+        NetworkControlBase();
+        virtual void Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword, bool waitForConnection = true) = 0;
         virtual String GetMacAddress(const String& delimiter = {}) = 0;
 
         virtual bool IsConnected();
+        // blocks until an IP address has been obtained (without polling), returns false on timeout
+        bool WaitForConnection(TickType_t ticksToWait = portMAX_DELAY);
         virtual IPAddress GetIp();
         virtual IPAddress GetSoftApIp();
 
         virtual Mode GetWiFiOperationMode() const;
 
+        // called from the network event task whenever an IP address has been obtained or lost, has to return quickly
+        void OnConnectionChange(std::function<void(bool connected, IPAddress localIp)> connectionChangeFunc);
+
         void ResetNetworkConnectedWatchdog();
 
+        // Time without network activity (counted from entering the previous stage) before the given stage is entered.
+        // A timeout of 0 skips the stage (except for reboot).
+        void SetRecoveryTimeout(RecoveryStage stage, ulong timeoutMs);
+        void SetMqttReconnectFunction(std::function<void()> mqttReconnectFunc);
+        RecoveryStage GetRecoveryStage() const;
+        // How often network activity resumed after the given stage had been entered
+        uint32_t GetRecoveryCount(RecoveryStage stage) const;
+
     protected:
         Mode operationMode_ = Mode::unconfigured;
         static IPAddress localIp_;
+        static EventGroupHandle_t connectionEventGroup_;
+        static const constexpr EventBits_t kConnectedBit = BIT0;
+        static std::vector<std::function<void(bool connected, IPAddress localIp)>> connectionChangeFuncs_;
 
+        static void setConnected_(IPAddress localIp);
+        static void setDisconnected_();
+
+        void createConnectionEventGroup_();
         void configureNetworkConnectionWdt_();
         void waitForConnection_();
 
+        virtual void reconnect_() = 0;
+        virtual void reinit_() = 0;
+
         template <typename BYTES>
         String format6Bytes_(const BYTES &bytes, const String& delimiter)
         {
@@ -57,6 +93,21 @@ class NetworkControlBase {
         }
 
     private:
+        static const constexpr size_t kRecoveryStageCount = static_cast<size_t>(RecoveryStage::reboot) + 1;
+
         TimerHandle_t networkConnectedWdtHandle_ = 0;
+        TaskHandle_t recoveryTaskHandle_ = 0;
+        std::atomic<RecoveryStage> recoveryStage_{RecoveryStage::none};
+        std::array<ulong, kRecoveryStageCount> recoveryTimeouts_{};
+        std::array<std::atomic<uint32_t>, kRecoveryStageCount> recoveryCounts_{};
+        // guards recoveryTimeouts_ and mqttReconnectFunc_, which get changed by the application while being used on the recovery task
+        SemaphoreHandle_t recoveryMutex_ = 0;
+        std::function<void()> mqttReconnectFunc_;
+
         static void networkConnectedWdtElapsed_(TimerHandle_t xTimer);
+        static void recoveryTask_(void* networkControlPointer);
+        void escalateRecovery_();
+        RecoveryStage nextEnabledStage_(RecoveryStage stage) const;
+        void updateWdtPeriod_();
+        TickType_t getStageTimeout_(RecoveryStage stage) const;
 };
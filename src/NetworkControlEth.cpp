@@ -1,12 +1,15 @@
 #include "NetworkControlEth.hpp"
+#include "BootProfiler.hpp"
 
 
 namespace {
     const constexpr char* kLoggingTag = "IotBaseNetwork";
 }
 
-void NetworkControlEth::Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword)
+void NetworkControlEth::Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword, bool waitForConnection)
 {
+    IOTBASE_BOOT_PHASE("eth.begin");
+    createConnectionEventGroup_();
     configureNetworkConnectionWdt_();
 
     ESP_LOGI(kLoggingTag, "Connecting to Ethernet");
@@ -19,8 +22,9 @@ void NetworkControlEth::Begin(Configuration& configuration, String hostname, boo
     ETH.setHostname(hostname.c_str());
     ESP_LOGD(kLoggingTag, "Ethernet initialized") ;
 
-    // make sure we are fully connected when we return from Begin()
-    waitForConnection_();
+    // make sure we are fully connected when we return from Begin() (unless asked not to)
+    if (waitForConnection)
+        waitForConnection_();
 }
 
 String NetworkControlEth::GetMacAddress(const String &delimiter)
@@ -30,6 +34,21 @@ String NetworkControlEth::GetMacAddress(const String &delimiter)
     return format6Bytes_(rawMac, delimiter);
 }
 
+void NetworkControlEth::reconnect_()
+{
+    ESP_LOGW(kLoggingTag, "Restarting Ethernet DHCP client");
+    tcpip_adapter_dhcpc_stop(TCPIP_ADAPTER_IF_ETH);
+    tcpip_adapter_dhcpc_start(TCPIP_ADAPTER_IF_ETH);
+}
+
+void NetworkControlEth::reinit_()
+{
+    ESP_LOGW(kLoggingTag, "Reinitializing Ethernet interface");
+    esp_eth_disable();
+    delay(500);
+    esp_eth_enable();
+}
+
 void NetworkControlEth::wiFiEvent_(WiFiEvent_t event)
 {
     switch (event)
@@ -38,12 +57,12 @@ void NetworkControlEth::wiFiEvent_(WiFiEvent_t event)
         ESP_LOGI(kLoggingTag, "ETH Connected");
         break;
     case SYSTEM_EVENT_ETH_GOT_IP:
-        localIp_ = ETH.localIP();
+        setConnected_(ETH.localIP());
         ESP_LOGI(kLoggingTag, "ETH Got IPv4 %s (%d Mbps, full duplex: %d, MAC %s)",
                  localIp_.toString().c_str(), ETH.linkSpeed(), ETH.fullDuplex(), ETH.macAddress().c_str());
         break;
     case SYSTEM_EVENT_ETH_DISCONNECTED:
-        localIp_ = (uint32_t)0;
+        setDisconnected_();
         ESP_LOGI(kLoggingTag, "ETH Disconnected");
         break;
     default:
@@ -7,9 +7,13 @@
 class NetworkControlEth : public NetworkControlBase {
 
     public:
-        virtual void Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword);
+        virtual void Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword, bool waitForConnection = true);
         virtual String GetMacAddress(const String& delimiter = {});
 
+    protected:
+        virtual void reconnect_();
+        virtual void reinit_();
+
     private:
         static void wiFiEvent_(WiFiEvent_t event);
 };
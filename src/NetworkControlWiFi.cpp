@@ -1,4 +1,7 @@
 #include "NetworkControlWiFi.hpp"
+#include "BootProfiler.hpp"
+#include <esp_timer.h>
+#include <rom/crc.h>
 
 
 namespace {
@@ -6,15 +9,48 @@ namespace {
 
     // Minumum access point secret length to be generated (8 is min for ESP32)
     const constexpr unsigned minApSecretLength = 8;
+
+    // Last association and DHCP lease, kept in RTC memory to survive deep sleep and soft resets
+    struct FastConnectCache {
+        uint32_t magic;
+        uint32_t credentialsCrc;    // SSID and password the cache is valid for
+        uint8_t bssid[6];
+        int32_t channel;
+        uint32_t ip;
+        uint32_t gateway;
+        uint32_t subnet;
+        uint32_t dns1;
+        uint32_t dns2;
+        uint32_t fastConnectCount;  // fast connects since the lease has last been obtained via DHCP
+        uint32_t crc;               // over all of the above
+    };
+    RTC_NOINIT_ATTR FastConnectCache fastConnectCache;
+
+    const constexpr uint32_t kFastConnectCacheMagic = 0x46434331;   // "FCC1"
+    // we never renew the lease when using the cached one, so get a fresh one via DHCP once in a while
+    const constexpr uint32_t kFastConnectMaxCount = 50;
+
+    uint32_t fastConnectCacheCrc()
+    {
+        return crc32_le(0, (const uint8_t*) &fastConnectCache, offsetof(FastConnectCache, crc));
+    }
+
+    uint32_t credentialsCrc(const String &ssid, const String &password)
+    {
+        uint32_t crc = crc32_le(0, (const uint8_t*) ssid.c_str(), ssid.length());
+        return crc32_le(crc, (const uint8_t*) password.c_str(), password.length());
+    }
 }
 
-void NetworkControlWiFi::Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword)
+void NetworkControlWiFi::Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword, bool waitForConnection)
 {
+    IOTBASE_BOOT_PHASE("wifi.begin");
+    createConnectionEventGroup_();
     configureNetworkConnectionWdt_();
 
     operationMode_ = configuration.Get(ConfigKey::WifiSsid).length() > 0 ? Mode::client : Mode::accessPoint;
 
-    WiFi.onEvent(wiFiEvent_);
+    WiFi.onEvent([this](system_event_id_t event, system_event_info_t info) { wiFiEvent_(event, info); });
 
     if (operationMode_ == Mode::accessPoint) {
 
@@ -59,28 +95,124 @@ void NetworkControlWiFi::Begin(Configuration& configuration, String hostname, bo
     }
     else if (operationMode_ == Mode::client) {
 
-        String wifiSsid = configuration.Get(ConfigKey::WifiSsid);
-        String wifiPassword = configuration.Get(ConfigKey::WifiPassword);
+        wifiSsid_ = configuration.Get(ConfigKey::WifiSsid);
+        wifiPassword_ = configuration.Get(ConfigKey::WifiPassword);
+        hostname_ = hostname;
         
-        ESP_LOGI(kLoggingTag, "Wifi is configured, connecting to '%s'", wifiSsid.c_str());
-
-        WiFi.mode(WIFI_STA);
-        // WiFi.config seems to be necessary for DHCP to send hostname, see https://github.com/espressif/arduino-esp32/issues/2537
-        WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
-        WiFi.setHostname(hostname.c_str());
-        WiFi.begin(wifiSsid.c_str(), wifiPassword.c_str());
-        // TBD klären
-        // https://github.com/me-no-dev/ESPAsyncWebServer/issues/437
-        // https://github.com/espressif/arduino-esp32/issues/3157
-        WiFi.setSleep(false);
-        //WiFi.setAutoConnect ( true );
-        //WiFi.setAutoReconnect ( true );
-
-        // make sure we are fully connected when we return from Begin()
-        waitForConnection_();
+        ESP_LOGI(kLoggingTag, "Wifi is configured, connecting to '%s'", wifiSsid_.c_str());
+
+        connectStartUs_ = esp_timer_get_time();
+        if (fastConnect_ && isFastConnectCacheValid_()) {
+            connectStationFast_();
+        } else {
+            connectStation_();
+        }
+
+        // make sure we are fully connected when we return from Begin() (unless asked not to)
+        if (waitForConnection)
+            waitForConnection_();
     }
 }
 
+void NetworkControlWiFi::connectStation_()
+{
+    usingCachedLease_ = false;
+    WiFi.mode(WIFI_STA);
+    // WiFi.config seems to be necessary for DHCP to send hostname, see https://github.com/espressif/arduino-esp32/issues/2537
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+    WiFi.setHostname(hostname_.c_str());
+    WiFi.begin(wifiSsid_.c_str(), wifiPassword_.c_str());
+    // TBD klären
+    // https://github.com/me-no-dev/ESPAsyncWebServer/issues/437
+    // https://github.com/espressif/arduino-esp32/issues/3157
+    WiFi.setSleep(false);
+    //WiFi.setAutoConnect ( true );
+    //WiFi.setAutoReconnect ( true );
+}
+
+void NetworkControlWiFi::SetFastConnect(bool fastConnect)
+{
+    fastConnect_ = fastConnect;
+}
+
+int64_t NetworkControlWiFi::GetBootToIpMs() const
+{
+    return bootToIpUs_ / 1000;
+}
+
+bool NetworkControlWiFi::GetConnectedViaFastConnect() const
+{
+    return connectedViaFastConnect_;
+}
+
+void NetworkControlWiFi::connectStationFast_()
+{
+    ESP_LOGI(kLoggingTag, "Fast connect to BSSID %s on channel %d using IP %s",
+             format6Bytes_(fastConnectCache.bssid, ":").c_str(), fastConnectCache.channel, IPAddress(fastConnectCache.ip).toString().c_str());
+
+    fastConnectAttempt_ = true;
+    usingCachedLease_ = true;
+    fastConnectCache.fastConnectCount++;
+    fastConnectCache.crc = fastConnectCacheCrc();
+
+    // directed connect on a single channel with the cached lease as static configuration (no scan, no DHCP)
+    WiFi.mode(WIFI_STA);
+    WiFi.config(IPAddress(fastConnectCache.ip), IPAddress(fastConnectCache.gateway), IPAddress(fastConnectCache.subnet),
+                IPAddress(fastConnectCache.dns1), IPAddress(fastConnectCache.dns2));
+    WiFi.setHostname(hostname_.c_str());
+    WiFi.begin(wifiSsid_.c_str(), wifiPassword_.c_str(), fastConnectCache.channel, fastConnectCache.bssid);
+    WiFi.setSleep(false);
+}
+
+bool NetworkControlWiFi::isFastConnectCacheValid_() const
+{
+    return fastConnectCache.magic == kFastConnectCacheMagic &&
+           fastConnectCache.crc == fastConnectCacheCrc() &&
+           fastConnectCache.credentialsCrc == credentialsCrc(wifiSsid_, wifiPassword_) &&
+           fastConnectCache.fastConnectCount < kFastConnectMaxCount;
+}
+
+void NetworkControlWiFi::saveFastConnectCache_()
+{
+    const uint8_t* bssid = WiFi.BSSID();
+    if (!bssid)
+        return;
+
+    fastConnectCache.magic = kFastConnectCacheMagic;
+    fastConnectCache.credentialsCrc = credentialsCrc(wifiSsid_, wifiPassword_);
+    memcpy(fastConnectCache.bssid, bssid, sizeof(fastConnectCache.bssid));
+    fastConnectCache.channel = WiFi.channel();
+    fastConnectCache.ip = WiFi.localIP();
+    fastConnectCache.gateway = WiFi.gatewayIP();
+    fastConnectCache.subnet = WiFi.subnetMask();
+    fastConnectCache.dns1 = WiFi.dnsIP(0);
+    fastConnectCache.dns2 = WiFi.dnsIP(1);
+    fastConnectCache.fastConnectCount = 0;
+    fastConnectCache.crc = fastConnectCacheCrc();
+}
+
+void NetworkControlWiFi::reconnect_()
+{
+    if (operationMode_ != Mode::client)
+        return;
+
+    ESP_LOGW(kLoggingTag, "Reassociating with '%s'", wifiSsid_.c_str());
+    disconnect_(false);
+    WiFi.begin(wifiSsid_.c_str(), wifiPassword_.c_str());
+}
+
+void NetworkControlWiFi::reinit_()
+{
+    if (operationMode_ != Mode::client)
+        return;
+
+    ESP_LOGW(kLoggingTag, "Reinitializing WiFi stack");
+    disconnect_(true);
+    WiFi.mode(WIFI_OFF);
+    delay(500);
+    connectStation_();
+}
+
 String NetworkControlWiFi::GetMacAddress(const String& delimiter)
 {
     uint8_t rawMac[6];
@@ -92,19 +224,57 @@ IPAddress NetworkControlWiFi::GetSoftApIp() {
     return WiFi.softAPIP();
 }
 
-void NetworkControlWiFi::wiFiEvent_(WiFiEvent_t event)
+void NetworkControlWiFi::disconnect_(bool wifiOff)
+{
+    // the caller starts a new connection right away, so the resulting disconnect event must not do so as well
+    deliberateDisconnect_ = true;
+    WiFi.disconnect(wifiOff);
+}
+
+void NetworkControlWiFi::wiFiEvent_(WiFiEvent_t event, const system_event_info_t& info)
 {
     ESP_LOGD(kLoggingTag, "WiFiEvent %d", event);
 
     switch (event)
     {
     case SYSTEM_EVENT_STA_GOT_IP:
-        localIp_ = WiFi.localIP();
+        setConnected_(WiFi.localIP());
         ESP_LOGI(kLoggingTag, "WIFI Got IPv4 address %s", localIp_.toString().c_str());
+        if (bootToIpUs_ == 0) {
+            int64_t nowUs = esp_timer_get_time();
+            bootToIpUs_ = nowUs;
+            connectedViaFastConnect_ = fastConnectAttempt_;
+            ESP_LOGI(kLoggingTag, "WIFI Connected via %s in %lld ms (boot to IP: %lld ms)", fastConnectAttempt_ ? "fast connect" : "scan & DHCP",
+                     (nowUs - connectStartUs_) / 1000, nowUs / 1000);
+        }
+        // only leases obtained via DHCP are worth remembering
+        if (fastConnect_ && !usingCachedLease_)
+            saveFastConnectCache_();
+        fastConnectAttempt_ = false;
+        // a deliberate disconnect while not connected does not cause any event, so the flag must not outlive this
+        deliberateDisconnect_ = false;
         break;
     case SYSTEM_EVENT_STA_DISCONNECTED:
-        localIp_ = (uint32_t)0;
-        ESP_LOGI(kLoggingTag, "WIFI Lost connection");
+        setDisconnected_();
+        if (deliberateDisconnect_) {
+            deliberateDisconnect_ = false;
+            // whoever called disconnect_() is already starting a new connection, reconnecting here as well would race
+            // their WiFi.begin() - any other reason (e.g. the AP leaving) still needs a reconnect though
+            if (info.disconnected.reason == WIFI_REASON_ASSOC_LEAVE) {
+                ESP_LOGI(kLoggingTag, "WIFI Disconnected deliberately");
+                break;
+            }
+        }
+        if (fastConnectAttempt_) {
+            // AP might have moved to another channel or the like, so fall back to a full scan & DHCP
+            ESP_LOGW(kLoggingTag, "WIFI Fast connect failed, falling back to full connect");
+            fastConnectAttempt_ = false;
+            fastConnectCache.magic = 0;
+            disconnect_(false);
+            connectStation_();
+            break;
+        }
+        ESP_LOGI(kLoggingTag, "WIFI Lost connection (reason %d)", info.disconnected.reason);
         WiFi.reconnect();
         break;
     default:
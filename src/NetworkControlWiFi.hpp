@@ -8,11 +8,41 @@
 class NetworkControlWiFi : public NetworkControlBase {
 
     public:
-        virtual void Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword);
+        virtual void Begin(Configuration& configuration, String hostname, bool encryptAp, String fixedApPassword, bool waitForConnection = true);
         virtual String GetMacAddress(const String& delimiter = {});
         virtual IPAddress GetSoftApIp();
 
+        /** Fast connect (to be set before Begin()).
+         * Remembers BSSID, channel and DHCP lease of the last connection in RTC memory and uses them
+         * for a directed connect with static IP configuration on the next boot (falling back to a full
+         * scan & DHCP if that fails). Only use this if the DHCP server keeps its leases stable.
+        */
+        void SetFastConnect(bool fastConnect);
+        int64_t GetBootToIpMs() const;
+        bool GetConnectedViaFastConnect() const;
+
+    protected:
+        virtual void reconnect_();
+        virtual void reinit_();
+
     private:
-        static void wiFiEvent_(WiFiEvent_t event);
+        String wifiSsid_;
+        String wifiPassword_;
+        String hostname_;
+
+        bool fastConnect_ = false;
+        volatile bool fastConnectAttempt_ = false;
+        volatile bool deliberateDisconnect_ = false;    ///< set by disconnect_() until the resulting event
+        bool usingCachedLease_ = false;
+        bool connectedViaFastConnect_ = false;
+        int64_t connectStartUs_ = 0;
+        int64_t bootToIpUs_ = 0;
+
+        void connectStation_();
+        void connectStationFast_();
+        bool isFastConnectCacheValid_() const;
+        void saveFastConnectCache_();
+        void disconnect_(bool wifiOff);
+        void wiFiEvent_(WiFiEvent_t event, const system_event_info_t& info);
         String generateRandomSecret_(unsigned length) const;
 };
@@ -0,0 +1,121 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "ServiceStarter.hpp"
+#include "BootProfiler.hpp"
+#include <esp_timer.h>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseStartup";
+}
+
+ServiceStarter::ServiceStarter()
+{
+    services_.reserve(kMaxServices);
+}
+
+ServiceStarter::ServiceBits ServiceStarter::Add(const char* name, ServiceBits dependencies, std::function<void()> startFunc, uint32_t stackSize)
+{
+    if (services_.size() >= kMaxServices) {
+        ESP_LOGE(kLoggingTag, "ERROR: Too many services, cannot add '%s'.", name);
+        return 0;
+    }
+
+    ServiceBits bit = 1 << services_.size();
+    services_.push_back({name, bit, dependencies, startFunc, stackSize, this, 0, 0, 0});
+    return bit;
+}
+
+void ServiceStarter::Start(std::function<void()> doneFunc, uint32_t doneStackSize)
+{
+    eventGroup_ = xEventGroupCreate();
+    doneFunc_ = doneFunc;
+    doneStackSize_ = doneStackSize;
+    startUs_ = esp_timer_get_time();
+
+    if (services_.empty()) {
+        if (doneFunc_)
+            doneFunc_();
+        return;
+    }
+
+    for (auto &service : services_) {
+        int taskCreateResult;
+        if ((taskCreateResult = xTaskCreatePinnedToCore(&serviceTask_, service.name, service.stackSize, (void*) &service, 5, NULL, CONFIG_ARDUINO_RUNNING_CORE)) != pdPASS) {
+            ESP_LOGE(kLoggingTag, "ERROR calling xTaskCreate for '%s': %i, stopping.", service.name, taskCreateResult);
+            for(;;);
+        }
+    }
+
+    if (doneFunc_) {
+        int taskCreateResult;
+        if ((taskCreateResult = xTaskCreatePinnedToCore(&doneTask_, "servicesDone", doneStackSize_, (void*) this, 5, NULL, CONFIG_ARDUINO_RUNNING_CORE)) != pdPASS) {
+            ESP_LOGE(kLoggingTag, "ERROR calling xTaskCreate for 'servicesDone': %i, stopping.", taskCreateResult);
+            for(;;);
+        }
+    }
+}
+
+bool ServiceStarter::WaitUntilDone(TickType_t ticksToWait)
+{
+    if (!eventGroup_)
+        return false;
+
+    ServiceBits allBits = (1 << services_.size()) - 1;
+    return (xEventGroupWaitBits(eventGroup_, allBits, pdFALSE, pdTRUE, ticksToWait) & allBits) == allBits;
+}
+
+void ServiceStarter::LogTimeline() const
+{
+    const Service* slowest = nullptr;
+    for (const auto &service : services_) {
+        if (!slowest || (service.endUs - service.startUs) > (slowest->endUs - slowest->startUs))
+            slowest = &service;
+    }
+
+    ESP_LOGI(kLoggingTag, "*** Service Startup Timeline (ms after start, stack used) ***");
+    for (const auto &service : services_) {
+        ESP_LOGI(kLoggingTag, "%-16s %6lld - %6lld  (%5lld ms)  %5u / %5u bytes%s", service.name,
+                 (service.startUs - startUs_) / 1000, (service.endUs - startUs_) / 1000, (service.endUs - service.startUs) / 1000,
+                 service.stackSize - service.stackFree, service.stackSize, &service == slowest ? "  <- slowest" : "");
+    }
+}
+
+void ServiceStarter::serviceTask_(void* servicePointer)
+{
+    Service* service = (Service*) servicePointer;
+    ServiceStarter* starter = service->starter;
+
+    if (service->dependencies)
+        xEventGroupWaitBits(starter->eventGroup_, service->dependencies, pdFALSE, pdTRUE, portMAX_DELAY);
+
+    service->startUs = esp_timer_get_time();
+    {
+        IOTBASE_BOOT_PHASE(service->name);
+        service->startFunc();
+    }
+    service->endUs = esp_timer_get_time();
+    // ESP-IDF reports the high-water mark in bytes
+    service->stackFree = uxTaskGetStackHighWaterMark(NULL);
+    ESP_LOGD(kLoggingTag, "Service '%s' done after %lld ms.", service->name, (service->endUs - service->startUs) / 1000);
+
+    xEventGroupSetBits(starter->eventGroup_, service->bit);
+
+    vTaskDelete(NULL);
+}
+
+void ServiceStarter::doneTask_(void* starterPointer)
+{
+    ServiceStarter* starter = (ServiceStarter*) starterPointer;
+
+    starter->WaitUntilDone();
+    starter->doneFunc_();
+    ESP_LOGI(kLoggingTag, "%-16s %5u / %5u bytes stack used", "(done)",
+             starter->doneStackSize_ - uxTaskGetStackHighWaterMark(NULL), starter->doneStackSize_);
+
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,57 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <Esp32Logging.hpp>
+#include <functional>
+#include <vector>
+
+
+// Runs service initializations concurrently on short-lived worker tasks, each one as soon as all of its dependencies are done
+class ServiceStarter {
+    public:
+        typedef EventBits_t ServiceBits;
+
+        static const constexpr uint32_t kDefaultStackSize = 4096;
+
+        ServiceStarter();
+
+        // Returns the bit representing the service, to be used (or-ed) as dependencies of other services.
+        // All services have to be added before calling Start().
+        // stackSize (in bytes) is the stack of the worker task, LogTimeline() shows how much of it has been used.
+        ServiceBits Add(const char* name, ServiceBits dependencies, std::function<void()> startFunc, uint32_t stackSize = kDefaultStackSize);
+        // doneFunc is called on a task of its own (with a stack of doneStackSize bytes) once all services are done
+        void Start(std::function<void()> doneFunc = 0, uint32_t doneStackSize = kDefaultStackSize);
+        bool WaitUntilDone(TickType_t ticksToWait = portMAX_DELAY);
+        // including the stack high-water marks, i.e. meant to be called once all services are done
+        void LogTimeline() const;
+
+    private:
+        struct Service {
+            const char* name;
+            ServiceBits bit;
+            ServiceBits dependencies;
+            std::function<void()> startFunc;
+            uint32_t stackSize;
+            ServiceStarter* starter;
+            int64_t startUs;
+            int64_t endUs;
+            uint32_t stackFree;         ///< minimum free stack in bytes, recorded when done
+        };
+
+        // FreeRTOS event groups have 24 usable bits
+        static const constexpr size_t kMaxServices = 24;
+
+        EventGroupHandle_t eventGroup_ = 0;
+        std::vector<Service> services_;
+        std::function<void()> doneFunc_;
+        uint32_t doneStackSize_ = 0;
+        int64_t startUs_ = 0;
+
+        static void serviceTask_(void* servicePointer);
+        static void doneTask_(void* starterPointer);
+};
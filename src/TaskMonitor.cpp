@@ -0,0 +1,469 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "TaskMonitor.hpp"
+#include <esp_timer.h>
+#include <algorithm>
+#include <memory>
+#include <new>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseTasks";
+
+    const uint32_t kLatenessBounds[] = { 100, 1000, 10000, 60000, 600000 };
+
+    // set by ExpectHeartbeats(), on the monitored task itself
+    thread_local std::atomic<TickType_t>* tHeartbeat = nullptr;
+    thread_local TickType_t tHeartbeatPeriod = 0;
+}
+
+const char* TaskMonitor::GetStallActionName(StallAction action)
+{
+    switch (action) {
+        case StallAction::restartTask:
+            return "restartTask";
+        case StallAction::restartDevice:
+            return "restartDevice";
+        default:
+            return "alert";
+    }
+}
+
+void TaskMonitor::Begin()
+{
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+            cores_[core].busyTimeMetric = Metrics.AddCounter("iotbase_core_busy_milliseconds_total", "Time the core was not running its idle task",
+                                                             String("core=\"") + core + "\"");
+    #endif
+    latenessMetric_ = Metrics.AddHistogram("iotbase_task_heartbeat_lateness_milliseconds", "How late missed heartbeats were when the stall ended", kLatenessBounds);
+
+    // a single collector for all tasks, including the ones added later on
+    Metrics.AddCollector([this]()
+    {
+        // only what is needed, this runs on the web server's task
+        struct {
+            TaskHandle_t handle;
+            MetricsRegistry::Gauge stackFreeMetric;
+        #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+            uint64_t cpuTimeUs;
+            MetricsRegistry::Counter cpuTimeMetric;
+        #endif
+        } tasks[kMaxTasks];
+        portENTER_CRITICAL(&lock_);
+        size_t taskCount = taskCount_;
+        for (size_t i = 0; i < taskCount; i++) {
+            tasks[i].handle = tasks_[i].handle;
+            tasks[i].stackFreeMetric = tasks_[i].stackFreeMetric;
+            #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+                tasks[i].cpuTimeUs = tasks_[i].cpuTimeUs;
+                tasks[i].cpuTimeMetric = tasks_[i].cpuTimeMetric;
+            #endif
+        }
+        portEXIT_CRITICAL(&lock_);
+
+        for (size_t i = 0; i < taskCount; i++) {
+            if (!tasks[i].handle)
+                continue;
+            tasks[i].stackFreeMetric.Set(uxTaskGetStackHighWaterMark(tasks[i].handle));
+            #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+                tasks[i].cpuTimeMetric.SetTotal(tasks[i].cpuTimeUs / 1000);
+            #endif
+        }
+        #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+            portENTER_CRITICAL(&lock_);
+            uint64_t busyTimesUs[portNUM_PROCESSORS];
+            for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+                busyTimesUs[core] = cores_[core].busyTimeUs;
+            portEXIT_CRITICAL(&lock_);
+            for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+                cores_[core].busyTimeMetric.SetTotal(busyTimesUs[core] / 1000);
+        #endif
+    });
+}
+
+void TaskMonitor::OnStall(StallFunc stallFunc)
+{
+    stallFunc_ = stallFunc;
+}
+
+TaskHandle_t TaskMonitor::Create(TaskFunction_t func, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority, BaseType_t core)
+{
+    if (core == kLeastLoadedCore)
+        core = getLeastLoadedCore_();
+
+    TaskHandle_t handle = 0;
+    int result = xTaskCreatePinnedToCore(func, name, stackSize, parameter, priority, &handle, core);
+    if (result != pdPASS) {
+        ESP_LOGE(kLoggingTag, "Could not create task '%s': %i", name, result);
+        return 0;
+    }
+    ESP_LOGD(kLoggingTag, "Task '%s' created on core %d (priority %u).", name, core, priority);
+
+    Task task;
+    task.handle = handle;
+    task.core = core;
+    task.func = func;
+    task.stackSize = stackSize;
+    task.parameter = parameter;
+    task.priority = priority;
+    add_(task);
+    return handle;
+}
+
+void TaskMonitor::Add(TaskHandle_t handle, BaseType_t core)
+{
+    Task task;
+    task.handle = handle;
+    task.core = core;
+    add_(task);
+}
+
+bool TaskMonitor::ExpectHeartbeats(uint32_t periodMs, StallAction action)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    const char* name = pcTaskGetTaskName(self);
+    int index = -1;
+    // a task calling this right away might not have been added by its creator yet
+    for (int retries = 0; index < 0 && retries < 10; retries++) {
+        if (retries)
+            vTaskDelay(pdMS_TO_TICKS(10));
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < taskCount_; i++) {
+            if (tasks_[i].handle == self)
+                index = i;
+        }
+        portEXIT_CRITICAL(&lock_);
+    }
+    if (index < 0) {
+        ESP_LOGE(kLoggingTag, "Task '%s' is not monitored, cannot expect heartbeats.", name);
+        return false;
+    }
+
+    portENTER_CRITICAL(&lock_);
+    bool canRestart = tasks_[index].func != nullptr;
+    bool stallsMetricAdded = tasks_[index].stallsMetricAdded;
+    portEXIT_CRITICAL(&lock_);
+    if (action == StallAction::restartTask && !canRestart) {
+        ESP_LOGE(kLoggingTag, "Task '%s' has not been created by xTaskCreateMonitored() and thus cannot be restarted.", name);
+        return false;
+    }
+    // again after a restart, but there is only one metric per task
+    MetricsRegistry::Counter stallsMetric;
+    if (!stallsMetricAdded)
+        stallsMetric = Metrics.AddCounter("iotbase_task_stalls_total", "Heartbeats missed by the task", String("task=\"") + name + "\"");
+
+    portENTER_CRITICAL(&lock_);
+    Task &task = tasks_[index];
+    if (!stallsMetricAdded) {
+        task.stallsMetric = stallsMetric;
+        task.stallsMetricAdded = true;
+    }
+    task.heartbeatPeriod = std::max<TickType_t>(pdMS_TO_TICKS(periodMs), 1);
+    task.stallAction = action;
+    task.stalled = false;
+    heartbeats_[index].store(xTaskGetTickCount(), std::memory_order_relaxed);
+    portEXIT_CRITICAL(&lock_);
+
+    tHeartbeat = &heartbeats_[index];
+    tHeartbeatPeriod = std::max<TickType_t>(pdMS_TO_TICKS(periodMs), 1);
+    ESP_LOGI(kLoggingTag, "Task '%s' is expected to send heartbeats every %u ms (%s).", name, periodMs, GetStallActionName(action));
+    return true;
+}
+
+void TaskMonitor::Heartbeat()
+{
+    if (tHeartbeat)
+        tHeartbeat->store(xTaskGetTickCount(), std::memory_order_relaxed);
+}
+
+TickType_t TaskMonitor::GetHeartbeatPeriod()
+{
+    return tHeartbeatPeriod;
+}
+
+void TaskMonitor::Sample()
+{
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        // some room for tasks being created meanwhile
+        UBaseType_t capacity = uxTaskGetNumberOfTasks() + 4;
+        std::unique_ptr<TaskStatus_t[]> states(new (std::nothrow) TaskStatus_t[capacity]);
+        if (!states)
+            return;
+        uint32_t totalRunTime = 0;
+        UBaseType_t stateCount = uxTaskGetSystemState(states.get(), capacity, &totalRunTime);
+        int64_t now = esp_timer_get_time();
+        if (!stateCount)
+            return;
+        TaskHandle_t idleTasks[portNUM_PROCESSORS];
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+            idleTasks[core] = xTaskGetIdleTaskHandleForCPU(core);
+
+        portENTER_CRITICAL(&lock_);
+        // the first sample only provides the starting point
+        bool isFirst = lastSampleTime_ == 0;
+        uint32_t elapsed = totalRunTime - lastTotalRunTime_;
+        int64_t elapsedUs = now - lastSampleTime_;
+        lastTotalRunTime_ = totalRunTime;
+        lastSampleTime_ = now;
+        if (!isFirst && !elapsed) {
+            portEXIT_CRITICAL(&lock_);
+            return;
+        }
+        // converts run time counter units (which may be CPU cycles) to us
+        auto toUs = [elapsed, elapsedUs](uint32_t runTime) { return static_cast<uint64_t>(runTime) * elapsedUs / elapsed; };
+        auto toUsage = [elapsed](uint32_t runTime) { return static_cast<uint16_t>(std::min<uint64_t>(static_cast<uint64_t>(runTime) * 1000 / elapsed, 1000)); };
+
+        for (UBaseType_t i = 0; i < stateCount; i++) {
+            const TaskStatus_t &state = states[i];
+            for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+                if (state.xHandle != idleTasks[core])
+                    continue;
+                Core &entry = cores_[core];
+                if (!isFirst) {
+                    uint32_t busy = elapsed - std::min(state.ulRunTimeCounter - entry.lastIdleRunTime, elapsed);
+                    entry.usage = toUsage(busy);
+                    entry.busyTimeUs += toUs(busy);
+                }
+                entry.lastIdleRunTime = state.ulRunTimeCounter;
+            }
+            for (size_t j = 0; j < taskCount_; j++) {
+                Task &task = tasks_[j];
+                if (state.xHandle != task.handle)
+                    continue;
+                // tasks added since the last sample have been running for part of the interval at most
+                if (task.sampled && !isFirst) {
+                    uint32_t runTime = state.ulRunTimeCounter - task.lastRunTime;
+                    task.usage = toUsage(runTime);
+                    task.cpuTimeUs += toUs(runTime);
+                }
+                task.lastRunTime = state.ulRunTimeCounter;
+                task.sampled = true;
+            }
+        }
+        usageValid_ = !isFirst;
+        portEXIT_CRITICAL(&lock_);
+    #endif
+}
+
+void TaskMonitor::Supervise()
+{
+    // the actions are taken outside of the critical section
+    struct {
+        size_t index;
+        char name[configMAX_TASK_NAME_LEN];
+        uint32_t lateMs;
+        StallAction action;
+        bool ended;                         ///< heartbeats have resumed
+        MetricsRegistry::Counter stallsMetric;
+    } events[kMaxTasks];
+    size_t eventCount = 0;
+
+    TickType_t now = xTaskGetTickCount();
+    portENTER_CRITICAL(&lock_);
+    for (size_t i = 0; i < taskCount_; i++) {
+        Task &task = tasks_[i];
+        if (!task.handle || !task.heartbeatPeriod)
+            continue;
+        TickType_t lastHeartbeat = heartbeats_[i].load(std::memory_order_relaxed);
+        auto &event = events[eventCount];
+        if (!task.stalled) {
+            // the tick count wraps around
+            TickType_t due = lastHeartbeat + task.heartbeatPeriod;
+            if (static_cast<int32_t>(now - due) <= 0)
+                continue;
+            task.stalled = true;
+            task.stallDue = due;
+            task.stalls++;
+            event.lateMs = (now - due) * portTICK_PERIOD_MS;
+            event.ended = false;
+        } else if (lastHeartbeat != task.stallDue - task.heartbeatPeriod) {
+            // the latest heartbeat, not necessarily the first one after the stall
+            task.stalled = false;
+            event.lateMs = (lastHeartbeat - task.stallDue) * portTICK_PERIOD_MS;
+            event.ended = true;
+            task.maxLateMs = std::max(task.maxLateMs, event.lateMs);
+        } else {
+            continue;
+        }
+        event.index = i;
+        strlcpy(event.name, pcTaskGetTaskName(task.handle), sizeof(event.name));
+        event.action = task.stallAction;
+        event.stallsMetric = task.stallsMetric;
+        eventCount++;
+    }
+    portEXIT_CRITICAL(&lock_);
+
+    for (size_t i = 0; i < eventCount; i++) {
+        const auto &event = events[i];
+        if (event.ended) {
+            ESP_LOGW(kLoggingTag, "Task '%s' has resumed its heartbeats, %u ms late.", event.name, event.lateMs);
+            latenessMetric_.Observe(event.lateMs);
+            continue;
+        }
+
+        ESP_LOGE(kLoggingTag, "Task '%s' has missed its heartbeat by %u ms (%s).", event.name, event.lateMs, GetStallActionName(event.action));
+        event.stallsMetric.Increment();
+        if (stallFunc_)
+            stallFunc_(event.name, event.lateMs, event.action);
+
+        switch (event.action) {
+            case StallAction::restartTask:
+                // which ends the stall
+                latenessMetric_.Observe(event.lateMs);
+                restart_(event.index, event.lateMs);
+                break;
+            case StallAction::restartDevice:
+                // some time to get the alert out
+                delay(2000);
+                ESP.restart();
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void TaskMonitor::Log()
+{
+    Task tasks[kMaxTasks];
+    portENTER_CRITICAL(&lock_);
+    size_t taskCount = taskCount_;
+    std::copy(tasks_, tasks_ + taskCount, tasks);
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        bool usageValid = usageValid_;
+        uint16_t coreUsages[portNUM_PROCESSORS];
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+            coreUsages[core] = cores_[core].usage;
+    #endif
+    portEXIT_CRITICAL(&lock_);
+
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        ESP_LOGI("SysInfo", "*** Monitored Tasks (core, stack high water mark, CPU usage during the last %u s) ***", kSampleInterval / 1000);
+    #else
+        ESP_LOGI("SysInfo", "*** Monitored Tasks (core, stack high water mark) ***");
+    #endif
+    for (size_t i = 0; i < taskCount; i++) {
+        const Task &task = tasks[i];
+        if (!task.handle)
+            continue;
+        char core[4];
+        if (task.core == tskNO_AFFINITY)
+            strcpy(core, "any");
+        else
+            snprintf(core, sizeof(core), "%d", task.core);
+        #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+            ESP_LOGI("SysInfo", "%-15s %-3s %6u bytes %3u.%u %%", pcTaskGetTaskName(task.handle), core, uxTaskGetStackHighWaterMark(task.handle),
+                     task.usage / 10, task.usage % 10);
+        #else
+            ESP_LOGI("SysInfo", "%-15s %-3s %6u bytes", pcTaskGetTaskName(task.handle), core, uxTaskGetStackHighWaterMark(task.handle));
+        #endif
+    }
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        if (usageValid) {
+            for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+                ESP_LOGI("SysInfo", "Core %d busy %u.%u %%", core, coreUsages[core] / 10, coreUsages[core] % 10);
+        }
+    #endif
+
+    bool headerLogged = false;
+    for (size_t i = 0; i < taskCount; i++) {
+        const Task &task = tasks[i];
+        if (!task.handle || !task.heartbeatPeriod)
+            continue;
+        if (!headerLogged) {
+            ESP_LOGI("SysInfo", "*** Task Heartbeats (period, stalls, max late, restarts) ***");
+            headerLogged = true;
+        }
+        ESP_LOGI("SysInfo", "%-15s %7u ms %6u %8u ms %4u%s", pcTaskGetTaskName(task.handle), task.heartbeatPeriod * portTICK_PERIOD_MS, task.stalls,
+                 task.maxLateMs, task.restarts, task.stalled ? "  STALLED" : "");
+    }
+}
+
+// the core with the lower measured load or, as long as nothing has been measured yet (e.g. during startup or without
+// run time stats), the one with fewer monitored tasks pinned to it (which does not account for e.g. WiFi on core 0)
+BaseType_t TaskMonitor::getLeastLoadedCore_()
+{
+    uint32_t loads[portNUM_PROCESSORS] = {};
+    portENTER_CRITICAL(&lock_);
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        if (usageValid_) {
+            for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++)
+                loads[core] = cores_[core].usage;
+        } else
+    #endif
+    {
+        for (size_t i = 0; i < taskCount_; i++) {
+            if (tasks_[i].core >= 0 && tasks_[i].core < portNUM_PROCESSORS)
+                loads[tasks_[i].core]++;
+        }
+    }
+    portEXIT_CRITICAL(&lock_);
+
+    BaseType_t leastLoaded = 0;
+    for (BaseType_t core = 1; core < portNUM_PROCESSORS; core++) {
+        if (loads[core] < loads[leastLoaded])
+            leastLoaded = core;
+    }
+    return leastLoaded;
+}
+
+void TaskMonitor::add_(const Task &task)
+{
+    // registering metrics takes a mutex, so it has to happen before entering the critical section
+    Task entry = task;
+    String labels = String("task=\"") + pcTaskGetTaskName(task.handle) + "\"";
+    entry.stackFreeMetric = Metrics.AddGauge("iotbase_task_stack_free_bytes", "Stack high water mark (lowest free stack space) of the task", labels);
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        entry.cpuTimeMetric = Metrics.AddCounter("iotbase_task_cpu_milliseconds_total", "CPU time used by the task", labels);
+    #endif
+
+    portENTER_CRITICAL(&lock_);
+    bool added = taskCount_ < kMaxTasks;
+    if (added) {
+        heartbeats_[taskCount_].store(0, std::memory_order_relaxed);
+        tasks_[taskCount_++] = entry;
+    }
+    portEXIT_CRITICAL(&lock_);
+
+    if (!added)
+        ESP_LOGE(kLoggingTag, "No room to monitor task '%s'.", pcTaskGetTaskName(task.handle));
+}
+
+// deletes and recreates the task, which then has its whole period until the first heartbeat is due
+void TaskMonitor::restart_(size_t index, uint32_t lateMs)
+{
+    // not to be used by anybody else meanwhile
+    portENTER_CRITICAL(&lock_);
+    Task task = tasks_[index];
+    tasks_[index].handle = 0;
+    portEXIT_CRITICAL(&lock_);
+
+    char name[configMAX_TASK_NAME_LEN];
+    strlcpy(name, pcTaskGetTaskName(task.handle), sizeof(name));
+    vTaskDelete(task.handle);
+    TaskHandle_t handle = 0;
+    int result = xTaskCreatePinnedToCore(task.func, name, task.stackSize, task.parameter, task.priority, &handle, task.core);
+    if (result != pdPASS) {
+        // no longer monitored
+        ESP_LOGE(kLoggingTag, "Could not restart task '%s': %i", name, result);
+        return;
+    }
+    ESP_LOGW(kLoggingTag, "Task '%s' has been restarted.", name);
+
+    portENTER_CRITICAL(&lock_);
+    Task &entry = tasks_[index];
+    entry.handle = handle;
+    entry.stalled = false;
+    entry.maxLateMs = std::max(entry.maxLateMs, lateMs);
+    entry.restarts++;
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        entry.sampled = false;
+    #endif
+    heartbeats_[index].store(xTaskGetTickCount(), std::memory_order_relaxed);
+    portEXIT_CRITICAL(&lock_);
+}
@@ -0,0 +1,118 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <Esp32Logging.hpp>
+#include <atomic>
+#include <functional>
+#include "Metrics.hpp"
+
+
+// Keeps track of the tasks created by Esp32IotBase::xTaskCreateMonitored() (and the loop task): the core they have
+// been placed on and their stack high water marks. With CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS also the CPU time used
+// by them and by the cores as a whole, sampled by calling Sample() every kSampleInterval.
+// Tasks may also opt into heartbeats, which Supervise() checks every kSupervisionInterval to detect stalled tasks.
+// Fixed-size and guarded by a spinlock, so tasks may be added before Esp32IotBase::Begin() has been called.
+class TaskMonitor {
+    public:
+        static const constexpr size_t kMaxTasks = 16;
+        // in addition to 0, 1 or tskNO_AFFINITY as taken by xTaskCreatePinnedToCore()
+        static const constexpr BaseType_t kLeastLoadedCore = -2;
+        // ms, has to be shorter than the run time counter takes to wrap around (about 17 s when using CCOUNT at 240 MHz)
+        static const constexpr uint32_t kSampleInterval = 5000;
+        // ms, also the resolution of the lateness recorded for stalls
+        static const constexpr uint32_t kSupervisionInterval = 1000;
+
+        // what happens once a task has missed its heartbeat, an alert is always published
+        enum class StallAction : uint8_t {
+            alert,
+            restartTask,        ///< deletes and recreates the task (only for tasks created by Create()), which must not hold any locks or resources that would then be lost
+            restartDevice,
+        };
+        static const char* GetStallActionName(StallAction action);
+
+        // task name, how late its heartbeat is (ms) and what is being done about it
+        typedef std::function<void(const char* task, uint32_t lateMs, StallAction action)> StallFunc;
+
+        // registers the metrics
+        void Begin();
+        // called on the supervising task, has to be set before supervision starts
+        void OnStall(StallFunc stallFunc);
+
+        // returns 0 if the task could not be created
+        TaskHandle_t Create(TaskFunction_t func, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority, BaseType_t core);
+        // for tasks created otherwise (e.g. the loop task), core as passed to xTaskCreatePinnedToCore()
+        void Add(TaskHandle_t handle, BaseType_t core);
+
+        // To be called by the monitored task itself (again after having been restarted), which then has to call Heartbeat() at
+        // least every periodMs. Returns false if the task is not monitored or cannot be restarted as requested.
+        bool ExpectHeartbeats(uint32_t periodMs, StallAction action = StallAction::alert);
+        // a single atomic store, does nothing on tasks that have not called ExpectHeartbeats()
+        static void Heartbeat();
+        // of the calling task (ticks), 0 if it has not called ExpectHeartbeats()
+        static TickType_t GetHeartbeatPeriod();
+
+        // to be called every kSampleInterval, does nothing without run time stats
+        void Sample();
+        // to be called every kSupervisionInterval, runs the stall actions (so the calling task cannot be supervised itself)
+        void Supervise();
+        void Log();
+
+    private:
+        struct Task {
+            TaskHandle_t handle = 0;        ///< 0 while being restarted (or if that has failed)
+            BaseType_t core = tskNO_AFFINITY;
+            MetricsRegistry::Gauge stackFreeMetric;
+            // to be able to recreate the task, only known for tasks created by Create()
+            TaskFunction_t func = nullptr;
+            uint32_t stackSize = 0;
+            void* parameter = nullptr;
+            UBaseType_t priority = 0;
+            // heartbeats (the time of the last one is kept in heartbeats_)
+            TickType_t heartbeatPeriod = 0; ///< 0 if not expecting any
+            StallAction stallAction = StallAction::alert;
+            bool stalled = false;
+            TickType_t stallDue = 0;        ///< when the missed heartbeat had been due
+            uint32_t stalls = 0;
+            uint32_t maxLateMs = 0;         ///< of all stalls that have ended
+            uint32_t restarts = 0;
+            bool stallsMetricAdded = false;
+            MetricsRegistry::Counter stallsMetric;
+        #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+            bool sampled = false;           ///< lastRunTime is valid
+            uint32_t lastRunTime = 0;       ///< run time counter units (us or CPU cycles)
+            uint16_t usage = 0;             ///< during the last sample interval (per mille of one core)
+            uint64_t cpuTimeUs = 0;
+            MetricsRegistry::Counter cpuTimeMetric;
+        #endif
+        };
+
+        portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+        Task tasks_[kMaxTasks];
+        size_t taskCount_ = 0;
+        // kept apart from tasks_ to be updatable without the lock (ticks, xTaskGetTickCount())
+        std::atomic<TickType_t> heartbeats_[kMaxTasks];
+        StallFunc stallFunc_;
+        MetricsRegistry::Histogram latenessMetric_;
+    #if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        // per core, based on the run time of its idle task
+        struct Core {
+            uint32_t lastIdleRunTime = 0;
+            uint16_t usage = 0;             ///< per mille
+            uint64_t busyTimeUs = 0;
+            MetricsRegistry::Counter busyTimeMetric;
+        };
+        Core cores_[portNUM_PROCESSORS];
+        int64_t lastSampleTime_ = 0;        ///< us (esp_timer_get_time()), 0 before the first sample
+        uint32_t lastTotalRunTime_ = 0;
+        bool usageValid_ = false;           ///< at least one whole interval has been sampled
+    #endif
+
+        BaseType_t getLeastLoadedCore_();
+        void add_(const Task &task);
+        void restart_(size_t index, uint32_t lateMs);
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "ResponseSegments.hpp"
+
+
+// pre-serialized JSON document, shared between the cache and all responses still sending it
+// (stored in small chunks, so it does not need one large contiguous block of heap)
+struct CachedJson {
+    std::vector<String> chunks;
+    size_t length = 0;
+    String etag;
+};
+
+// serves a cached JSON document without copying it and answers conditional requests with 304
+class CachedJsonHandler : public AsyncWebHandler {
+    public:
+        CachedJsonHandler(const char* url, std::function<std::shared_ptr<const CachedJson>()> getFunc)
+            : url_(url)
+            , getFunc_(getFunc)
+        {
+        }
+
+        bool canHandle(AsyncWebServerRequest *request) {
+            bool result = request->method() == HTTP_GET && request->url() == url_;
+            if (result) {
+                // ESPAsyncWebServer drops all headers not asked for
+                request->addInterestingHeader("If-None-Match");
+            }
+            return result;
+        }
+
+        void handleRequest(AsyncWebServerRequest *request) {
+            std::shared_ptr<const CachedJson> cached = getFunc_();
+            if (!cached) {
+                request->send(500);
+                return;
+            }
+
+            AsyncWebServerResponse *response;
+            if (request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf(cached->etag) >= 0) {
+                response = request->beginResponse(304);
+            } else {
+                // the document stays alive along with the response, even if the cache gets invalidated meanwhile
+                std::shared_ptr<ResponseSegments> segments = std::make_shared<ResponseSegments>();
+                segments->Keep(cached);
+                for (const String &chunk : cached->chunks)
+                    segments->Add(chunk);
+                response = ResponseSegments::BeginResponse(request, "application/json", segments);
+            }
+            response->addHeader("ETag", cached->etag);
+            response->addHeader("Cache-Control", "no-cache");
+            request->send(response);
+        }
+
+    private:
+        String url_;
+        std::function<std::shared_ptr<const CachedJson>()> getFunc_;
+};
@@ -0,0 +1,165 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "CaptiveDnsServer.hpp"
+#include <esp_timer.h>
+#include <lwip/sockets.h>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseDns";
+
+    const constexpr uint32_t kAnswerTtl = 60;
+
+    const constexpr uint16_t kFlagResponse = 0x8000;
+    const constexpr uint16_t kFlagOpcodeMask = 0x7800;
+    const constexpr uint16_t kFlagAuthoritative = 0x0400;
+    const constexpr uint16_t kFlagRecursionDesired = 0x0100;
+    const constexpr uint16_t kFlagRecursionAvailable = 0x0080;
+
+    const constexpr uint16_t kTypeA = 1;
+    const constexpr uint16_t kTypeAny = 255;
+    const constexpr uint16_t kClassIn = 1;
+
+    uint16_t readUint16(const uint8_t* buffer)
+    {
+        return (buffer[0] << 8) | buffer[1];
+    }
+
+    void writeUint16(uint8_t* buffer, uint16_t value)
+    {
+        buffer[0] = value >> 8;
+        buffer[1] = value & 0xff;
+    }
+}
+
+bool CaptiveDnsServer::Begin(IPAddress ipAddress, uint16_t port)
+{
+    // name pointer to offset 12 (the query name), type A, class IN, TTL, 4 bytes of data
+    uint8_t* answer = answerTemplate_;
+    writeUint16(answer, 0xc000 | kHeaderSize);
+    writeUint16(answer + 2, kTypeA);
+    writeUint16(answer + 4, kClassIn);
+    writeUint16(answer + 6, kAnswerTtl >> 16);
+    writeUint16(answer + 8, kAnswerTtl & 0xffff);
+    writeUint16(answer + 10, 4);
+    for (int i = 0; i < 4; i++)
+        answer[12 + i] = ipAddress[i];
+
+    if ((socket_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) < 0) {
+        ESP_LOGE(kLoggingTag, "Error creating socket: %d", errno);
+        return false;
+    }
+
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(socket_, (struct sockaddr*) &address, sizeof(address)) < 0) {
+        ESP_LOGE(kLoggingTag, "Error binding socket to port %u: %d", port, errno);
+        close(socket_);
+        socket_ = -1;
+        return false;
+    }
+
+    xTaskCreatePinnedToCore(&task_, "IotBaseDns", 3072, (void*) this, 5, NULL, CONFIG_ARDUINO_RUNNING_CORE);
+
+    ESP_LOGI(kLoggingTag, "Answering all DNS queries on port %u with %s", port, ipAddress.toString().c_str());
+    return true;
+}
+
+CaptiveDnsServer::Statistics CaptiveDnsServer::GetStatistics() const
+{
+    portENTER_CRITICAL(&mux_);
+    Statistics statistics = statistics_;
+    portEXIT_CRITICAL(&mux_);
+    return statistics;
+}
+
+void CaptiveDnsServer::task_(void* dnsServerPointer)
+{
+    CaptiveDnsServer* dnsServer = (CaptiveDnsServer*) dnsServerPointer;
+    uint8_t message[kMaxMessageSize];
+
+    while (1) {
+        struct sockaddr_in clientAddress;
+        socklen_t clientAddressLength = sizeof(clientAddress);
+        // blocks until a datagram arrives
+        int length = recvfrom(dnsServer->socket_, message, sizeof(message), 0, (struct sockaddr*) &clientAddress, &clientAddressLength);
+        if (length < 0) {
+            ESP_LOGW(kLoggingTag, "Error receiving: %d", errno);
+            vTaskDelay(pdMS_TO_TICKS(100));
+            continue;
+        }
+
+        int64_t receivedUs = esp_timer_get_time();
+        Statistics &statistics = dnsServer->statistics_;
+
+        size_t responseLength = dnsServer->buildResponse_(message, length);
+        if (responseLength == 0) {
+            portENTER_CRITICAL(&dnsServer->mux_);
+            statistics.queries++;
+            statistics.ignored++;
+            portEXIT_CRITICAL(&dnsServer->mux_);
+            continue;
+        }
+
+        sendto(dnsServer->socket_, message, responseLength, 0, (struct sockaddr*) &clientAddress, clientAddressLength);
+
+        uint32_t latencyUs = esp_timer_get_time() - receivedUs;
+        portENTER_CRITICAL(&dnsServer->mux_);
+        statistics.queries++;
+        statistics.answered++;
+        statistics.totalUs += latencyUs;
+        if (latencyUs < statistics.minUs)
+            statistics.minUs = latencyUs;
+        if (latencyUs > statistics.maxUs)
+            statistics.maxUs = latencyUs;
+        portEXIT_CRITICAL(&dnsServer->mux_);
+        ESP_LOGV(kLoggingTag, "Answered query from %s in %u us", inet_ntoa(clientAddress.sin_addr), latencyUs);
+    }
+}
+
+// turns the query in message into the response in place, returns its length (0 if the query is to be ignored)
+size_t CaptiveDnsServer::buildResponse_(uint8_t* message, size_t length)
+{
+    if (length < kHeaderSize)
+        return 0;
+
+    uint16_t flags = readUint16(message + 2);
+    // only standard queries with a single question
+    if ((flags & (kFlagResponse | kFlagOpcodeMask)) != 0 || readUint16(message + 4) != 1)
+        return 0;
+
+    // skip query name (queries do not use compression)
+    size_t position = kHeaderSize;
+    while (position < length && message[position] != 0) {
+        if ((message[position] & 0xc0) != 0)
+            return 0;
+        position += message[position] + 1;
+    }
+    // terminating zero, type and class
+    position += 1 + 4;
+    if (position > length || position + kAnswerSize > kMaxMessageSize)
+        return 0;
+
+    uint16_t type = readUint16(message + position - 4);
+    uint16_t cls = readUint16(message + position - 2);
+    bool answer = (type == kTypeA || type == kTypeAny) && cls == kClassIn;
+
+    writeUint16(message + 2, kFlagResponse | kFlagAuthoritative | (flags & kFlagRecursionDesired) | kFlagRecursionAvailable);
+    writeUint16(message + 6, answer ? 1 : 0);   // answers
+    writeUint16(message + 8, 0);                // authority records
+    writeUint16(message + 10, 0);               // additional records (drops EDNS)
+
+    // other types (e.g. AAAA) get an empty answer instead of a wrong one
+    if (answer) {
+        memcpy(message + position, answerTemplate_, kAnswerSize);
+        position += kAnswerSize;
+    }
+
+    return position;
+}
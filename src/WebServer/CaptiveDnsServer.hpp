@@ -0,0 +1,44 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <Esp32Logging.hpp>
+#include <IPAddress.h>
+
+
+// Wildcard DNS responder for the captive portal: answers every A query with our own IP address.
+// Its task blocks on the UDP socket, so queries get answered right away and nothing runs while idle.
+class CaptiveDnsServer {
+    public:
+        struct Statistics {
+            uint32_t queries;       ///< Datagrams received
+            uint32_t answered;      ///< Responses sent (including empty ones for non-A queries)
+            uint32_t ignored;       ///< Malformed or unsupported datagrams
+            uint32_t minUs;         ///< Processing latency from receive to send
+            uint32_t maxUs;
+            uint64_t totalUs;
+        };
+
+        bool Begin(IPAddress ipAddress, uint16_t port = 53);
+        Statistics GetStatistics() const;
+
+    private:
+        // DNS over UDP without EDNS is limited to 512 bytes
+        static const constexpr size_t kMaxMessageSize = 512;
+        static const constexpr size_t kHeaderSize = 12;
+        static const constexpr size_t kAnswerSize = 16;
+
+        int socket_ = -1;
+        // answer record pointing to the query name, prepared once in Begin()
+        uint8_t answerTemplate_[kAnswerSize];
+        // updated by the task and read by GetStatistics() (totalUs would tear otherwise), guarded by mux_
+        Statistics statistics_ = {0, 0, 0, UINT32_MAX, 0, 0};
+        mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+
+        static void task_(void* dnsServerPointer);
+        size_t buildResponse_(uint8_t* message, size_t length);
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+
+// Writes prefix, all elements (with separators in between) and suffix piece by piece into whatever buffer it gets,
+// e.g. directly into the TCP send buffer of a chunked response. Only a single rendered element is held in memory at a time.
+class ChunkedResponseWriter {
+    public:
+        // renders the element with the given index into output (empty on entry), returns false if there are no more elements
+        using ElementFunc = std::function<bool(size_t index, String &output)>;
+
+        ChunkedResponseWriter(const char* prefix, const char* separator, const char* suffix, ElementFunc elementFunc)
+            : prefix_(prefix)
+            , separator_(separator)
+            , suffix_(suffix)
+            , elementFunc_(elementFunc)
+        {
+        }
+
+        // fills the buffer as far as possible, returns 0 once everything has been written
+        size_t Read(uint8_t *buffer, size_t maxLen) {
+            size_t length = 0;
+            while (length < maxLen) {
+                if (!pendingLength_ && !nextPending_())
+                    break;
+                size_t chunkLength = std::min(maxLen - length, pendingLength_);
+                memcpy(buffer + length, pending_, chunkLength);
+                length += chunkLength;
+                pending_ += chunkLength;
+                pendingLength_ -= chunkLength;
+            }
+            return length;
+        }
+
+        static AsyncWebServerResponse* BeginResponse(AsyncWebServerRequest *request, const String &contentType, std::shared_ptr<ChunkedResponseWriter> writer) {
+            // the writer lives along with the response (i.e. the lambda)
+            return request->beginChunkedResponse(contentType, [writer](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return writer->Read(buffer, maxLen);
+            });
+        }
+
+    private:
+        enum class State {prefix, elements, suffix, done};
+
+        const char* prefix_;
+        const char* separator_;
+        const char* suffix_;
+        ElementFunc elementFunc_;
+
+        State state_ = State::prefix;
+        size_t index_ = 0;
+        String element_;
+        bool elementPending_ = false;
+        const char* pending_ = nullptr;
+        size_t pendingLength_ = 0;
+
+        bool nextPending_() {
+            switch (state_) {
+                case State::prefix:
+                    setPending_(prefix_, strlen(prefix_));
+                    state_ = State::elements;
+                    return true;
+
+                case State::elements:
+                    // separator has been written, now the element itself
+                    if (elementPending_) {
+                        elementPending_ = false;
+                        setPending_(element_.c_str(), element_.length());
+                        return true;
+                    }
+                    element_ = "";
+                    if (!elementFunc_(index_, element_)) {
+                        state_ = State::suffix;
+                        return nextPending_();
+                    }
+                    if (index_++ > 0) {
+                        elementPending_ = true;
+                        setPending_(separator_, strlen(separator_));
+                    } else {
+                        setPending_(element_.c_str(), element_.length());
+                    }
+                    return true;
+
+                case State::suffix:
+                    setPending_(suffix_, strlen(suffix_));
+                    state_ = State::done;
+                    return true;
+
+                default:
+                    return false;
+            }
+        }
+
+        void setPending_(const char* pending, size_t length) {
+            pending_ = pending;
+            pendingLength_ = length;
+        }
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
+#include <functional>
+#include "../Configuration.hpp"
+#include "ConfigUpdate.hpp"
+
+
+// GET /api/config                  {"key": "value", ...} for all keys
+// GET /api/config/{key}            {"key": "value"}
+// PATCH /api/config                {"key": "value", ...} (application/json)
+// PATCH /api/config/{key}          {"value": "value"} (application/json)
+// Updates are validated as a whole before anything gets written and only changed keys are written (and saved once).
+// The PATCH response tells whether all changes could be applied right away or whether a restart is required.
+// Secrets are write-only, they are reported as null.
+// PATCH requires HTTP authentication (user "admin", the OTA password, just like /update which it could otherwise be used to
+// open up), e.g. curl --digest -u admin:<password> -X PATCH -H "Content-Type: application/json" -d '{"DeviceName": "..."}' ...
+class ConfigApiHandler : public AsyncWebHandler {
+    public:
+        // passwordFunc: returns the password, updates are refused while it is empty
+        // applyFunc: applies a changed key at runtime, returns false if a restart is required for it to take effect
+        ConfigApiHandler(const char* url, Configuration &configuration, std::function<String()> passwordFunc,
+                         std::function<bool(const ConfigKey &key)> applyFunc)
+            : url_(url)
+            , configuration_(configuration)
+            , passwordFunc_(passwordFunc)
+            , applyFunc_(applyFunc)
+        {
+        }
+
+        bool canHandle(AsyncWebServerRequest *request) override {
+            bool result = (request->method() == HTTP_GET || request->method() == HTTP_PATCH)
+                          && (request->url() == url_ || request->url().startsWith(url_ + "/"));
+            if (result) {
+                // ESPAsyncWebServer drops all headers not asked for
+                request->addInterestingHeader("Authorization");
+            }
+            return result;
+        }
+
+        bool isRequestHandlerTrivial() override {
+            return false;
+        }
+
+        void handleBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) override {
+            if (total > kMaxBodyLength)
+                return;
+            // freed along with the request
+            if (index == 0)
+                request->_tempObject = malloc(total + 1);
+            if (request->_tempObject && index + len <= total) {
+                memcpy(static_cast<uint8_t*>(request->_tempObject) + index, data, len);
+                static_cast<char*>(request->_tempObject)[index + len] = 0;
+            }
+        }
+
+        void handleRequest(AsyncWebServerRequest *request) override {
+            String key = request->url().length() > url_.length() ? request->url().substring(url_.length() + 1) : String();
+            if (key.length() && !ConfigUpdate::IsKeyAccessible(key.c_str())) {
+                sendError_(request, 404, "unknown key");
+                return;
+            }
+
+            if (request->method() == HTTP_GET) {
+                sendValues_(request, key);
+                return;
+            }
+
+            if (!isAuthenticated_(request)) {
+                request->requestAuthentication(nullptr, true);
+                return;
+            }
+            if (request->contentLength() > kMaxBodyLength) {
+                sendError_(request, 413, "request too large");
+                return;
+            }
+            // parsed in place (the strings stay in the request's buffer), so the document only needs room for the members -
+            // and a valid request cannot have more than there are keys
+            DynamicJsonDocument body(JSON_OBJECT_SIZE(ConfigKey::_size()));
+            DeserializationError error = request->_tempObject ? deserializeJson(body, static_cast<char*>(request->_tempObject))
+                                         : DeserializationError(DeserializationError::InvalidInput);
+            if (error == DeserializationError::NoMemory) {
+                sendError_(request, 400, "too many keys");
+                return;
+            }
+            if (error || !body.is<JsonObject>()) {
+                sendError_(request, 400, "expecting a JSON object");
+                return;
+            }
+
+            // validate everything first, so a request is applied either completely or not at all
+            JsonObject updates = body.as<JsonObject>();
+            ConfigUpdate configUpdate;
+            if (key.length()) {
+                if (updates.size() != 1 || !updates["value"].is<const char*>()) {
+                    sendError_(request, 400, "expecting {\"value\": \"...\"}");
+                    return;
+                }
+                configUpdate.Add(key.c_str(), updates["value"].as<const char*>());
+            } else {
+                for (JsonPair update : updates) {
+                    if (!ConfigUpdate::IsKeyAccessible(update.key().c_str())) {
+                        sendError_(request, 404, "unknown key", update.key().c_str());
+                        return;
+                    }
+                    if (!update.value().is<const char*>()) {
+                        sendError_(request, 400, "values have to be strings", update.key().c_str());
+                        return;
+                    }
+                    configUpdate.Add(update.key().c_str(), update.value().as<const char*>());
+                }
+            }
+
+            ConfigUpdate::Result applied = configUpdate.Apply(configuration_, applyFunc_);
+            DynamicJsonDocument result(JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(applied.changed.size()));
+            JsonArray changed = result.createNestedArray("changed");
+            // key names are static strings, so they do not get copied
+            for (const char* changedKey : applied.changed)
+                changed.add(changedKey);
+            result["restartRequired"] = applied.restartRequired;
+
+            sendJson_(request, 200, result);
+        }
+
+    private:
+        static const constexpr size_t kMaxBodyLength = 1024;
+
+        String url_;
+        Configuration &configuration_;
+        std::function<String()> passwordFunc_;
+        std::function<bool(const ConfigKey &key)> applyFunc_;
+
+        bool isAuthenticated_(AsyncWebServerRequest *request) {
+            String password = passwordFunc_();
+            return !password.isEmpty() && request->authenticate("admin", password.c_str());
+        }
+
+        void sendValues_(AsyncWebServerRequest *request, const String &key) {
+            DynamicJsonDocument result(JSON_OBJECT_SIZE(ConfigKey::_size()) + 1536);
+            for (ConfigKey configKey : ConfigKey::_values()) {
+                const char* name = configKey._to_string();
+                if (!ConfigUpdate::IsKeyAccessible(name) || (key.length() && key != name))
+                    continue;
+                // String values get copied into the document
+                if (ConfigUpdate::IsSecret(configKey))
+                    result[name] = nullptr;
+                else
+                    result[name] = configuration_.Get(name);
+            }
+            sendJson_(request, 200, result);
+        }
+
+        static void sendError_(AsyncWebServerRequest *request, int code, const char* error, const char* key = nullptr) {
+            DynamicJsonDocument result(JSON_OBJECT_SIZE(2));
+            result["error"] = error;
+            if (key)
+                result["key"] = key;
+            sendJson_(request, code, result);
+        }
+
+        static void sendJson_(AsyncWebServerRequest *request, int code, const JsonDocument &document) {
+            String output;
+            serializeJson(document, output);
+            AsyncWebServerResponse *response = request->beginResponse(code, "application/json", output);
+            response->addHeader("Cache-Control", "no-store");
+            request->send(response);
+        }
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "../Configuration.hpp"
+
+
+// Changes to the configuration as requested through the config API (see ConfigApiHandler), applied either completely or
+// not at all: all of them get added (i.e. validated) first, nothing gets written before Apply().
+class ConfigUpdate {
+    public:
+        struct Result {
+            std::vector<const char*> changed;   ///< key names (static strings, see ConfigKey)
+            bool restartRequired = false;
+        };
+
+        static bool IsKeyAccessible(const char* key) {
+            // the reboot counter is for internal use only
+            return ConfigKey::_is_valid(key) && ConfigKey::_from_string(key) != +ConfigKey::QuickBootCount;
+        }
+
+        static bool IsSecret(const ConfigKey &key) {
+            return key == +ConfigKey::ApSecret || key == +ConfigKey::WifiPassword || key == +ConfigKey::MqttPassword || key == +ConfigKey::OtaPassword;
+        }
+
+        // returns false if the key is unknown or not accessible, value has to stay valid until Apply()
+        bool Add(const char* key, const char* value) {
+            if (!IsKeyAccessible(key))
+                return false;
+            changes_.push_back({ConfigKey::_from_string(key)._to_string(), value});
+            return true;
+        }
+
+        // Writes the keys whose value actually differs and saves once.
+        // applyFunc: applies a changed key at runtime, returns false if a restart is required for it to take effect
+        Result Apply(Configuration &configuration, const std::function<bool(const ConfigKey &key)> &applyFunc) const {
+            Result result;
+            result.changed.reserve(changes_.size());
+            for (const Change &change : changes_) {
+                if (configuration.Get(change.key) == change.value)
+                    continue;
+                configuration.Set(change.key, change.value);
+                result.changed.push_back(change.key);
+                if (!applyFunc || !applyFunc(ConfigKey::_from_string(change.key)))
+                    result.restartRequired = true;
+            }
+            if (result.changed.size())
+                configuration.Save();
+            return result;
+        }
+
+    private:
+        struct Change {
+            const char* key;
+            const char* value;
+        };
+
+        std::vector<Change> changes_;
+};
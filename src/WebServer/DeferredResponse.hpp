@@ -0,0 +1,60 @@
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+#include <functional>
+
+
+// Response that is only known once some background work has completed, without blocking the async_tcp task meanwhile:
+// readyFunc gets polled (whenever the connection gets polled, about every 500 ms) until it returns the actual response,
+// which then takes over.
+class DeferredResponse : public AsyncWebServerResponse {
+    public:
+        // returns nullptr while not ready yet, otherwise a response as created by request->beginResponse()
+        using ReadyFunc = std::function<AsyncWebServerResponse*(AsyncWebServerRequest *request)>;
+
+        explicit DeferredResponse(ReadyFunc readyFunc)
+            : readyFunc_(readyFunc)
+        {
+        }
+
+        ~DeferredResponse() override {
+            delete response_;
+        }
+
+        void _respond(AsyncWebServerRequest *request) override {
+            poll_(request);
+        }
+
+        size_t _ack(AsyncWebServerRequest *request, size_t len, uint32_t time) override {
+            if (response_)
+                return response_->_ack(request, len, time);
+            poll_(request);
+            return 0;
+        }
+
+        bool _started() const override {
+            return response_ && response_->_started();
+        }
+
+        bool _finished() const override {
+            return response_ && response_->_finished();
+        }
+
+        bool _failed() const override {
+            return response_ && response_->_failed();
+        }
+
+        bool _sourceValid() const override {
+            return true;
+        }
+
+    private:
+        ReadyFunc readyFunc_;
+        AsyncWebServerResponse* response_ = nullptr;
+
+        void poll_(AsyncWebServerRequest *request) {
+            response_ = readyFunc_(request);
+            if (response_)
+                response_->_respond(request);
+        }
+};
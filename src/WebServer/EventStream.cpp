@@ -0,0 +1,266 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "EventStream.hpp"
+#include <xtensa/corebits.h>
+#include <algorithm>
+#include <new>
+
+
+namespace {
+    const constexpr char* kLoggingTag = "IotBaseEvents";
+
+    // comment line sent to idle clients, keeps proxies from closing the connection and detects dead clients
+    const constexpr uint32_t kKeepAliveMs = 15000;
+    const constexpr size_t kMaxLogLineLength = 256;
+    const constexpr size_t kLogStagingSize = 2048;
+
+    // set while a task is forwarding log output, so anything logged on the way does not get forwarded again
+    thread_local bool tForwardingLog = false;
+
+    // not in an ISR, not with interrupts masked (i.e. within a critical section) and not with the scheduler suspended
+    bool mayBlock()
+    {
+        if (xPortInIsrContext() || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+            return false;
+        uint32_t ps;
+        __asm__ __volatile__("rsr.ps %0" : "=a"(ps));
+        return (ps & PS_INTLEVEL_MASK) == 0;
+    }
+}
+
+EventStream* EventStream::logInstance_ = nullptr;
+vprintf_like_t EventStream::previousLogFunc_ = nullptr;
+
+EventStream::EventStream(const char* url)
+    : url_(url)
+{
+}
+
+bool EventStream::canHandle(AsyncWebServerRequest *request)
+{
+    return request->method() == HTTP_GET && request->url() == url_;
+}
+
+void EventStream::handleRequest(AsyncWebServerRequest *request)
+{
+    // requests are all handled by the same (async_tcp) task, so the free slot cannot be taken meanwhile
+    size_t slot = 0;
+    portENTER_CRITICAL(&mux_);
+    while (slot < kMaxClients && !clients_[slot].expired())
+        slot++;
+    portEXIT_CRITICAL(&mux_);
+
+    std::shared_ptr<Client> client;
+    if (slot < kMaxClients) {
+        client = std::make_shared<Client>();
+        client->buffer.reset(new (std::nothrow) uint8_t[kClientBufferSize]);
+    }
+    if (!client || !client->buffer) {
+        ESP_LOGW(kLoggingTag, "Refusing event stream client, %u clients connected already or out of memory", GetClientCount());
+        request->send(503);
+        return;
+    }
+
+    // reconnect delay for the browser, also gets the response going right away
+    const char kHello[] = "retry: 5000\n\n";
+    enqueue_(*client, kHello, sizeof(kHello) - 1);
+
+    // the previous (expired) entry must not be released within the critical section
+    std::weak_ptr<Client> previous;
+    portENTER_CRITICAL(&mux_);
+    previous.swap(clients_[slot]);
+    clients_[slot] = client;
+    portEXIT_CRITICAL(&mux_);
+    ESP_LOGD(kLoggingTag, "Event stream client connected to slot %u", slot);
+
+    // the client lives along with the response (i.e. the lambda)
+    AsyncWebServerResponse *response = request->beginChunkedResponse("text/event-stream", [this, client](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+    {
+        if (logInstance_ == this)
+            sendStagedLog_();
+        size_t length = dequeue_(*client, buffer, maxLen);
+        if (length)
+            return length;
+
+        if (millis() - client->lastWriteMs > kKeepAliveMs && maxLen >= 3) {
+            memcpy(buffer, ":\n\n", 3);
+            client->lastWriteMs = millis();
+            return 3;
+        }
+        // gets called again on the next poll of the connection
+        return RESPONSE_TRY_AGAIN;
+    });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+bool EventStream::Send(const char* event, const char* data)
+{
+    if (!GetClientCount())
+        return true;
+
+    // one "data:" line per line of data, terminated by an empty line
+    String message;
+    message.reserve(strlen(event) + strlen(data) + 20);
+    message += "event: ";
+    message += event;
+    message += "\ndata: ";
+    for (const char* c = data; *c; c++) {
+        if (*c == '\r')
+            continue;
+        if (*c == '\n') {
+            if (c[1])
+                message += "\ndata: ";
+            continue;
+        }
+        message += *c;
+    }
+    message += "\n\n";
+
+    bool complete = true;
+    for (size_t slot = 0; slot < kMaxClients; slot++) {
+        std::shared_ptr<Client> client;
+        portENTER_CRITICAL(&mux_);
+        client = clients_[slot].lock();
+        portEXIT_CRITICAL(&mux_);
+
+        if (client && !enqueue_(*client, message.c_str(), message.length())) {
+            droppedEvents_++;
+            complete = false;
+        }
+    }
+    return complete;
+}
+
+size_t EventStream::GetClientCount() const
+{
+    size_t count = 0;
+    portENTER_CRITICAL(&mux_);
+    for (const auto &client : clients_) {
+        if (!client.expired())
+            count++;
+    }
+    portEXIT_CRITICAL(&mux_);
+    return count;
+}
+
+uint32_t EventStream::GetDroppedEvents() const
+{
+    return droppedEvents_;
+}
+
+void EventStream::ForwardLog()
+{
+    if (logInstance_)
+        return;
+    logLineMutex_ = xSemaphoreCreateMutex();
+    logLine_.reset(new (std::nothrow) char[kMaxLogLineLength]);
+    logStaging_.reset(new (std::nothrow) char[kLogStagingSize]);
+    if (!logLineMutex_ || !logLine_ || !logStaging_) {
+        ESP_LOGE(kLoggingTag, "Out of memory, cannot forward the log.");
+        return;
+    }
+    logInstance_ = this;
+    previousLogFunc_ = esp_log_set_vprintf(logFunc_);
+}
+
+// only whole events get queued, so a client never sees a partial one
+bool EventStream::enqueue_(Client &client, const char* message, size_t length)
+{
+    portENTER_CRITICAL(&mux_);
+    bool fits = kClientBufferSize - client.used >= length;
+    if (fits) {
+        size_t end = (client.start + client.used) % kClientBufferSize;
+        size_t firstLength = std::min(length, kClientBufferSize - end);
+        memcpy(client.buffer.get() + end, message, firstLength);
+        memcpy(client.buffer.get(), message + firstLength, length - firstLength);
+        client.used += length;
+    }
+    portEXIT_CRITICAL(&mux_);
+    return fits;
+}
+
+size_t EventStream::dequeue_(Client &client, uint8_t *buffer, size_t maxLen)
+{
+    portENTER_CRITICAL(&mux_);
+    size_t length = std::min(maxLen, client.used);
+    size_t firstLength = std::min(length, kClientBufferSize - client.start);
+    memcpy(buffer, client.buffer.get() + client.start, firstLength);
+    memcpy(buffer + firstLength, client.buffer.get(), length - firstLength);
+    client.start = (client.start + length) % kClientBufferSize;
+    client.used -= length;
+    portEXIT_CRITICAL(&mux_);
+
+    if (length)
+        client.lastWriteMs = millis();
+    return length;
+}
+
+int EventStream::logFunc_(const char* format, va_list args)
+{
+    // only worth formatting if anybody is listening
+    if (!tForwardingLog && mayBlock() && logInstance_->GetClientCount()) {
+        tForwardingLog = true;
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        logInstance_->stageLogLine_(format, argsCopy);
+        va_end(argsCopy);
+        tForwardingLog = false;
+    }
+    return previousLogFunc_ ? previousLogFunc_(format, args) : vprintf(format, args);
+}
+
+// runs on the logging task, which may be any task (with little stack left)
+void EventStream::stageLogLine_(const char* format, va_list args)
+{
+    // formatting may allocate (e.g. for floats), so it cannot happen within the critical section
+    if (xSemaphoreTake(logLineMutex_, pdMS_TO_TICKS(5)) != pdTRUE) {
+        droppedEvents_++;
+        return;
+    }
+    vsnprintf(logLine_.get(), kMaxLogLineLength, format, args);
+    size_t length = strlen(logLine_.get()) + 1;
+
+    portENTER_CRITICAL(&mux_);
+    bool fits = kLogStagingSize - logStagingUsed_ >= length;
+    if (fits) {
+        size_t end = (logStagingStart_ + logStagingUsed_) % kLogStagingSize;
+        size_t firstLength = std::min(length, kLogStagingSize - end);
+        memcpy(logStaging_.get() + end, logLine_.get(), firstLength);
+        memcpy(logStaging_.get(), logLine_.get() + firstLength, length - firstLength);
+        logStagingUsed_ += length;
+    }
+    portEXIT_CRITICAL(&mux_);
+    xSemaphoreGive(logLineMutex_);
+
+    if (!fits)
+        droppedEvents_++;
+}
+
+// runs on the async_tcp task, turns the staged lines into events for all clients
+void EventStream::sendStagedLog_()
+{
+    tForwardingLog = true;
+    char line[kMaxLogLineLength];
+    while (true) {
+        size_t length = 0;
+        portENTER_CRITICAL(&mux_);
+        while (logStagingUsed_) {
+            char c = logStaging_[logStagingStart_];
+            logStagingStart_ = (logStagingStart_ + 1) % kLogStagingSize;
+            logStagingUsed_--;
+            line[length++] = c;
+            if (!c)
+                break;
+        }
+        portEXIT_CRITICAL(&mux_);
+        if (!length)
+            break;
+        Send("log", line);
+    }
+    tForwardingLog = false;
+}
@@ -0,0 +1,66 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <Esp32Logging.hpp>
+#include <ESPAsyncWebServer.h>
+#include <atomic>
+#include <memory>
+
+
+// Server-Sent Events endpoint. Every client gets its own bounded buffer: producers never block (they may be called from any task)
+// and events that do not fit into the buffer of a slow client are dropped for that client only.
+class EventStream : public AsyncWebHandler {
+    public:
+        static const constexpr size_t kMaxClients = 4;
+        static const constexpr size_t kClientBufferSize = 2048;
+
+        explicit EventStream(const char* url);
+
+        bool canHandle(AsyncWebServerRequest *request) override;
+        void handleRequest(AsyncWebServerRequest *request) override;
+
+        // data may contain line breaks, returns false if the event had to be dropped for at least one client
+        bool Send(const char* event, const char* data);
+        size_t GetClientCount() const;
+        uint32_t GetDroppedEvents() const;
+
+        // Forwards all log output as "log" events (in addition to the previous log output). Lines are only staged by the logging
+        // task (no allocation, no waiting for clients) and turned into events on the async_tcp task. Output of ISRs, critical
+        // sections and lines that cannot be staged right away are not forwarded.
+        void ForwardLog();
+
+    private:
+        struct Client {
+            std::unique_ptr<uint8_t[]> buffer;
+            size_t start = 0;
+            size_t used = 0;
+            uint32_t lastWriteMs = 0;
+        };
+
+        String url_;
+        mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+        // the responses own the clients, so a slot becomes free as soon as the connection is gone
+        std::weak_ptr<Client> clients_[kMaxClients];
+        std::atomic<uint32_t> droppedEvents_{0};
+
+        static EventStream* logInstance_;
+        static vprintf_like_t previousLogFunc_;
+        // the line being formatted, shared by all tasks
+        SemaphoreHandle_t logLineMutex_ = 0;
+        std::unique_ptr<char[]> logLine_;
+        // zero terminated lines waiting to be sent (guarded by mux_)
+        std::unique_ptr<char[]> logStaging_;
+        size_t logStagingStart_ = 0;
+        size_t logStagingUsed_ = 0;
+
+        bool enqueue_(Client &client, const char* message, size_t length);
+        size_t dequeue_(Client &client, uint8_t *buffer, size_t maxLen);
+        static int logFunc_(const char* format, va_list args);
+        void stageLogLine_(const char* format, va_list args);
+        void sendStagedLog_();
+};
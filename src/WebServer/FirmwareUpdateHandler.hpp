@@ -0,0 +1,273 @@
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+#include <esp_timer.h>
+#include <functional>
+#include <new>
+#include "../FirmwareDelta.hpp"
+#include "../FirmwareUpdater.hpp"
+#include "../GzipInflater.hpp"
+#include "DeferredResponse.hpp"
+
+
+// POST /update with the firmware image either as raw body (Content-Type: application/octet-stream) or as multipart form upload.
+// Requires HTTP authentication (user "admin", the OTA password), optionally checks the SHA-256 given as
+// X-Firmware-SHA256 header or sha256 parameter (hex).
+// Instead of the image, a patch against the running firmware (see FirmwareDelta) may be uploaded the same way.
+// Both may be gzip compressed (e.g. gzip -9 firmware.bin), they get decompressed on the fly (see GzipInflater).
+// e.g. curl --digest -u admin:<password> -H "Content-Type: application/octet-stream" --data-binary @firmware.bin http://<device>/update
+class FirmwareUpdateHandler : public AsyncWebHandler {
+    public:
+        // passwordFunc: returns the password, updates are refused while it is empty
+        // restartFunc: called after a successful update (may be nullptr)
+        FirmwareUpdateHandler(const char* url, std::function<String()> passwordFunc, std::function<void()> restartFunc,
+                              std::function<void(size_t written, size_t total)> progressFunc = nullptr)
+            : url_(url)
+            , passwordFunc_(passwordFunc)
+            , restartFunc_(restartFunc)
+            , progressFunc_(progressFunc)
+            , delta_(updater_)
+        {
+        }
+
+        bool canHandle(AsyncWebServerRequest *request) override {
+            bool result = request->method() == HTTP_POST && request->url() == url_;
+            if (result) {
+                // ESPAsyncWebServer drops all headers not asked for
+                request->addInterestingHeader("Authorization");
+                request->addInterestingHeader("X-Firmware-SHA256");
+            }
+            return result;
+        }
+
+        bool isRequestHandlerTrivial() override {
+            return false;
+        }
+
+        void handleBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) override {
+            receive_(request, index, data, len, total);
+        }
+
+        void handleUpload(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final) override {
+            // the size of the file itself is unknown
+            receive_(request, index, data, len, 0);
+        }
+
+        void handleRequest(AsyncWebServerRequest *request) override {
+            Upload* upload = static_cast<Upload*>(request->_tempObject);
+            if (!upload) {
+                // no body at all, e.g. the unauthenticated first attempt of a digest authentication
+                if (!isAuthenticated_(request)) {
+                    request->requestAuthentication(nullptr, true);
+                    return;
+                }
+                request->send(400, "text/plain", "No firmware image.");
+                return;
+            }
+            if (upload->status == 401) {
+                request->requestAuthentication(nullptr, true);
+                return;
+            }
+            if (upload->status) {
+                request->send(upload->status, "text/plain", upload->message);
+                return;
+            }
+
+            bool incompleteInput = (upload->compressed && !inflater_.IsComplete()) || (upload->delta && !delta_.IsComplete());
+            abort_(!incompleteInput && upload->started);
+            if (incompleteInput || !upload->started) {
+                request->send(400, "text/plain", upload->started ? "Incomplete upload." : "No firmware image.");
+                return;
+            }
+
+            // hashing and verifying the whole image takes a while, the async_tcp task must not wait for that
+            updater_.End();
+            Upload stats = *upload;
+            request->send(new DeferredResponse([this, stats](AsyncWebServerRequest *request) -> AsyncWebServerResponse* {
+                if (!updater_.Poll())
+                    return nullptr;
+                if (updater_.GetError() != ESP_OK)
+                    return request->beginResponse(500, "text/plain", String("Update failed: ") + esp_err_to_name(updater_.GetError()));
+
+                String sha256;
+                for (size_t i = 0; i < FirmwareUpdater::kSha256Length; i++) {
+                    char hex[3];
+                    snprintf(hex, sizeof(hex), "%02x", updater_.GetSha256()[i]);
+                    sha256 += hex;
+                }
+                // the time spent decompressing tells whether compression pays off compared to the transfer time saved
+                int64_t duration = esp_timer_get_time() - stats.startTime;
+                int64_t inflateTime = stats.compressed ? stats.inflateTime - stats.writeTime : 0;
+                AsyncWebServerResponse* response = request->beginResponse(200, "application/json", String("{\"size\":")
+                    + updater_.GetWritten() + ",\"sha256\":\"" + sha256 + "\"" + ",\"received\":" + stats.received
+                    + ",\"durationMs\":" + static_cast<uint32_t>(duration / 1000) + ",\"inflateMs\":" + static_cast<uint32_t>(inflateTime / 1000) + "}");
+                if (restartFunc_)
+                    restartFunc_();
+                return response;
+            }));
+        }
+
+    private:
+        // per request state, kept in AsyncWebServerRequest::_tempObject (which gets free()d along with the request)
+        struct Upload {
+            int status;             ///< 0 while fine, HTTP status code otherwise
+            const char* message;
+            size_t total;           ///< as received, 0 if unknown
+            bool checkSha256;
+            uint8_t sha256[FirmwareUpdater::kSha256Length];
+            bool compressed;        ///< gzip
+            bool started;           ///< the first (decompressed) data has been passed on
+            bool delta;             ///< a patch rather than the image itself
+            size_t received;
+            int64_t startTime;
+            int64_t inflateTime;    ///< including writeTime while compressed
+            int64_t writeTime;
+        };
+
+        String url_;
+        std::function<String()> passwordFunc_;
+        std::function<void()> restartFunc_;
+        std::function<void(size_t written, size_t total)> progressFunc_;
+        FirmwareUpdater updater_;
+        FirmwareDelta delta_;
+        GzipInflater inflater_;
+        AsyncWebServerRequest* uploadRequest_ = nullptr;    ///< the one the updater is running for
+
+        bool isAuthenticated_(AsyncWebServerRequest *request) {
+            String password = passwordFunc_();
+            return !password.isEmpty() && request->authenticate("admin", password.c_str());
+        }
+
+        void receive_(AsyncWebServerRequest *request, size_t index, const uint8_t *data, size_t len, size_t total) {
+            if (index == 0 && !request->_tempObject)
+                begin_(request, total, GzipInflater::IsGzip(data, len));
+
+            Upload* upload = static_cast<Upload*>(request->_tempObject);
+            if (!upload || upload->status)
+                return;
+            upload->received += len;
+
+            bool written;
+            if (upload->compressed) {
+                int64_t startTime = esp_timer_get_time();
+                written = inflater_.Write(data, len);
+                upload->inflateTime += esp_timer_get_time() - startTime;
+            } else {
+                written = write_(upload, data, len);
+            }
+            if (!written) {
+                // the upload itself may be broken as well
+                if (!upload->status) {
+                    const char* error = upload->compressed && inflater_.GetError() ? inflater_.GetError()
+                                        : upload->delta ? delta_.GetError() : nullptr;
+                    upload->status = error ? 400 : 500;
+                    upload->message = error ? error : "Writing the firmware failed.";
+                }
+                abort_(false);
+            }
+        }
+
+        void begin_(AsyncWebServerRequest *request, size_t total, bool compressed) {
+            Upload* upload = static_cast<Upload*>(malloc(sizeof(Upload)));
+            request->_tempObject = upload;
+            if (!upload)
+                return;
+            *upload = {};
+
+            if (passwordFunc_().isEmpty()) {
+                *upload = { 403, "Updates are disabled (OTA inactive or no OTA password set)." };
+                return;
+            }
+            if (!isAuthenticated_(request)) {
+                *upload = { 401, nullptr };
+                return;
+            }
+            // also cleans up after an update whose client has gone while it was being verified
+            if (!updater_.Poll() || uploadRequest_) {
+                *upload = { 409, "Another update is running." };
+                return;
+            }
+
+            String expectedSha256Hex = request->hasHeader("X-Firmware-SHA256") ? request->header("X-Firmware-SHA256")
+                                       : request->hasParam("sha256") ? request->getParam("sha256")->value() : String();
+            if (!expectedSha256Hex.isEmpty() && !parseSha256_(expectedSha256Hex, upload->sha256)) {
+                *upload = { 400, "Invalid SHA-256." };
+                return;
+            }
+            upload->checkSha256 = !expectedSha256Hex.isEmpty();
+            // the size of the decompressed image is unknown
+            upload->total = compressed ? 0 : total;
+            upload->compressed = compressed;
+            upload->startTime = esp_timer_get_time();
+
+            // whether it is an image or a patch is only known from the (decompressed) data, see write_()
+            if (compressed && !inflater_.Begin([this, upload](const uint8_t* data, size_t length) { return write_(upload, data, length); })) {
+                *upload = { 500, "Out of memory." };
+                return;
+            }
+
+            // the updater must not be left running if the connection breaks down
+            uploadRequest_ = request;
+            request->onDisconnect([this, request]()
+            {
+                    if (uploadRequest_ == request)
+                        abort_(false);
+            });
+        }
+
+        // image data or a patch, starts the update with the first data
+        bool write_(Upload* upload, const uint8_t* data, size_t length) {
+            if (!upload->started) {
+                upload->started = true;
+                upload->delta = FirmwareDelta::IsDelta(data, length);
+                if (!start_(upload)) {
+                    upload->status = 500;
+                    upload->message = "Could not start the update.";
+                    return false;
+                }
+            }
+
+            int64_t startTime = esp_timer_get_time();
+            bool result = upload->delta ? delta_.Write(data, length) : updater_.Write(data, length);
+            upload->writeTime += esp_timer_get_time() - startTime;
+            return result;
+        }
+
+        bool start_(Upload* upload) {
+            const uint8_t* expectedSha256 = upload->checkSha256 ? upload->sha256 : nullptr;
+            std::function<void(size_t written, size_t total)> progressFunc = progressFunc_;
+            std::function<void(size_t written)> updaterProgressFunc = nullptr;
+            if (upload->delta) {
+                // the image size is only known from the patch header, the updater gets started from there
+                if (progressFunc)
+                    updaterProgressFunc = [this, progressFunc](size_t written) { progressFunc(written, delta_.GetImageSize()); };
+                delta_.Reset(expectedSha256, updaterProgressFunc);
+                return true;
+            }
+            size_t total = upload->total;
+            if (progressFunc)
+                updaterProgressFunc = [progressFunc, total](size_t written) { progressFunc(written, total); };
+            return updater_.Begin(total, expectedSha256, updaterProgressFunc);
+        }
+
+        // keepUpdater: the updater is still to be ended (successfully)
+        void abort_(bool keepUpdater) {
+            uploadRequest_ = nullptr;
+            inflater_.End();
+            if (!keepUpdater)
+                updater_.Abort();
+        }
+
+        static bool parseSha256_(const String &hex, uint8_t* sha256) {
+            if (hex.length() != 2 * FirmwareUpdater::kSha256Length)
+                return false;
+            for (size_t i = 0; i < FirmwareUpdater::kSha256Length; i++) {
+                char byteHex[3] = { hex[2 * i], hex[2 * i + 1], 0 };
+                char* end;
+                sha256[i] = strtoul(byteHex, &end, 16);
+                if (*end)
+                    return false;
+            }
+            return true;
+        }
+};
@@ -0,0 +1,40 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Entry of the asset table generated by data2header.sh (see InternalGzippedFilesContent.hpp)
+struct InternalFile {
+    const char* path;
+    const char* contentType;
+    size_t length;                  ///< Uncompressed
+    const char* hash;
+    const uint8_t* gzipContent;
+    size_t gzipLength;
+    const uint8_t* brotliContent;   ///< nullptr if brotli does not beat gzip for this file
+    size_t brotliLength;
+};
+
+// Page generated by "data2header.sh --bundle" (CSS and JS inlined), the server inserts the current data.json between prefix and suffix
+struct InternalBundledPage {
+    const char* path;
+    const uint8_t* gzipPrefix;      ///< gzip header + deflate blocks, sync flushed and not final
+    size_t gzipPrefixLength;
+    size_t prefixLength;            ///< Uncompressed
+    uint32_t prefixCrc;             ///< CRC-32 of the uncompressed prefix
+    const uint8_t* suffix;          ///< Uncompressed
+    size_t suffixLength;
+};
+
+// FNV-1a, usable at compile time (C++11 constexpr) as well as at runtime
+constexpr uint32_t InternalFilesHash(const char* str, uint32_t hash = 2166136261u)
+{
+    return *str ? InternalFilesHash(str + 1, (hash ^ static_cast<uint8_t>(*str)) * 16777619u) : hash;
+}
@@ -6,241 +6,581 @@
    */
 
 #include <pgmspace.h>
+#include "InternalFiles.hpp"
 //
-// converted data/* to gzipped flash variables
+// converted data/* to gzipped (and brotli compressed, if smaller) flash variables
 //
 
 
-static const size_t k_esp32iotbase_css_gz_len = 636;
+static const size_t k_esp32iotbase_css_len = 1429;
+static const char k_esp32iotbase_css_hash[] = "718cabe3530510b8";
+static const size_t k_esp32iotbase_css_gz_len = 619;
 static const uint8_t k_esp32iotbase_css_gz[] = {
-  0x1f, 0x8b, 0x08, 0x08, 0xe7, 0x87, 0x99, 0x5e, 0x00, 0x03, 0x65, 0x73,
-  0x70, 0x33, 0x32, 0x69, 0x6f, 0x74, 0x62, 0x61, 0x73, 0x65, 0x2e, 0x63,
-  0x73, 0x73, 0x00, 0xbd, 0x54, 0xcb, 0x8e, 0x9b, 0x30, 0x14, 0xfd, 0x15,
-  0x24, 0x34, 0x52, 0xa8, 0x00, 0x19, 0x32, 0x99, 0x87, 0x51, 0xab, 0x76,
-  0x53, 0x75, 0xdd, 0x6d, 0x35, 0x0b, 0x1b, 0x0c, 0x58, 0xe3, 0x07, 0xb2,
-  0x4d, 0x48, 0x8a, 0xf8, 0xf7, 0xda, 0x18, 0x32, 0x61, 0x32, 0xaa, 0xd4,
-  0x4d, 0x15, 0xd9, 0x22, 0xf7, 0x5c, 0xfb, 0x1e, 0x9f, 0xfb, 0x68, 0x0d,
-  0x67, 0x63, 0x2d, 0x85, 0x49, 0x6a, 0xc4, 0x29, 0x3b, 0xc3, 0x9f, 0x12,
-  0x4b, 0x23, 0xe3, 0x1f, 0x84, 0x1d, 0x89, 0xa1, 0x25, 0x8a, 0xbf, 0x29,
-  0x8a, 0x58, 0xac, 0x91, 0xd0, 0x89, 0x26, 0x8a, 0xd6, 0x05, 0xa3, 0x82,
-  0x24, 0x2d, 0xa1, 0x4d, 0x6b, 0x60, 0x96, 0x1e, 0xa6, 0xaf, 0x9c, 0x54,
-  0x14, 0xed, 0x38, 0x15, 0x49, 0x45, 0x8e, 0xb4, 0x24, 0xc9, 0x40, 0x2b,
-  0xd3, 0xc2, 0x7b, 0x00, 0xba, 0x53, 0x34, 0x86, 0x83, 0x42, 0x5d, 0x47,
-  0x54, 0x5c, 0x4b, 0x69, 0x88, 0x1a, 0x3d, 0xf8, 0x04, 0xee, 0x0a, 0x8e,
-  0x4e, 0x8b, 0x6b, 0x06, 0x9c, 0xaf, 0x35, 0xa8, 0x86, 0x0a, 0x08, 0x02,
-  0xd4, 0x1b, 0x39, 0x4d, 0x6d, 0xe6, 0x99, 0x0d, 0x3e, 0xd6, 0x1e, 0x80,
-  0x6d, 0xec, 0x0c, 0xdc, 0x4d, 0x6d, 0x1e, 0xb7, 0xfb, 0xb8, 0xbd, 0xdf,
-  0x78, 0x0a, 0xa9, 0x38, 0x62, 0xb7, 0xce, 0xdd, 0xca, 0xa1, 0x94, 0x4c,
-  0x2a, 0xa8, 0x1a, 0x8c, 0x76, 0x20, 0x9e, 0x7f, 0xe9, 0x63, 0x16, 0x4d,
-  0x0c, 0x61, 0xc2, 0xc6, 0x8a, 0xea, 0x8e, 0xa1, 0x33, 0xc4, 0x4c, 0x96,
-  0xaf, 0xd3, 0x72, 0x62, 0xbe, 0x5e, 0xd3, 0xdf, 0x04, 0xa6, 0x4f, 0x84,
-  0x4f, 0x54, 0x74, 0xbd, 0xf9, 0x65, 0xce, 0x1d, 0xf9, 0x6c, 0xc8, 0xc9,
-  0xbc, 0xc4, 0x57, 0x86, 0x0e, 0x69, 0x3d, 0x48, 0x55, 0x6d, 0x8c, 0xa2,
-  0xe7, 0x98, 0xa8, 0xc5, 0x64, 0x09, 0x9a, 0xdd, 0x6c, 0x7f, 0x89, 0xb6,
-  0xe1, 0x16, 0x09, 0x12, 0x9b, 0x03, 0x23, 0x39, 0xcc, 0x08, 0x2f, 0x2e,
-  0x0a, 0xdd, 0x15, 0x58, 0x9e, 0x1c, 0x07, 0x2a, 0x1a, 0x88, 0x6d, 0x00,
-  0xa2, 0xac, 0xdf, 0xe9, 0x9a, 0x0b, 0xee, 0xed, 0x31, 0xb1, 0x09, 0xac,
-  0x7b, 0xcc, 0xa9, 0x25, 0xe8, 0xa1, 0x18, 0xa5, 0xfe, 0x63, 0xf4, 0x17,
-  0x40, 0x50, 0x2c, 0x37, 0x29, 0x54, 0xd1, 0x5e, 0xc3, 0xdc, 0xa6, 0x01,
-  0xa3, 0xf2, 0xb5, 0x51, 0xb2, 0x17, 0x15, 0x0c, 0xf3, 0x07, 0xf4, 0xf0,
-  0x8c, 0x0a, 0x2f, 0xd8, 0xd0, 0x52, 0x43, 0x8a, 0xb2, 0x57, 0xda, 0xfe,
-  0xe9, 0x24, 0x15, 0x56, 0x99, 0xe2, 0x4d, 0x99, 0x2c, 0xcd, 0x0f, 0x96,
-  0xf0, 0x46, 0xf6, 0xc3, 0x4a, 0xbb, 0x45, 0x95, 0x1c, 0xb6, 0x92, 0x67,
-  0xf7, 0x51, 0x00, 0x02, 0x1b, 0x71, 0x5e, 0x20, 0xde, 0x82, 0xb9, 0x03,
-  0x33, 0x0b, 0x1c, 0x6e, 0xc1, 0x19, 0xdb, 0x5b, 0xbb, 0xc3, 0x13, 0xc7,
-  0xf9, 0x9f, 0x4a, 0xf8, 0x03, 0xc9, 0x60, 0x2b, 0x8f, 0xb6, 0x46, 0x6f,
-  0x85, 0x5b, 0x80, 0x77, 0xf2, 0x79, 0xeb, 0xf8, 0xa6, 0x54, 0xe2, 0x15,
-  0x0a, 0x73, 0x8c, 0x31, 0xaa, 0xae, 0x9f, 0xec, 0x89, 0xba, 0x05, 0x82,
-  0xf7, 0xcf, 0x8f, 0xfd, 0x0b, 0x1f, 0x3f, 0x00, 0x73, 0x07, 0x5e, 0x9e,
-  0xe8, 0xb6, 0x77, 0x0a, 0x4c, 0xa9, 0x66, 0x94, 0x27, 0x3e, 0x7d, 0xe3,
-  0xa5, 0x1e, 0x5c, 0xdd, 0xac, 0x5d, 0xe5, 0x72, 0xb9, 0xb1, 0x6b, 0x73,
-  0x66, 0x04, 0x6a, 0xc9, 0x68, 0xb5, 0x22, 0x94, 0xa3, 0x86, 0x40, 0x97,
-  0x33, 0xa4, 0x92, 0xc6, 0x55, 0x01, 0x11, 0x66, 0x67, 0x64, 0xa0, 0x5c,
-  0x02, 0xbd, 0xec, 0xd9, 0x73, 0x1e, 0x5f, 0x56, 0xb4, 0x49, 0x45, 0x14,
-  0x05, 0x19, 0x98, 0xd2, 0x1a, 0x99, 0xbf, 0x31, 0xd9, 0xff, 0x3f, 0x26,
-  0x03, 0x52, 0xc2, 0x36, 0xc8, 0xd2, 0xe2, 0xe1, 0x77, 0x3b, 0x34, 0xae,
-  0x47, 0x03, 0x96, 0xac, 0x9a, 0xc2, 0x52, 0x8a, 0x9a, 0x36, 0xb5, 0x1d,
-  0x13, 0x97, 0xf6, 0xab, 0x19, 0xb1, 0x55, 0x64, 0xb7, 0xc4, 0xcd, 0x2b,
-  0xe8, 0xb6, 0x6b, 0xbf, 0x2f, 0x9f, 0x46, 0x07, 0xc2, 0x2c, 0x70, 0x9d,
-  0x38, 0x85, 0x1a, 0x1d, 0xc9, 0x7c, 0xde, 0xb7, 0x91, 0x35, 0xae, 0xad,
-  0x6b, 0x64, 0x37, 0xf7, 0xed, 0xec, 0xbe, 0x8c, 0xb2, 0x90, 0xc9, 0x46,
-  0x8e, 0x6b, 0x4f, 0x5c, 0x9a, 0xda, 0x61, 0xeb, 0xb1, 0xf9, 0x91, 0x70,
-  0xee, 0xa0, 0xe9, 0x0f, 0x1d, 0x82, 0x27, 0x7a, 0x95, 0x05, 0x00, 0x00
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x54,
+  0xcb, 0x8e, 0x9b, 0x30, 0x14, 0xfd, 0x15, 0x24, 0x34, 0x52, 0xa8, 0x00,
+  0x19, 0x32, 0x99, 0x87, 0x51, 0xab, 0x76, 0x53, 0x75, 0xdd, 0x6d, 0x35,
+  0x0b, 0x1b, 0x0c, 0x58, 0xe3, 0x07, 0xb2, 0x4d, 0x48, 0x8a, 0xf8, 0xf7,
+  0xda, 0x18, 0x32, 0x61, 0x32, 0xaa, 0xd4, 0x4d, 0x15, 0xd9, 0x22, 0xf7,
+  0x5c, 0xfb, 0x1e, 0x9f, 0xfb, 0x68, 0x0d, 0x67, 0x63, 0x2d, 0x85, 0x49,
+  0x6a, 0xc4, 0x29, 0x3b, 0xc3, 0x9f, 0x12, 0x4b, 0x23, 0xe3, 0x1f, 0x84,
+  0x1d, 0x89, 0xa1, 0x25, 0x8a, 0xbf, 0x29, 0x8a, 0x58, 0xac, 0x91, 0xd0,
+  0x89, 0x26, 0x8a, 0xd6, 0x05, 0xa3, 0x82, 0x24, 0x2d, 0xa1, 0x4d, 0x6b,
+  0x60, 0x96, 0x1e, 0xa6, 0xaf, 0x9c, 0x54, 0x14, 0xed, 0x38, 0x15, 0x49,
+  0x45, 0x8e, 0xb4, 0x24, 0xc9, 0x40, 0x2b, 0xd3, 0xc2, 0x7b, 0x00, 0xba,
+  0x53, 0x34, 0x86, 0x83, 0x42, 0x5d, 0x47, 0x54, 0x5c, 0x4b, 0x69, 0x88,
+  0x1a, 0x3d, 0xf8, 0x04, 0xee, 0x0a, 0x8e, 0x4e, 0x8b, 0x6b, 0x06, 0x9c,
+  0xaf, 0x35, 0xa8, 0x86, 0x0a, 0x08, 0x02, 0xd4, 0x1b, 0x39, 0x4d, 0x6d,
+  0xe6, 0x99, 0x0d, 0x3e, 0xd6, 0x1e, 0x80, 0x6d, 0xec, 0x0c, 0xdc, 0x4d,
+  0x6d, 0x1e, 0xb7, 0xfb, 0xb8, 0xbd, 0xdf, 0x78, 0x0a, 0xa9, 0x38, 0x62,
+  0xb7, 0xce, 0xdd, 0xca, 0xa1, 0x94, 0x4c, 0x2a, 0xa8, 0x1a, 0x8c, 0x76,
+  0x20, 0x9e, 0x7f, 0xe9, 0x63, 0x16, 0x4d, 0x0c, 0x61, 0xc2, 0xc6, 0x8a,
+  0xea, 0x8e, 0xa1, 0x33, 0xc4, 0x4c, 0x96, 0xaf, 0xd3, 0x72, 0x62, 0xbe,
+  0x5e, 0xd3, 0xdf, 0x04, 0xa6, 0x4f, 0x84, 0x4f, 0x54, 0x74, 0xbd, 0xf9,
+  0x65, 0xce, 0x1d, 0xf9, 0x6c, 0xc8, 0xc9, 0xbc, 0xc4, 0x57, 0x86, 0x0e,
+  0x69, 0x3d, 0x48, 0x55, 0x6d, 0x8c, 0xa2, 0xe7, 0x98, 0xa8, 0xc5, 0x64,
+  0x09, 0x9a, 0xdd, 0x6c, 0x7f, 0x89, 0xb6, 0xe1, 0x16, 0x09, 0x12, 0x9b,
+  0x03, 0x23, 0x39, 0xcc, 0x08, 0x2f, 0x2e, 0x0a, 0xdd, 0x15, 0x58, 0x9e,
+  0x1c, 0x07, 0x2a, 0x1a, 0x88, 0x6d, 0x00, 0xa2, 0xac, 0xdf, 0xe9, 0x9a,
+  0x0b, 0xee, 0xed, 0x31, 0xb1, 0x09, 0xac, 0x7b, 0xcc, 0xa9, 0x25, 0xe8,
+  0xa1, 0x18, 0xa5, 0xfe, 0x63, 0xf4, 0x17, 0x40, 0x50, 0x2c, 0x37, 0x29,
+  0x54, 0xd1, 0x5e, 0xc3, 0xdc, 0xa6, 0x01, 0xa3, 0xf2, 0xb5, 0x51, 0xb2,
+  0x17, 0x15, 0x0c, 0xf3, 0x07, 0xf4, 0xf0, 0x8c, 0x0a, 0x2f, 0xd8, 0xd0,
+  0x52, 0x43, 0x8a, 0xb2, 0x57, 0xda, 0xfe, 0xe9, 0x24, 0x15, 0x56, 0x99,
+  0xe2, 0x4d, 0x99, 0x2c, 0xcd, 0x0f, 0x96, 0xf0, 0x46, 0xf6, 0xc3, 0x4a,
+  0xbb, 0x45, 0x95, 0x1c, 0xb6, 0x92, 0x67, 0xf7, 0x51, 0x00, 0x02, 0x1b,
+  0x71, 0x5e, 0x20, 0xde, 0x82, 0xb9, 0x03, 0x33, 0x0b, 0x1c, 0x6e, 0xc1,
+  0x19, 0xdb, 0x5b, 0xbb, 0xc3, 0x13, 0xc7, 0xf9, 0x9f, 0x4a, 0xf8, 0x03,
+  0xc9, 0x60, 0x2b, 0x8f, 0xb6, 0x46, 0x6f, 0x85, 0x5b, 0x80, 0x77, 0xf2,
+  0x79, 0xeb, 0xf8, 0xa6, 0x54, 0xe2, 0x15, 0x0a, 0x73, 0x8c, 0x31, 0xaa,
+  0xae, 0x9f, 0xec, 0x89, 0xba, 0x05, 0x82, 0xf7, 0xcf, 0x8f, 0xfd, 0x0b,
+  0x1f, 0x3f, 0x00, 0x73, 0x07, 0x5e, 0x9e, 0xe8, 0xb6, 0x77, 0x0a, 0x4c,
+  0xa9, 0x66, 0x94, 0x27, 0x3e, 0x7d, 0xe3, 0xa5, 0x1e, 0x5c, 0xdd, 0xac,
+  0x5d, 0xe5, 0x72, 0xb9, 0xb1, 0x6b, 0x73, 0x66, 0x04, 0x6a, 0xc9, 0x68,
+  0xb5, 0x22, 0x94, 0xa3, 0x86, 0x40, 0x97, 0x33, 0xa4, 0x92, 0xc6, 0x55,
+  0x01, 0x11, 0x66, 0x67, 0x64, 0xa0, 0x5c, 0x02, 0xbd, 0xec, 0xd9, 0x73,
+  0x1e, 0x5f, 0x56, 0xb4, 0x49, 0x45, 0x14, 0x05, 0x19, 0x98, 0xd2, 0x1a,
+  0x99, 0xbf, 0x31, 0xd9, 0xff, 0x3f, 0x26, 0x03, 0x52, 0xc2, 0x36, 0xc8,
+  0xd2, 0xe2, 0xe1, 0x77, 0x3b, 0x34, 0xae, 0x47, 0x03, 0x96, 0xac, 0x9a,
+  0xc2, 0x52, 0x8a, 0x9a, 0x36, 0xb5, 0x1d, 0x13, 0x97, 0xf6, 0xab, 0x19,
+  0xb1, 0x55, 0x64, 0xb7, 0xc4, 0xcd, 0x2b, 0xe8, 0xb6, 0x6b, 0xbf, 0x2f,
+  0x9f, 0x46, 0x07, 0xc2, 0x2c, 0x70, 0x9d, 0x38, 0x85, 0x1a, 0x1d, 0xc9,
+  0x7c, 0xde, 0xb7, 0x91, 0x35, 0xae, 0xad, 0x6b, 0x64, 0x37, 0xf7, 0xed,
+  0xec, 0xbe, 0x8c, 0xb2, 0x90, 0xc9, 0x46, 0x8e, 0x6b, 0x4f, 0x5c, 0x9a,
+  0xda, 0x61, 0xeb, 0xb1, 0xf9, 0x91, 0x70, 0xee, 0xa0, 0xe9, 0x0f, 0x1d,
+  0x82, 0x27, 0x7a, 0x95, 0x05, 0x00, 0x00
 };
-static const size_t k_esp32iotbase_js_gz_len = 1026;
+static const size_t k_esp32iotbase_css_br_len = 491;
+static const uint8_t k_esp32iotbase_css_br[] = {
+  0x1b, 0x94, 0x05, 0x20, 0xe4, 0x6f, 0x3a, 0x7f, 0x5a, 0x6b, 0xf2, 0x12,
+  0x24, 0x0e, 0xfd, 0x26, 0xc3, 0xee, 0x44, 0xbd, 0xca, 0x71, 0x34, 0xb7,
+  0xba, 0x5f, 0xa6, 0x26, 0xa8, 0x89, 0xfd, 0xfd, 0xcc, 0x13, 0x92, 0xb5,
+  0x8e, 0x34, 0x73, 0x68, 0x8b, 0x88, 0x35, 0xa2, 0x68, 0x8f, 0x84, 0x46,
+  0xad, 0x38, 0x11, 0xe7, 0xb6, 0xab, 0xd7, 0x81, 0xe4, 0xe2, 0x0c, 0xcf,
+  0x35, 0x79, 0x0a, 0xbf, 0xee, 0xea, 0x87, 0x0d, 0x7c, 0x46, 0xe5, 0x29,
+  0x1a, 0xb3, 0x40, 0xc0, 0x53, 0x9f, 0x89, 0x12, 0x4a, 0x8f, 0x25, 0x9b,
+  0x11, 0xdd, 0x52, 0x8f, 0x79, 0x9d, 0x6d, 0xaa, 0xac, 0xd6, 0x32, 0x37,
+  0x99, 0x69, 0x64, 0xc3, 0xad, 0x9c, 0xb7, 0x5d, 0x06, 0x25, 0x11, 0x2b,
+  0x9c, 0x77, 0xf1, 0x92, 0x57, 0xe2, 0x12, 0x9b, 0x22, 0x11, 0x78, 0x4c,
+  0x86, 0x9f, 0x51, 0x39, 0x53, 0x2a, 0x25, 0x52, 0xc2, 0x2b, 0x0c, 0x8c,
+  0x8b, 0xff, 0x9a, 0xe0, 0xa5, 0x4a, 0x29, 0xa4, 0x06, 0xa4, 0xe6, 0x12,
+  0x5a, 0x9b, 0xb2, 0x50, 0xdb, 0x6a, 0x60, 0xdc, 0x5c, 0xac, 0x4f, 0x7c,
+  0xb1, 0xc1, 0x70, 0x30, 0xd3, 0x1d, 0xb2, 0x55, 0xf8, 0xd6, 0xa5, 0x64,
+  0x65, 0x95, 0x28, 0xaa, 0x84, 0x99, 0xee, 0x46, 0x95, 0x02, 0x57, 0xfa,
+  0xf2, 0x12, 0xcc, 0xb7, 0x2a, 0x54, 0xe1, 0x32, 0x96, 0x9b, 0xf8, 0xe5,
+  0x00, 0x3d, 0x99, 0xce, 0x58, 0xdd, 0x8c, 0x9b, 0x5d, 0xc3, 0xcf, 0xb6,
+  0xc4, 0x05, 0x9c, 0x9a, 0x43, 0x12, 0x55, 0xdc, 0xaa, 0x7b, 0x7e, 0x73,
+  0xa9, 0xc6, 0x89, 0xac, 0x4e, 0xd8, 0x37, 0xf9, 0xd7, 0x2e, 0xd5, 0x01,
+  0xd5, 0xc4, 0x67, 0xf0, 0x7f, 0x11, 0x64, 0x08, 0x1d, 0x80, 0xd0, 0x4f,
+  0x2b, 0xd2, 0x1d, 0xb4, 0x30, 0xff, 0xac, 0xf5, 0x22, 0xcc, 0x8e, 0x03,
+  0xa3, 0xf2, 0xf1, 0xb2, 0x39, 0xb5, 0x85, 0xed, 0x09, 0x8e, 0x19, 0x56,
+  0xcd, 0x22, 0x2e, 0x9b, 0xe8, 0x67, 0x7a, 0x9e, 0xa0, 0x56, 0x54, 0x21,
+  0xaf, 0x58, 0x35, 0x07, 0xfd, 0x26, 0xa0, 0xee, 0x26, 0xe6, 0x76, 0x82,
+  0x27, 0xb4, 0xbd, 0x1c, 0x35, 0x60, 0x08, 0xa7, 0x29, 0x22, 0x1d, 0x2c,
+  0x3c, 0x46, 0x06, 0x22, 0xa2, 0x56, 0xed, 0xe2, 0x54, 0x9c, 0x86, 0x1a,
+  0xb8, 0xdb, 0x34, 0xec, 0x20, 0x2c, 0x11, 0x41, 0xd8, 0x2e, 0x91, 0x66,
+  0x74, 0x81, 0xfa, 0xbe, 0x2f, 0xc2, 0x56, 0x43, 0x5d, 0x91, 0xd1, 0x88,
+  0x27, 0x08, 0x50, 0x80, 0x08, 0xed, 0xb4, 0x9d, 0x54, 0xa1, 0x95, 0x14,
+  0x59, 0x34, 0xd9, 0x39, 0x95, 0x3e, 0x94, 0x59, 0xa5, 0x31, 0xb8, 0x40,
+  0x3e, 0xb3, 0xc7, 0x1a, 0x56, 0x77, 0x1e, 0x0f, 0x02, 0x97, 0x26, 0x31,
+  0xf7, 0x49, 0x66, 0xe4, 0x8a, 0x85, 0x7c, 0x1b, 0x91, 0xa9, 0x25, 0x42,
+  0x70, 0x44, 0xf5, 0xb8, 0x19, 0x9b, 0xeb, 0x1e, 0x40, 0x7e, 0x44, 0x3c,
+  0x0a, 0x47, 0xf5, 0x2d, 0x1b, 0xfc, 0x76, 0x7c, 0x6f, 0x82, 0x95, 0x1e,
+  0x8b, 0xb1, 0x32, 0x7f, 0x62, 0x74, 0xc4, 0x29, 0x2b, 0x92, 0x92, 0x35,
+  0xef, 0x18, 0x3f, 0x0a, 0x62, 0xab, 0xb9, 0xaf, 0x67, 0x9c, 0x22, 0x67,
+  0x81, 0xd3, 0xb8, 0x8c, 0x2e, 0xfc, 0x58, 0xd4, 0x5c, 0x96, 0xc8, 0x8e,
+  0x63, 0x51, 0x7b, 0xf7, 0x3b, 0x19, 0x6e, 0x32, 0xf2, 0x1c, 0xae, 0xa9,
+  0xe6, 0x1e, 0x1e, 0x67, 0x01, 0x96, 0x74, 0x44, 0x30, 0xe6, 0x57, 0xe2,
+  0x56, 0x54, 0x65, 0xc7, 0x7a, 0x33, 0x71, 0xee, 0xcd, 0x15, 0x69, 0x16,
+  0x11, 0xbb, 0x66, 0x82, 0x13, 0xae, 0x5c, 0xb0, 0x11, 0x89, 0x0a
+};
+static const size_t k_esp32iotbase_js_len = 2482;
+static const char k_esp32iotbase_js_hash[] = "e6d5cd21e3c16fac";
+static const size_t k_esp32iotbase_js_gz_len = 1064;
 static const uint8_t k_esp32iotbase_js_gz[] = {
-  0x1f, 0x8b, 0x08, 0x08, 0xe7, 0x87, 0x99, 0x5e, 0x00, 0x03, 0x65, 0x73,
-  0x70, 0x33, 0x32, 0x69, 0x6f, 0x74, 0x62, 0x61, 0x73, 0x65, 0x2e, 0x6a,
-  0x73, 0x00, 0xa5, 0x56, 0x4d, 0x73, 0xdb, 0x36, 0x10, 0xfd, 0x2b, 0x08,
-  0x32, 0x93, 0x21, 0x2b, 0x9a, 0xb5, 0xeb, 0x9e, 0xc4, 0x32, 0x1d, 0xc7,
-  0x71, 0x1b, 0x77, 0x9c, 0x26, 0x13, 0xf9, 0xd0, 0x19, 0x8d, 0x0e, 0x20,
-  0xb0, 0x22, 0x69, 0xc3, 0x04, 0x0b, 0x80, 0x56, 0x35, 0x0a, 0xff, 0x7b,
-  0x16, 0x20, 0x29, 0x52, 0xb6, 0x74, 0xea, 0x45, 0x24, 0x17, 0x8b, 0xb7,
-  0x6f, 0xbf, 0xf5, 0x60, 0x54, 0xf5, 0x91, 0x59, 0x96, 0x52, 0x81, 0xbf,
-  0xf1, 0x03, 0x7e, 0xd2, 0x64, 0xdd, 0x54, 0xdc, 0x96, 0xaa, 0x22, 0x52,
-  0x31, 0x11, 0x84, 0x3b, 0xae, 0x2a, 0xa3, 0x24, 0xc4, 0x52, 0xe5, 0x01,
-  0xbd, 0x31, 0xf5, 0xe5, 0x2f, 0xb7, 0xca, 0x7e, 0x60, 0x06, 0xbc, 0x02,
-  0x08, 0x1a, 0x26, 0xcf, 0x4c, 0x93, 0x2c, 0xad, 0x60, 0x43, 0xfe, 0xf9,
-  0x7c, 0xf7, 0xc9, 0xda, 0xfa, 0x1b, 0xfc, 0xdb, 0x80, 0xb1, 0x41, 0x38,
-  0xa2, 0x71, 0x84, 0x72, 0x7a, 0x22, 0xfd, 0x6b, 0xf1, 0xe5, 0xef, 0xb8,
-  0x66, 0xda, 0x40, 0x60, 0x8b, 0xd2, 0xc4, 0x1a, 0x4c, 0x8d, 0x36, 0xe0,
-  0x1e, 0xfe, 0xb3, 0x61, 0x92, 0x35, 0xa5, 0x14, 0x8b, 0xd2, 0x42, 0x20,
-  0x62, 0x90, 0xf0, 0x04, 0x95, 0x35, 0x61, 0xbb, 0x87, 0x61, 0x81, 0x78,
-  0x41, 0xe9, 0x4e, 0xa9, 0x47, 0x43, 0x64, 0xf9, 0x08, 0xc4, 0x16, 0xa0,
-  0x81, 0x6c, 0x98, 0x21, 0x8c, 0xd4, 0x5a, 0x65, 0x78, 0x3d, 0x26, 0x0b,
-  0xcb, 0x6c, 0x63, 0xc8, 0xb5, 0x12, 0x30, 0x27, 0x74, 0x96, 0xc5, 0xc6,
-  0x0b, 0xc2, 0x84, 0x09, 0x71, 0xd3, 0x19, 0xb8, 0x57, 0x1f, 0xd5, 0x53,
-  0x40, 0x8b, 0x0b, 0x1a, 0x51, 0xd0, 0x5a, 0x69, 0x7c, 0x5e, 0xab, 0x46,
-  0x0a, 0x52, 0x29, 0xeb, 0xdd, 0x24, 0x68, 0x72, 0x5d, 0xe6, 0x8d, 0x66,
-  0x8e, 0xc5, 0x14, 0x27, 0xda, 0x19, 0xbb, 0x95, 0x30, 0xa7, 0x5c, 0x49,
-  0xa5, 0xe7, 0x1a, 0x03, 0xd2, 0x86, 0x89, 0x06, 0xdb, 0xe8, 0xaa, 0xcd,
-  0x62, 0x67, 0xe4, 0x19, 0x4d, 0xdc, 0x95, 0xc6, 0x42, 0x05, 0x3a, 0xa0,
-  0x0e, 0x8e, 0x46, 0x1c, 0x3d, 0x3d, 0x72, 0xd8, 0x5b, 0x67, 0xee, 0x54,
-  0xd5, 0x50, 0x05, 0xf4, 0xcf, 0x9b, 0x7b, 0x1a, 0x3d, 0xf4, 0x89, 0x72,
-  0x62, 0x03, 0x15, 0xa6, 0x65, 0x8c, 0xc8, 0xc0, 0x0c, 0x7a, 0x67, 0x02,
-  0x16, 0xee, 0xcc, 0xa6, 0xb4, 0xbc, 0x08, 0xd8, 0x10, 0x41, 0x0c, 0x19,
-  0x26, 0x8c, 0x96, 0x55, 0xdd, 0x58, 0x3a, 0x2f, 0xd7, 0x78, 0x82, 0xd7,
-  0xac, 0x3f, 0x91, 0x2c, 0x03, 0x79, 0x2b, 0x52, 0xea, 0x5f, 0xd6, 0x68,
-  0x7e, 0xc6, 0xe2, 0x52, 0x24, 0xfe, 0xf3, 0xca, 0x5a, 0x9d, 0xee, 0xa8,
-  0x93, 0xce, 0x9d, 0xb4, 0x7d, 0x1d, 0x35, 0xaf, 0x47, 0xa3, 0x1e, 0x26,
-  0xda, 0x23, 0x47, 0x7b, 0x00, 0x94, 0x61, 0xba, 0x9d, 0xb1, 0xd7, 0xb7,
-  0x3b, 0x4a, 0x91, 0xc3, 0x8e, 0xa8, 0x7b, 0x32, 0xbc, 0x50, 0x66, 0x8d,
-  0x05, 0x13, 0xd1, 0xb7, 0x74, 0xd6, 0xc3, 0x86, 0x2d, 0x48, 0x03, 0xbb,
-  0x97, 0xd7, 0xf7, 0x0e, 0x76, 0x00, 0xa3, 0xed, 0x03, 0x9c, 0xbd, 0xf9,
-  0x36, 0xd3, 0xc0, 0x1e, 0x13, 0x01, 0x6b, 0xd6, 0x48, 0x3b, 0xff, 0x9f,
-  0x68, 0x89, 0x47, 0x6b, 0x27, 0xb5, 0xf9, 0x02, 0x2f, 0x8b, 0x58, 0x04,
-  0x5d, 0xd5, 0xaf, 0x53, 0xa6, 0xf3, 0xc6, 0x17, 0x73, 0x2c, 0xa1, 0xca,
-  0x6d, 0xf1, 0xfe, 0xf2, 0xdd, 0xbb, 0xbd, 0x6c, 0x79, 0xb9, 0x7a, 0x93,
-  0xa6, 0x4d, 0x85, 0xcc, 0xca, 0x0a, 0xc4, 0xef, 0xd3, 0x83, 0xf9, 0xae,
-  0xf5, 0x0d, 0x96, 0x8f, 0x10, 0xcb, 0x5f, 0x57, 0x5e, 0xc4, 0x53, 0xa1,
-  0xb8, 0x17, 0xc5, 0x39, 0xd8, 0xde, 0xf6, 0x87, 0xed, 0xad, 0xc0, 0x1a,
-  0x48, 0x30, 0xcb, 0x6f, 0x38, 0x26, 0x7e, 0xd4, 0xe1, 0xc8, 0xd7, 0xee,
-  0xcb, 0x24, 0x0b, 0x5b, 0x54, 0x41, 0x7e, 0x3c, 0xb6, 0xd8, 0x79, 0xd7,
-  0x9d, 0xaf, 0x29, 0x38, 0x29, 0x73, 0x52, 0x03, 0xf6, 0x6a, 0x70, 0x1b,
-  0x13, 0x25, 0x5c, 0x59, 0xb6, 0x53, 0xa1, 0x09, 0x78, 0xb4, 0xee, 0xba,
-  0x5f, 0x8c, 0x56, 0xb0, 0xf3, 0xf5, 0x76, 0x81, 0x91, 0xe4, 0x56, 0xe9,
-  0x20, 0xef, 0x88, 0x60, 0xd3, 0x9e, 0x54, 0xa1, 0x6f, 0x37, 0x9a, 0xd5,
-  0x35, 0x68, 0x1a, 0xb6, 0x22, 0x76, 0x6f, 0x95, 0xb8, 0x2e, 0x70, 0x0a,
-  0x04, 0x7c, 0x52, 0xe6, 0x2f, 0x0d, 0x23, 0x45, 0xac, 0xca, 0xc0, 0x8f,
-  0x1e, 0x52, 0x62, 0xf0, 0xc3, 0x9d, 0x23, 0xbe, 0xcc, 0x56, 0xaf, 0xb8,
-  0x63, 0x1e, 0x9c, 0xb8, 0x9d, 0xa4, 0x6a, 0x9c, 0x32, 0xbc, 0x4b, 0x50,
-  0x96, 0x8e, 0x34, 0x92, 0xe9, 0x7c, 0xc1, 0x46, 0xdd, 0x20, 0x19, 0x54,
-  0x1c, 0x12, 0x77, 0x3e, 0x0c, 0xb2, 0xe5, 0x2a, 0x19, 0x28, 0xb0, 0xf4,
-  0x3c, 0x61, 0xbf, 0x0d, 0x2a, 0x09, 0x9b, 0xcd, 0x3c, 0x1d, 0xbe, 0x64,
-  0xab, 0xbe, 0x5c, 0xd2, 0x34, 0xc3, 0x18, 0xc4, 0x75, 0x63, 0x0a, 0x2f,
-  0x0e, 0x13, 0x64, 0x59, 0xcb, 0x92, 0x43, 0xc0, 0xa2, 0x8b, 0xb1, 0x98,
-  0x0e, 0x00, 0xc5, 0x01, 0xe0, 0xab, 0x4e, 0x17, 0x0e, 0xc7, 0xe5, 0x6b,
-  0xca, 0x2d, 0x4b, 0xf9, 0xf2, 0x7c, 0xb0, 0x3a, 0xf5, 0x19, 0x07, 0x94,
-  0x8b, 0xf8, 0xf5, 0x74, 0x92, 0xf5, 0x43, 0x99, 0xfb, 0xe1, 0xfd, 0x87,
-  0xd2, 0x4f, 0x6e, 0xca, 0xe0, 0xd8, 0x3e, 0x18, 0x77, 0xbd, 0x39, 0x33,
-  0x26, 0x30, 0x53, 0x62, 0x7b, 0x98, 0xc5, 0x2b, 0x29, 0x03, 0xfa, 0xd3,
-  0xd2, 0xed, 0x91, 0xb3, 0xee, 0xf2, 0x23, 0x6c, 0x57, 0xb8, 0x1b, 0x06,
-  0x87, 0x44, 0x7a, 0x14, 0xb3, 0x27, 0x7e, 0x76, 0x91, 0x88, 0xf7, 0xe8,
-  0xb2, 0x38, 0x3b, 0xeb, 0x18, 0x15, 0xc7, 0xd5, 0x97, 0x62, 0xe5, 0x4a,
-  0x7d, 0x52, 0x97, 0x87, 0x16, 0xfb, 0x65, 0xc4, 0x4e, 0xdf, 0x7e, 0x66,
-  0xb2, 0x01, 0xaf, 0x04, 0xa7, 0x95, 0xec, 0xb6, 0x86, 0x34, 0x4d, 0x69,
-  0xcd, 0x8c, 0xd9, 0x28, 0x2d, 0xa8, 0x2b, 0xe2, 0x93, 0xda, 0x05, 0x33,
-  0x13, 0x42, 0x1a, 0x77, 0x5f, 0xe9, 0xd6, 0x40, 0x88, 0x0d, 0x8e, 0x18,
-  0x34, 0xdc, 0x31, 0x09, 0xda, 0x06, 0xf4, 0xab, 0x04, 0xb7, 0x36, 0xd7,
-  0xa5, 0x94, 0x44, 0x35, 0x96, 0x30, 0x7c, 0x0e, 0xda, 0xc4, 0xf3, 0x32,
-  0x74, 0xbf, 0x3a, 0x5c, 0xd7, 0xc0, 0xf7, 0xef, 0x6c, 0x92, 0x59, 0xde,
-  0x37, 0x47, 0x50, 0xb8, 0x4e, 0x6c, 0xbb, 0xb9, 0x72, 0x7c, 0xeb, 0x9e,
-  0xdc, 0x3b, 0xf9, 0xf1, 0xc3, 0x7e, 0xef, 0x64, 0xee, 0xb4, 0xdb, 0x3b,
-  0x5f, 0xbf, 0x2c, 0x70, 0xf1, 0xd0, 0x9f, 0x4d, 0x93, 0x3d, 0xe1, 0x32,
-  0xf1, 0xbe, 0xd3, 0xf0, 0xa0, 0x35, 0xe8, 0x02, 0xc9, 0x94, 0x55, 0x7e,
-  0xb8, 0x1c, 0x5d, 0xce, 0xbb, 0x25, 0xc5, 0x27, 0xeb, 0x3f, 0x0b, 0xf6,
-  0x61, 0x38, 0x28, 0x40, 0xbc, 0x3b, 0xec, 0xd9, 0x0c, 0x88, 0x61, 0xcf,
-  0x2e, 0x70, 0x63, 0xcd, 0xe6, 0xa7, 0xae, 0x79, 0x4d, 0x62, 0x1a, 0xce,
-  0xc1, 0x98, 0x75, 0x23, 0xe5, 0x36, 0x26, 0xdf, 0x20, 0x53, 0xca, 0x22,
-  0xa1, 0x18, 0x21, 0xda, 0x4d, 0x59, 0x09, 0xb5, 0x89, 0x55, 0xe5, 0x1c,
-  0x4f, 0x07, 0x44, 0xc4, 0xeb, 0xfe, 0xd7, 0xb4, 0xc9, 0x0f, 0x95, 0x42,
-  0x91, 0x7e, 0xfe, 0x08, 0x00, 0x00
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x56,
+  0x4d, 0x73, 0xdb, 0x36, 0x10, 0xfd, 0x2b, 0x0c, 0x32, 0xe3, 0x01, 0x6b,
+  0x9a, 0xb5, 0xeb, 0x9e, 0xc4, 0x22, 0x9d, 0xc4, 0x71, 0x1b, 0x77, 0x9c,
+  0x26, 0x13, 0xf9, 0xd0, 0x19, 0x8d, 0x0e, 0x20, 0xb0, 0x92, 0x60, 0xc3,
+  0x04, 0x0b, 0x80, 0x56, 0x35, 0x0a, 0xff, 0x7b, 0x16, 0xfc, 0x12, 0x69,
+  0x5b, 0xa7, 0x5e, 0x4c, 0x6a, 0xb9, 0x78, 0xfb, 0xb0, 0x5f, 0xcf, 0xf7,
+  0xce, 0x14, 0x1f, 0xb9, 0xe7, 0x8c, 0x48, 0xfc, 0x9b, 0xde, 0xe3, 0x4f,
+  0x92, 0xad, 0xaa, 0x42, 0x78, 0x65, 0x8a, 0x48, 0x1b, 0x2e, 0x69, 0xbc,
+  0x17, 0xa6, 0x70, 0x46, 0x43, 0xaa, 0xcd, 0x9a, 0x92, 0x6b, 0x57, 0x5e,
+  0xfe, 0x72, 0x63, 0xfc, 0x07, 0xee, 0xa0, 0x71, 0x00, 0x49, 0xe2, 0x4c,
+  0xad, 0xa8, 0x34, 0xa2, 0x7a, 0x84, 0xc2, 0xa7, 0xb9, 0x91, 0xbb, 0x74,
+  0xc3, 0xdd, 0x7b, 0xef, 0xad, 0xca, 0x2b, 0x0f, 0xb4, 0x01, 0x3f, 0x73,
+  0x60, 0x9f, 0xc0, 0x5a, 0x28, 0x24, 0xd8, 0x70, 0x28, 0xde, 0x5b, 0xf0,
+  0x95, 0x2d, 0xea, 0x27, 0x6e, 0x23, 0x60, 0xc3, 0xf9, 0x35, 0xf8, 0x6b,
+  0x0d, 0xe1, 0xf5, 0xc3, 0xee, 0x46, 0x52, 0xa2, 0x0a, 0xe5, 0x15, 0xd7,
+  0x01, 0xa3, 0x8d, 0x04, 0x27, 0x27, 0x90, 0x7a, 0xf8, 0xcf, 0x5f, 0x99,
+  0xc2, 0xa3, 0x5b, 0xbc, 0xcf, 0x2b, 0xa5, 0xe5, 0x5c, 0x61, 0xa8, 0xbf,
+  0xe6, 0x5f, 0xfe, 0x4e, 0x4b, 0x6e, 0x1d, 0xd0, 0xa9, 0x4f, 0x0a, 0x2d,
+  0xa6, 0x8b, 0xb3, 0x51, 0xd8, 0x9c, 0x15, 0xb0, 0x8d, 0xfe, 0xf9, 0x7c,
+  0xfb, 0xc9, 0xfb, 0xf2, 0x1b, 0xfc, 0x5b, 0x81, 0xf3, 0x34, 0x3e, 0x64,
+  0x40, 0xe0, 0xf5, 0x83, 0x9f, 0x64, 0x23, 0x60, 0xbf, 0x51, 0x2e, 0xb5,
+  0xe0, 0x4a, 0xcc, 0x0b, 0xdc, 0x61, 0x8c, 0x38, 0x3b, 0x10, 0x90, 0x87,
+  0x40, 0xf5, 0x00, 0xc3, 0xa9, 0x7c, 0x96, 0xc6, 0x5b, 0x63, 0x1e, 0x5c,
+  0xa4, 0xd5, 0x03, 0x44, 0x7e, 0x83, 0xf9, 0x88, 0xb6, 0xdc, 0x45, 0x3c,
+  0x2a, 0xad, 0xc9, 0xf1, 0x78, 0x1a, 0xcd, 0x3d, 0xf7, 0x95, 0x8b, 0xae,
+  0x8c, 0x84, 0x59, 0x44, 0x4e, 0xf3, 0xd4, 0x35, 0x86, 0x38, 0xe3, 0x52,
+  0x76, 0xd9, 0xb9, 0x33, 0x1f, 0xcd, 0x23, 0x25, 0x9b, 0x0b, 0x92, 0x10,
+  0xcc, 0xab, 0xb1, 0xf8, 0xbc, 0x32, 0x95, 0x96, 0x51, 0x61, 0x7c, 0x53,
+  0x9a, 0x08, 0x43, 0xae, 0xd4, 0xba, 0xb2, 0x3c, 0xb0, 0x18, 0xe3, 0x24,
+  0x7b, 0xe7, 0x77, 0x1a, 0x66, 0x44, 0x18, 0x6d, 0xec, 0x2c, 0xd4, 0xa3,
+  0x1e, 0x12, 0x93, 0xa7, 0x21, 0xc8, 0x13, 0x86, 0xb8, 0x55, 0x0e, 0x93,
+  0x07, 0x96, 0x92, 0x00, 0x47, 0x12, 0x81, 0x37, 0x7d, 0xe5, 0x63, 0x17,
+  0x9d, 0x87, 0xaf, 0xa6, 0x84, 0x82, 0x92, 0x3f, 0xaf, 0xef, 0x48, 0x72,
+  0xdf, 0x35, 0x57, 0x30, 0x3b, 0x2c, 0x3b, 0x1d, 0x65, 0xa4, 0x67, 0x06,
+  0xdd, 0x65, 0x28, 0x8f, 0xf7, 0x6e, 0xab, 0xbc, 0xd8, 0x50, 0xde, 0x67,
+  0x10, 0x53, 0x86, 0x4d, 0x86, 0xf5, 0x2f, 0x2b, 0x4f, 0x66, 0x58, 0x78,
+  0x9e, 0x8a, 0xbe, 0xe2, 0x9a, 0xe7, 0xa0, 0x6f, 0x24, 0x23, 0xcd, 0xcb,
+  0x0a, 0xc3, 0x9f, 0xf2, 0x54, 0xc9, 0xac, 0xf9, 0x19, 0x3a, 0x8f, 0xed,
+  0x49, 0xb0, 0xce, 0x82, 0xb5, 0x7e, 0x99, 0xb5, 0xc6, 0x8f, 0x24, 0x1d,
+  0x4c, 0x32, 0x20, 0x27, 0x03, 0x00, 0xda, 0xb0, 0xdc, 0x21, 0xd8, 0xcb,
+  0xd3, 0x2d, 0xa5, 0x24, 0x60, 0x27, 0x24, 0x3c, 0x79, 0xdf, 0xeb, 0x2e,
+  0x21, 0x6f, 0xc9, 0x69, 0x07, 0x1b, 0xd7, 0xa0, 0x1d, 0xec, 0x9f, 0x1f,
+  0x1f, 0x2e, 0xd8, 0x02, 0x1c, 0x62, 0x4f, 0x70, 0x86, 0xf0, 0x75, 0x6e,
+  0x81, 0x3f, 0x64, 0x12, 0x56, 0xbc, 0xd2, 0x7e, 0xf6, 0x3f, 0xd1, 0xb2,
+  0x06, 0xad, 0x1e, 0xf5, 0xe6, 0x33, 0xbc, 0x3c, 0xe1, 0x09, 0xb4, 0x5d,
+  0xbf, 0x62, 0xdc, 0xae, 0x9b, 0xa1, 0x74, 0xa9, 0x86, 0x62, 0xed, 0x37,
+  0xef, 0x2e, 0x4f, 0x4e, 0x06, 0xdb, 0xe2, 0x72, 0xf9, 0x86, 0xb1, 0x0a,
+  0xe7, 0x79, 0xa5, 0x0a, 0x90, 0xbf, 0x8f, 0x3f, 0xcc, 0xf6, 0x75, 0x16,
+  0x20, 0xd6, 0x07, 0x88, 0xc5, 0xaf, 0xcb, 0xc6, 0x24, 0x8e, 0x8e, 0x3a,
+  0x6f, 0xc6, 0xfb, 0x8d, 0xc0, 0xc2, 0x1f, 0x7c, 0x04, 0xf2, 0xf5, 0x43,
+  0x9b, 0xe4, 0x71, 0x1d, 0x36, 0x00, 0x7a, 0x8c, 0xa7, 0x9b, 0x41, 0xb0,
+  0xf2, 0x60, 0x75, 0xe0, 0x47, 0x8b, 0x47, 0xc9, 0xd0, 0x96, 0xf5, 0xd8,
+  0xe8, 0xa8, 0x48, 0x56, 0x71, 0xd6, 0x4e, 0xf5, 0x10, 0x05, 0x27, 0xdf,
+  0xee, 0xe6, 0x98, 0x49, 0xe1, 0x8d, 0xa5, 0xeb, 0x96, 0x08, 0x0e, 0xed,
+  0x51, 0x17, 0xf2, 0x76, 0x6b, 0x79, 0x59, 0x82, 0x25, 0x71, 0x2d, 0xd3,
+  0xf0, 0x56, 0xc8, 0xab, 0x0d, 0x6e, 0x01, 0x2a, 0x46, 0x6d, 0xfe, 0x3c,
+  0x30, 0x52, 0xc4, 0xae, 0xa4, 0xcd, 0xea, 0x89, 0x14, 0x26, 0x3f, 0xde,
+  0x07, 0xe2, 0x8b, 0x7c, 0xf9, 0x82, 0x3b, 0xd6, 0x21, 0x98, 0xeb, 0x51,
+  0xa9, 0x0e, 0x5b, 0x46, 0xb4, 0x05, 0xca, 0xd9, 0x81, 0x46, 0x36, 0xde,
+  0x2f, 0x38, 0xa8, 0x5b, 0x24, 0x83, 0x8e, 0x7d, 0xe1, 0xce, 0xfb, 0x45,
+  0xb6, 0x58, 0x66, 0x3d, 0x05, 0xce, 0xce, 0x33, 0xfe, 0x5b, 0xef, 0x92,
+  0xf1, 0xd3, 0xd3, 0x86, 0x8e, 0x58, 0xf0, 0x65, 0xd7, 0x2e, 0x8c, 0xe5,
+  0x98, 0x83, 0xb4, 0xac, 0xdc, 0xa6, 0x31, 0xc7, 0x19, 0xb2, 0x2c, 0xb5,
+  0x12, 0x40, 0x79, 0x72, 0x71, 0x68, 0xa6, 0x09, 0xa0, 0x9c, 0x00, 0xbe,
+  0x98, 0x74, 0x19, 0x70, 0x42, 0xbd, 0xc6, 0xdc, 0x72, 0x26, 0x16, 0xe7,
+  0x7d, 0xd4, 0xf1, 0x9d, 0x71, 0x41, 0x85, 0x8c, 0x5f, 0x8d, 0x37, 0x59,
+  0xb7, 0x94, 0x45, 0xb3, 0xbc, 0xff, 0x30, 0xf6, 0x31, 0x6c, 0x19, 0x5c,
+  0xdb, 0x93, 0x75, 0xd7, 0x85, 0x73, 0x6c, 0x2a, 0x4c, 0x93, 0x2a, 0xbe,
+  0xd7, 0x9a, 0x92, 0x9f, 0x16, 0x8d, 0x3c, 0xb5, 0x87, 0x1f, 0x60, 0xb7,
+  0x44, 0x95, 0xe9, 0x2f, 0x24, 0xd9, 0xab, 0x98, 0x1d, 0xf1, 0xb3, 0x8b,
+  0x4c, 0xbe, 0xc3, 0x2b, 0xcb, 0xb3, 0xb3, 0x96, 0xd1, 0xe6, 0x75, 0xf7,
+  0x85, 0x5c, 0x86, 0x56, 0x7f, 0x2e, 0x88, 0x43, 0x44, 0xd2, 0xb6, 0x23,
+  0x3f, 0x7e, 0xfa, 0x89, 0xeb, 0x0a, 0xb2, 0x56, 0x28, 0x8f, 0x3a, 0xf9,
+  0x5d, 0x09, 0x8c, 0x31, 0x52, 0x72, 0xe7, 0xb6, 0xc6, 0x4a, 0x12, 0x9a,
+  0xf8, 0xa8, 0xf7, 0x54, 0xa1, 0x2d, 0x6a, 0x9f, 0x6a, 0x64, 0x19, 0x07,
+  0x1c, 0x31, 0x48, 0xbc, 0xe7, 0x1a, 0xac, 0xa7, 0xe4, 0xab, 0x86, 0x20,
+  0xf5, 0x2b, 0xa5, 0x75, 0x64, 0x2a, 0x1f, 0x71, 0x7c, 0xf6, 0xde, 0x51,
+  0xc3, 0xcb, 0x91, 0x41, 0x3a, 0xc2, 0xd4, 0xc0, 0xf7, 0xef, 0x7c, 0x54,
+  0x59, 0xd1, 0x0d, 0x07, 0xdd, 0x84, 0x49, 0xac, 0xdb, 0xbd, 0xf2, 0xba,
+  0xea, 0x1e, 0xd5, 0x9d, 0xf5, 0xeb, 0x1f, 0x3b, 0xdd, 0xc9, 0xc3, 0xd7,
+  0x56, 0x77, 0xbe, 0x7e, 0x99, 0xa3, 0xf0, 0x90, 0x9f, 0x5d, 0x95, 0x3f,
+  0xa2, 0x98, 0x34, 0x77, 0x27, 0xf1, 0x64, 0x34, 0xc8, 0x1c, 0xc9, 0xa8,
+  0x62, 0x3d, 0x15, 0xc7, 0x50, 0xf3, 0x56, 0xa4, 0xc4, 0x48, 0xfe, 0x73,
+  0x3a, 0xa4, 0x61, 0xd2, 0x80, 0x78, 0xb6, 0xd7, 0xd9, 0x1c, 0x22, 0xc7,
+  0x9f, 0x42, 0xe2, 0x0e, 0x3d, 0xbb, 0x3e, 0x76, 0xac, 0xf1, 0x8c, 0x5c,
+  0x25, 0x04, 0x38, 0xb7, 0xaa, 0xb4, 0xde, 0xa5, 0xd1, 0x37, 0xc8, 0x8d,
+  0xf1, 0x48, 0x28, 0x45, 0x88, 0x7a, 0xab, 0x0a, 0x69, 0xb6, 0xa9, 0x29,
+  0xc2, 0xc5, 0x59, 0x8f, 0x88, 0x78, 0xed, 0xff, 0x62, 0x75, 0xf6, 0x03,
+  0x89, 0x57, 0xb0, 0x9c, 0xb2, 0x09, 0x00, 0x00
 };
-static const size_t k_index_htm_gz_len = 276;
-static const uint8_t k_index_htm_gz[] = {
-  0x1f, 0x8b, 0x08, 0x08, 0xe7, 0x87, 0x99, 0x5e, 0x00, 0x03, 0x69, 0x6e,
-  0x64, 0x65, 0x78, 0x2e, 0x68, 0x74, 0x6d, 0x00, 0x5d, 0x50, 0x3d, 0x53,
-  0xc3, 0x30, 0x0c, 0xdd, 0xf9, 0x15, 0x42, 0x2b, 0xb4, 0x39, 0xda, 0x85,
-  0x21, 0xce, 0x02, 0x9d, 0xe9, 0x1d, 0x2c, 0x8c, 0xae, 0xa3, 0x26, 0x2a,
-  0x8e, 0x93, 0xb3, 0xd4, 0x94, 0xf0, 0xeb, 0x51, 0x52, 0x18, 0x60, 0xd1,
-  0xe9, 0x7d, 0x0e, 0xaf, 0xbc, 0x7d, 0x7e, 0x79, 0x7a, 0x7b, 0xdf, 0xef,
-  0xa0, 0xd5, 0x2e, 0x56, 0xe5, 0x7c, 0x21, 0xfa, 0xd4, 0x38, 0xa4, 0x84,
-  0x86, 0xc9, 0xd7, 0x55, 0xd9, 0x91, 0x7a, 0x08, 0xad, 0xcf, 0x42, 0xea,
-  0xf0, 0xac, 0xc7, 0xd5, 0x23, 0xfe, 0xb0, 0xc9, 0x77, 0xe4, 0x70, 0x64,
-  0xba, 0x0c, 0x7d, 0x56, 0x84, 0xd0, 0x27, 0xa5, 0x64, 0xae, 0x0b, 0xd7,
-  0xda, 0xba, 0x9a, 0x46, 0x0e, 0xb4, 0x5a, 0xc0, 0x3d, 0x70, 0x62, 0x65,
-  0x1f, 0x57, 0x12, 0x7c, 0x24, 0xf7, 0x60, 0x1d, 0x91, 0xd3, 0x07, 0x64,
-  0x8a, 0x0e, 0xa5, 0xb5, 0x7c, 0x38, 0x2b, 0xb0, 0x55, 0x20, 0xe8, 0x34,
-  0x58, 0x2f, 0x77, 0xbe, 0xa1, 0x42, 0xc6, 0xe6, 0xee, 0xb3, 0x8b, 0x08,
-  0x6d, 0xa6, 0xa3, 0xc3, 0x22, 0xf6, 0x4d, 0xbf, 0x36, 0x12, 0x41, 0xf8,
-  0x8b, 0xc4, 0xa1, 0x4f, 0xd3, 0xdf, 0x2e, 0x9d, 0x22, 0x49, 0x4b, 0xa4,
-  0xbf, 0x19, 0x92, 0x61, 0xbb, 0xe1, 0x5e, 0x0f, 0x5e, 0x68, 0x1d, 0x44,
-  0xcc, 0x2e, 0x21, 0xf3, 0xa0, 0x20, 0x39, 0xfc, 0x93, 0x4f, 0x82, 0x50,
-  0x95, 0xc5, 0x55, 0xaf, 0x4a, 0x65, 0x8d, 0x04, 0x5c, 0x3b, 0x5c, 0x3e,
-  0xac, 0x76, 0xaf, 0xfb, 0xed, 0xa6, 0x2c, 0x16, 0x64, 0xbe, 0xeb, 0x44,
-  0x87, 0xbe, 0x9e, 0x16, 0xd3, 0xfc, 0x58, 0x7b, 0xcd, 0xe3, 0x02, 0x2f,
-  0xd9, 0x0f, 0x03, 0x65, 0x63, 0x0a, 0xa3, 0xec, 0xce, 0xfa, 0x9c, 0x9a,
-  0xe7, 0xbe, 0xf9, 0x06, 0x63, 0xaf, 0xdd, 0x15, 0x7f, 0x01, 0x00, 0x00
+static const size_t k_esp32iotbase_js_br_len = 864;
+static const uint8_t k_esp32iotbase_js_br[] = {
+  0x1b, 0xb1, 0x09, 0x60, 0x1c, 0x85, 0x71, 0x63, 0xbd, 0x88, 0x02, 0x26,
+  0x8a, 0x88, 0xd3, 0xf2, 0x5f, 0x54, 0x8b, 0xaa, 0xbb, 0xde, 0x20, 0x96,
+  0x44, 0x5d, 0x77, 0x5e, 0x11, 0x86, 0x7d, 0x7c, 0x7c, 0x61, 0xc9, 0xb2,
+  0x93, 0xce, 0x89, 0xb1, 0xcd, 0x8e, 0xb8, 0x20, 0x29, 0x0a, 0x03, 0x4b,
+  0x03, 0x6b, 0xab, 0xbd, 0xfc, 0x76, 0xf0, 0xdf, 0x3d, 0x28, 0x20, 0x6e,
+  0x97, 0xd6, 0xd4, 0xb2, 0x90, 0x93, 0x02, 0xc8, 0xce, 0xc9, 0x4f, 0x72,
+  0x25, 0x44, 0xdb, 0xdc, 0xa8, 0xc8, 0x6a, 0x96, 0x8c, 0x5a, 0x6b, 0xf7,
+  0x30, 0x67, 0xd3, 0x13, 0x7d, 0x35, 0x06, 0x04, 0x9f, 0x38, 0xa8, 0x15,
+  0xbc, 0x16, 0x40, 0x50, 0xa3, 0xb3, 0x1b, 0x37, 0xf0, 0x10, 0xa0, 0x2a,
+  0x88, 0x94, 0x44, 0x77, 0x62, 0xff, 0x6a, 0x10, 0xde, 0xdf, 0x6a, 0xe0,
+  0x89, 0xdd, 0x91, 0x0f, 0xc4, 0x52, 0x3d, 0x68, 0x94, 0x04, 0x75, 0x71,
+  0x24, 0xdb, 0xe7, 0xcf, 0x69, 0x3b, 0x82, 0xb1, 0x10, 0x79, 0x44, 0x3f,
+  0x8c, 0x52, 0xc9, 0x4b, 0x97, 0x19, 0xbe, 0x54, 0xa4, 0xee, 0x82, 0x31,
+  0x00, 0x84, 0x50, 0xe5, 0xe2, 0xcd, 0x4d, 0xb4, 0x73, 0x11, 0xcc, 0xb1,
+  0x53, 0xe2, 0x25, 0x3c, 0xad, 0x71, 0xa0, 0x38, 0xf8, 0xcc, 0x76, 0x48,
+  0x3a, 0x99, 0x2c, 0x63, 0xa6, 0x89, 0xf1, 0x7e, 0xe3, 0x2d, 0xe2, 0xf1,
+  0x12, 0xe2, 0x53, 0x48, 0x2c, 0x70, 0x68, 0x0a, 0x32, 0x1d, 0x40, 0x46,
+  0xbb, 0x62, 0x26, 0x3a, 0x45, 0x4c, 0x41, 0x57, 0xc0, 0x64, 0xce, 0x70,
+  0xf6, 0x49, 0x81, 0x8f, 0x78, 0xcc, 0x18, 0xda, 0x6d, 0x67, 0x28, 0x11,
+  0xf2, 0x32, 0xd8, 0x1b, 0x67, 0x86, 0xb3, 0x69, 0x35, 0x94, 0x05, 0xab,
+  0xb7, 0xe2, 0x2a, 0x12, 0x4b, 0x08, 0xec, 0x39, 0xf8, 0x81, 0x37, 0xcc,
+  0x11, 0x46, 0x3d, 0x36, 0x10, 0xb5, 0xb2, 0xa0, 0x3e, 0x1e, 0x12, 0x22,
+  0x0a, 0x17, 0x32, 0x03, 0x64, 0x37, 0x49, 0x2f, 0xec, 0x25, 0x28, 0x90,
+  0xae, 0x14, 0xc8, 0x55, 0x26, 0xee, 0xef, 0x35, 0xca, 0x86, 0x00, 0xef,
+  0x47, 0x30, 0x4a, 0xdc, 0x2a, 0xd0, 0xeb, 0xe4, 0x1b, 0xd4, 0xcb, 0x86,
+  0x60, 0xfb, 0x46, 0xd3, 0x2e, 0xac, 0x07, 0xf3, 0xe9, 0x42, 0x96, 0xa8,
+  0x49, 0x33, 0xc6, 0xd9, 0x24, 0x50, 0x28, 0xe9, 0xaa, 0x0b, 0x85, 0x85,
+  0x36, 0x4a, 0x5a, 0xad, 0x87, 0xeb, 0xb1, 0x6b, 0x2d, 0xc7, 0x35, 0x8a,
+  0x55, 0x91, 0xa3, 0x25, 0xc0, 0xd9, 0xff, 0x70, 0xe9, 0x40, 0xbd, 0xdc,
+  0x40, 0x4b, 0xec, 0x38, 0x70, 0x19, 0x54, 0xcf, 0xe7, 0x12, 0x54, 0x9f,
+  0x95, 0x03, 0x32, 0xdb, 0xb0, 0xa3, 0x13, 0x0c, 0x1c, 0xb3, 0x01, 0x6d,
+  0x36, 0x10, 0x94, 0x4a, 0x32, 0xdb, 0x01, 0xf4, 0x47, 0x34, 0xe9, 0x0c,
+  0x70, 0x9b, 0x81, 0x85, 0x0e, 0x37, 0x53, 0x34, 0x70, 0x09, 0x2d, 0xb8,
+  0x06, 0x72, 0x9c, 0xd2, 0xf1, 0xea, 0x19, 0xc2, 0x2f, 0x43, 0xce, 0x01,
+  0xa9, 0xff, 0xf5, 0xd9, 0x47, 0x18, 0xf9, 0xe5, 0xba, 0xf9, 0x48, 0x70,
+  0xe7, 0xdc, 0x95, 0x45, 0x21, 0xfd, 0x2d, 0x78, 0x23, 0x26, 0xaa, 0xbd,
+  0xbb, 0xe6, 0x45, 0x44, 0x9a, 0x94, 0x7e, 0x18, 0xdc, 0x48, 0x65, 0x5b,
+  0x35, 0xf8, 0x22, 0xe7, 0xfc, 0x65, 0xcf, 0x63, 0x4b, 0x2c, 0x52, 0x66,
+  0x18, 0x53, 0x8d, 0x3f, 0xfb, 0xf0, 0xeb, 0x63, 0x38, 0xb5, 0x75, 0xbd,
+  0xd8, 0xf7, 0xaf, 0x2e, 0x94, 0x92, 0x7a, 0x27, 0x9f, 0xa7, 0xec, 0x02,
+  0x9e, 0x51, 0x52, 0x9b, 0x8b, 0xd5, 0xa7, 0x22, 0xf1, 0x73, 0x3e, 0x18,
+  0x07, 0xbd, 0xec, 0xc9, 0x5f, 0x35, 0x5b, 0x54, 0x53, 0x13, 0x29, 0x4f,
+  0x8a, 0x80, 0xb1, 0x82, 0x02, 0x49, 0x62, 0xb9, 0xc1, 0x66, 0x77, 0x12,
+  0x5e, 0xd7, 0xc7, 0x0d, 0x97, 0x97, 0xe5, 0xda, 0xa5, 0x1c, 0x7c, 0x6a,
+  0xb7, 0xea, 0xb9, 0x14, 0xb3, 0xf2, 0xa5, 0xf2, 0xf1, 0x59, 0xbf, 0xf1,
+  0x8b, 0x0a, 0xa0, 0x7c, 0x7f, 0xe5, 0xbf, 0x3e, 0xed, 0xde, 0xd4, 0x77,
+  0x67, 0x59, 0x75, 0xb8, 0x19, 0x83, 0x4a, 0x68, 0xca, 0xa3, 0xa3, 0x87,
+  0x1d, 0x8c, 0x5f, 0x89, 0x63, 0x92, 0x0b, 0x55, 0x72, 0xa6, 0xae, 0x27,
+  0x0b, 0x55, 0x5f, 0x4c, 0x43, 0x8b, 0xe8, 0x72, 0xdf, 0xf7, 0x89, 0xb3,
+  0xb4, 0x5a, 0xf4, 0x24, 0xb5, 0x92, 0x2f, 0x7d, 0x69, 0x70, 0xce, 0x53,
+  0x0a, 0x81, 0x12, 0xea, 0x43, 0xc4, 0x7a, 0x1b, 0x1b, 0x6d, 0x1a, 0x51,
+  0x4c, 0x4f, 0x9b, 0x24, 0x10, 0xaf, 0x07, 0xb9, 0xa9, 0xeb, 0x02, 0x20,
+  0x10, 0x18, 0x23, 0xae, 0xe4, 0x9d, 0x56, 0x5d, 0xb4, 0x6c, 0xd2, 0x22,
+  0x61, 0xe0, 0x77, 0x57, 0x91, 0x26, 0xa3, 0x57, 0xef, 0x0d, 0x61, 0x1f,
+  0xdc, 0xcc, 0x2e, 0x12, 0xfb, 0x3b, 0x81, 0x6f, 0x76, 0xeb, 0x22, 0x93,
+  0x44, 0x8c, 0x9e, 0xe7, 0x3b, 0xfb, 0xb4, 0xdf, 0x55, 0xf1, 0x89, 0x46,
+  0xb7, 0x4d, 0xe3, 0xf9, 0x0b, 0x88, 0x45, 0x8b, 0x03, 0xa0, 0x82, 0xf2,
+  0x63, 0xed, 0x1e, 0xcf, 0x83, 0xeb, 0xf2, 0xb4, 0xdb, 0x24, 0x0d, 0x31,
+  0xea, 0xff, 0xb5, 0x0a, 0x5f, 0xf6, 0x28, 0xa6, 0x04, 0xa5, 0x01, 0xf4,
+  0x71, 0x48, 0x19, 0x8e, 0x91, 0x1b, 0x7b, 0xdd, 0x31, 0x62, 0xce, 0xba,
+  0xe5, 0x1c, 0x5c, 0x62, 0x10, 0xb4, 0xf8, 0x55, 0xdd, 0x65, 0x21, 0x5a,
+  0x95, 0x26, 0x1c, 0x03, 0xba, 0xb9, 0x11, 0xe7, 0x00, 0x28, 0xa5, 0x84,
+  0x46, 0xc8, 0x41, 0xe0, 0x30, 0x98, 0x66, 0xf9, 0x63, 0x2d, 0x64, 0x41,
+  0xd5, 0x9d, 0x2e, 0x96, 0x68, 0x86, 0xd8, 0x01, 0x66, 0xf3, 0x39, 0xfe,
+  0xff, 0x8b, 0x68, 0x8d, 0x6a, 0x1d, 0x36, 0x1c, 0x99, 0x22, 0x86, 0xdd,
+  0xbb, 0xd4, 0xaf, 0x0b, 0x3c, 0x27, 0xcd, 0x1d, 0xeb, 0x13, 0x7f, 0x59,
+  0xe3, 0x13, 0x53, 0xe7, 0x80, 0x4e, 0x92, 0x44, 0x93, 0xdf, 0x05, 0xe2,
+  0xd8, 0x2b, 0xce, 0xab, 0xcd, 0x59, 0x03, 0x42, 0xa7, 0x28, 0xd5, 0xad,
+  0xf1, 0xdf, 0xed, 0xe3, 0x03, 0xd7, 0x40, 0x76, 0x5c, 0x1d, 0xe6, 0xcf,
+  0xdd, 0x60, 0xf6, 0x43, 0x35, 0xe3, 0xb0, 0x6b, 0x6f, 0x71, 0xee, 0x93,
+  0x7f, 0x6d, 0x51, 0xeb, 0x97, 0xcb, 0xdd, 0x78, 0xd1, 0x58, 0xa0, 0x9c,
+  0xd3, 0x37, 0xca, 0x80, 0x59, 0x92, 0xa7, 0x54, 0x40, 0x04, 0xd5, 0x31
 };
-static const size_t k_logo_svg_gz_len = 707;
+static const size_t k_logo_svg_len = 1458;
+static const char k_logo_svg_hash[] = "eeff4c53e60a17c6";
+static const size_t k_logo_svg_gz_len = 698;
 static const uint8_t k_logo_svg_gz[] = {
-  0x1f, 0x8b, 0x08, 0x08, 0xe7, 0x87, 0x99, 0x5e, 0x00, 0x03, 0x6c, 0x6f,
-  0x67, 0x6f, 0x2e, 0x73, 0x76, 0x67, 0x00, 0xbd, 0x54, 0xc1, 0x72, 0xdb,
-  0x20, 0x10, 0xbd, 0xe7, 0x2b, 0x18, 0x72, 0x49, 0x0e, 0x20, 0x40, 0x08,
-  0x24, 0x37, 0x4a, 0x66, 0x7a, 0x68, 0x4f, 0x9d, 0x1e, 0xda, 0x7c, 0x00,
-  0x91, 0x91, 0xc5, 0x44, 0x11, 0xae, 0x44, 0x2c, 0x27, 0x5f, 0xdf, 0x05,
-  0xc9, 0xf1, 0x64, 0x92, 0x6b, 0x3b, 0x1e, 0xaf, 0x97, 0x65, 0xf7, 0xf1,
-  0x1e, 0xbb, 0xf8, 0xe6, 0xee, 0xf8, 0xd4, 0xa3, 0x83, 0x1d, 0x27, 0xe7,
-  0x87, 0x1a, 0x73, 0xca, 0x30, 0xb2, 0x43, 0xe3, 0xb7, 0x6e, 0xd8, 0xd5,
-  0xf8, 0xfe, 0xf7, 0x37, 0x52, 0xe2, 0xbb, 0xdb, 0x8b, 0x9b, 0xe9, 0xb0,
-  0x43, 0xb3, 0xdb, 0x86, 0xae, 0xc6, 0x4a, 0x62, 0xd4, 0x59, 0xb7, 0xeb,
-  0xc2, 0xe2, 0x1f, 0x9c, 0x9d, 0xbf, 0xfa, 0x63, 0x8d, 0x19, 0x62, 0x88,
-  0x2b, 0x5a, 0xe5, 0x8b, 0xc5, 0x08, 0xa0, 0x87, 0xa9, 0xc6, 0x5d, 0x08,
-  0xfb, 0x4d, 0x96, 0xcd, 0xf3, 0x4c, 0xe7, 0x9c, 0xfa, 0x71, 0x97, 0x09,
-  0xc6, 0x58, 0x06, 0x90, 0x6b, 0xca, 0xc6, 0x4f, 0x0f, 0xef, 0xd2, 0xfc,
-  0xde, 0x0e, 0xd3, 0x6c, 0x42, 0xd3, 0x3d, 0x78, 0xff, 0x98, 0x4a, 0x9e,
-  0x47, 0x17, 0xcb, 0xaa, 0x0c, 0x72, 0x4f, 0x65, 0xc7, 0xde, 0x0d, 0x8f,
-  0x9f, 0xe1, 0xf3, 0xaa, 0xaa, 0xb2, 0xb4, 0x8b, 0x81, 0xfb, 0xd6, 0xb6,
-  0x13, 0xfc, 0xc0, 0xd2, 0x9a, 0xf1, 0xfb, 0x68, 0xb6, 0xce, 0x0e, 0x01,
-  0xb9, 0x6d, 0x8d, 0x0d, 0x20, 0x71, 0x50, 0x2d, 0x19, 0x15, 0x1a, 0x7c,
-  0x01, 0x7e, 0xa1, 0xa9, 0xc0, 0xe8, 0x25, 0x86, 0xb5, 0xa0, 0x52, 0x81,
-  0x2f, 0xce, 0xfe, 0x6e, 0x2d, 0xbf, 0x1f, 0x5c, 0x00, 0x69, 0xcf, 0x93,
-  0x1d, 0x7f, 0xed, 0x4d, 0x63, 0x7f, 0x0e, 0xf7, 0x93, 0x8d, 0x87, 0x4d,
-  0xc1, 0xef, 0x51, 0x34, 0xa4, 0xf1, 0xbd, 0x1f, 0x6b, 0x7c, 0x29, 0x94,
-  0x51, 0x15, 0x9c, 0xe4, 0xdb, 0x76, 0xb2, 0x70, 0x67, 0x0c, 0x67, 0x90,
-  0x97, 0xbd, 0xa7, 0x13, 0x23, 0x2b, 0xcf, 0x1d, 0x0a, 0xa3, 0x19, 0xa6,
-  0xd6, 0x8f, 0x4f, 0x35, 0x4e, 0x6e, 0x6f, 0x82, 0xbd, 0x22, 0x0b, 0x4b,
-  0x44, 0xb8, 0x92, 0xd7, 0xf1, 0xa4, 0xd1, 0x36, 0x01, 0x1d, 0x17, 0xf6,
-  0x05, 0xb0, 0x04, 0x4f, 0x49, 0x2a, 0x80, 0xfc, 0xda, 0x28, 0xe8, 0x82,
-  0xd4, 0xe7, 0x5e, 0xad, 0xcb, 0x31, 0x26, 0x52, 0x09, 0x69, 0xad, 0xeb,
-  0x7b, 0xe0, 0xd7, 0x56, 0xf1, 0x83, 0x81, 0xf4, 0xe8, 0x1f, 0x2d, 0x68,
-  0x1a, 0xfb, 0xab, 0x4b, 0x73, 0x7d, 0x0a, 0x90, 0x48, 0xb4, 0x31, 0xfb,
-  0x1a, 0x4f, 0x7f, 0x9e, 0xcd, 0x68, 0xdf, 0xe2, 0xeb, 0x29, 0x11, 0x34,
-  0x4b, 0xb4, 0x57, 0xbc, 0x93, 0xde, 0xd6, 0x0f, 0x81, 0xb4, 0xe6, 0xc9,
-  0xf5, 0x70, 0xe2, 0x2f, 0x90, 0xb1, 0x86, 0xe6, 0x95, 0x8f, 0x64, 0x2c,
-  0xca, 0xd8, 0x9b, 0xd0, 0x21, 0xe8, 0xc5, 0x0f, 0x2e, 0x4b, 0x5a, 0x0a,
-  0xc4, 0x35, 0xa3, 0xb9, 0x6a, 0x08, 0xa7, 0x5c, 0x23, 0x46, 0x04, 0x15,
-  0x12, 0x8e, 0x20, 0x39, 0x65, 0x30, 0x57, 0xb0, 0xe8, 0x69, 0xa9, 0x69,
-  0xa9, 0x4c, 0x4e, 0xb9, 0x40, 0xc9, 0xa4, 0xb9, 0x43, 0x12, 0xaa, 0x20,
-  0x27, 0x6e, 0x93, 0xb8, 0x0f, 0xeb, 0x1c, 0x25, 0x13, 0xf7, 0x59, 0x04,
-  0xd0, 0x00, 0x2a, 0xf4, 0x2b, 0xb4, 0x02, 0x06, 0xbe, 0xed, 0xfd, 0x5c,
-  0xe3, 0x83, 0x9b, 0xdc, 0x43, 0x9f, 0x44, 0xbd, 0xf4, 0x20, 0x3e, 0xd8,
-  0x63, 0x20, 0x5b, 0xdb, 0xf8, 0xd1, 0x04, 0x78, 0x11, 0x49, 0xfc, 0x66,
-  0xf0, 0x83, 0xfd, 0x92, 0x76, 0xdc, 0xb0, 0x85, 0x66, 0x6d, 0xd8, 0xb2,
-  0x7a, 0xeb, 0x53, 0xca, 0x48, 0xb7, 0xf0, 0x41, 0x8d, 0xd2, 0xb4, 0x32,
-  0x8a, 0x96, 0x28, 0x7e, 0x17, 0x26, 0x92, 0xea, 0x12, 0xa4, 0x54, 0x6a,
-  0x91, 0xa2, 0x4d, 0x41, 0x8b, 0x02, 0x25, 0xb3, 0x48, 0x81, 0x60, 0x71,
-  0x96, 0xa2, 0x3f, 0x94, 0x97, 0x44, 0xfc, 0x67, 0x11, 0x05, 0x95, 0xd2,
-  0x54, 0x71, 0xfc, 0x92, 0x59, 0x88, 0x28, 0x5a, 0xe4, 0x48, 0x50, 0x55,
-  0x9e, 0x74, 0x94, 0x94, 0x71, 0x94, 0xcc, 0xa2, 0xa3, 0xa0, 0x4a, 0x41,
-  0x03, 0x73, 0x81, 0x4a, 0x54, 0x9e, 0x63, 0x15, 0x14, 0xe5, 0xf2, 0xad,
-  0x51, 0x9f, 0xc0, 0xc6, 0x2a, 0xcd, 0xff, 0xa9, 0xc6, 0x6c, 0xf7, 0x5e,
-  0x28, 0x08, 0x90, 0xa9, 0x5b, 0x85, 0xe8, 0x09, 0x4c, 0x0d, 0xe5, 0xb1,
-  0x47, 0x1c, 0xa8, 0x32, 0x45, 0x0a, 0xe0, 0x27, 0xbb, 0x38, 0x92, 0xea,
-  0x40, 0x73, 0xdd, 0x71, 0xa0, 0x97, 0x1f, 0x48, 0x74, 0x63, 0xb0, 0xe8,
-  0x49, 0x41, 0x20, 0x23, 0x16, 0x90, 0x54, 0x00, 0x00, 0x04, 0xe6, 0x97,
-  0xd0, 0x2a, 0xa2, 0x94, 0xf9, 0xeb, 0x53, 0xf4, 0x14, 0xd5, 0x3d, 0xdc,
-  0x57, 0x1c, 0xcb, 0x0a, 0xe0, 0x0a, 0x2a, 0xd4, 0xeb, 0xf9, 0xdd, 0x5d,
-  0xb6, 0x6d, 0xfb, 0xe1, 0x71, 0x71, 0x75, 0x66, 0x1b, 0xff, 0x31, 0x6f,
-  0x2f, 0xfe, 0x02, 0xdc, 0x6a, 0x94, 0x1e, 0xb2, 0x05, 0x00, 0x00
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x54,
+  0xc1, 0x72, 0xdb, 0x20, 0x10, 0xbd, 0xe7, 0x2b, 0x18, 0x72, 0x49, 0x0e,
+  0x20, 0x40, 0x08, 0x24, 0x37, 0x4a, 0x66, 0x7a, 0x68, 0x4f, 0x9d, 0x1e,
+  0xda, 0x7c, 0x00, 0x91, 0x91, 0xc5, 0x44, 0x11, 0xae, 0x44, 0x2c, 0x27,
+  0x5f, 0xdf, 0x05, 0xc9, 0xf1, 0x64, 0x92, 0x6b, 0x3b, 0x1e, 0xaf, 0x97,
+  0x65, 0xf7, 0xf1, 0x1e, 0xbb, 0xf8, 0xe6, 0xee, 0xf8, 0xd4, 0xa3, 0x83,
+  0x1d, 0x27, 0xe7, 0x87, 0x1a, 0x73, 0xca, 0x30, 0xb2, 0x43, 0xe3, 0xb7,
+  0x6e, 0xd8, 0xd5, 0xf8, 0xfe, 0xf7, 0x37, 0x52, 0xe2, 0xbb, 0xdb, 0x8b,
+  0x9b, 0xe9, 0xb0, 0x43, 0xb3, 0xdb, 0x86, 0xae, 0xc6, 0x4a, 0x62, 0xd4,
+  0x59, 0xb7, 0xeb, 0xc2, 0xe2, 0x1f, 0x9c, 0x9d, 0xbf, 0xfa, 0x63, 0x8d,
+  0x19, 0x62, 0x88, 0x2b, 0x5a, 0xe5, 0x8b, 0xc5, 0x08, 0xa0, 0x87, 0xa9,
+  0xc6, 0x5d, 0x08, 0xfb, 0x4d, 0x96, 0xcd, 0xf3, 0x4c, 0xe7, 0x9c, 0xfa,
+  0x71, 0x97, 0x09, 0xc6, 0x58, 0x06, 0x90, 0x6b, 0xca, 0xc6, 0x4f, 0x0f,
+  0xef, 0xd2, 0xfc, 0xde, 0x0e, 0xd3, 0x6c, 0x42, 0xd3, 0x3d, 0x78, 0xff,
+  0x98, 0x4a, 0x9e, 0x47, 0x17, 0xcb, 0xaa, 0x0c, 0x72, 0x4f, 0x65, 0xc7,
+  0xde, 0x0d, 0x8f, 0x9f, 0xe1, 0xf3, 0xaa, 0xaa, 0xb2, 0xb4, 0x8b, 0x81,
+  0xfb, 0xd6, 0xb6, 0x13, 0xfc, 0xc0, 0xd2, 0x9a, 0xf1, 0xfb, 0x68, 0xb6,
+  0xce, 0x0e, 0x01, 0xb9, 0x6d, 0x8d, 0x0d, 0x20, 0x71, 0x50, 0x2d, 0x19,
+  0x15, 0x1a, 0x7c, 0x01, 0x7e, 0xa1, 0xa9, 0xc0, 0xe8, 0x25, 0x86, 0xb5,
+  0xa0, 0x52, 0x81, 0x2f, 0xce, 0xfe, 0x6e, 0x2d, 0xbf, 0x1f, 0x5c, 0x00,
+  0x69, 0xcf, 0x93, 0x1d, 0x7f, 0xed, 0x4d, 0x63, 0x7f, 0x0e, 0xf7, 0x93,
+  0x8d, 0x87, 0x4d, 0xc1, 0xef, 0x51, 0x34, 0xa4, 0xf1, 0xbd, 0x1f, 0x6b,
+  0x7c, 0x29, 0x94, 0x51, 0x15, 0x9c, 0xe4, 0xdb, 0x76, 0xb2, 0x70, 0x67,
+  0x0c, 0x67, 0x90, 0x97, 0xbd, 0xa7, 0x13, 0x23, 0x2b, 0xcf, 0x1d, 0x0a,
+  0xa3, 0x19, 0xa6, 0xd6, 0x8f, 0x4f, 0x35, 0x4e, 0x6e, 0x6f, 0x82, 0xbd,
+  0x22, 0x0b, 0x4b, 0x44, 0xb8, 0x92, 0xd7, 0xf1, 0xa4, 0xd1, 0x36, 0x01,
+  0x1d, 0x17, 0xf6, 0x05, 0xb0, 0x04, 0x4f, 0x49, 0x2a, 0x80, 0xfc, 0xda,
+  0x28, 0xe8, 0x82, 0xd4, 0xe7, 0x5e, 0xad, 0xcb, 0x31, 0x26, 0x52, 0x09,
+  0x69, 0xad, 0xeb, 0x7b, 0xe0, 0xd7, 0x56, 0xf1, 0x83, 0x81, 0xf4, 0xe8,
+  0x1f, 0x2d, 0x68, 0x1a, 0xfb, 0xab, 0x4b, 0x73, 0x7d, 0x0a, 0x90, 0x48,
+  0xb4, 0x31, 0xfb, 0x1a, 0x4f, 0x7f, 0x9e, 0xcd, 0x68, 0xdf, 0xe2, 0xeb,
+  0x29, 0x11, 0x34, 0x4b, 0xb4, 0x57, 0xbc, 0x93, 0xde, 0xd6, 0x0f, 0x81,
+  0xb4, 0xe6, 0xc9, 0xf5, 0x70, 0xe2, 0x2f, 0x90, 0xb1, 0x86, 0xe6, 0x95,
+  0x8f, 0x64, 0x2c, 0xca, 0xd8, 0x9b, 0xd0, 0x21, 0xe8, 0xc5, 0x0f, 0x2e,
+  0x4b, 0x5a, 0x0a, 0xc4, 0x35, 0xa3, 0xb9, 0x6a, 0x08, 0xa7, 0x5c, 0x23,
+  0x46, 0x04, 0x15, 0x12, 0x8e, 0x20, 0x39, 0x65, 0x30, 0x57, 0xb0, 0xe8,
+  0x69, 0xa9, 0x69, 0xa9, 0x4c, 0x4e, 0xb9, 0x40, 0xc9, 0xa4, 0xb9, 0x43,
+  0x12, 0xaa, 0x20, 0x27, 0x6e, 0x93, 0xb8, 0x0f, 0xeb, 0x1c, 0x25, 0x13,
+  0xf7, 0x59, 0x04, 0xd0, 0x00, 0x2a, 0xf4, 0x2b, 0xb4, 0x02, 0x06, 0xbe,
+  0xed, 0xfd, 0x5c, 0xe3, 0x83, 0x9b, 0xdc, 0x43, 0x9f, 0x44, 0xbd, 0xf4,
+  0x20, 0x3e, 0xd8, 0x63, 0x20, 0x5b, 0xdb, 0xf8, 0xd1, 0x04, 0x78, 0x11,
+  0x49, 0xfc, 0x66, 0xf0, 0x83, 0xfd, 0x92, 0x76, 0xdc, 0xb0, 0x85, 0x66,
+  0x6d, 0xd8, 0xb2, 0x7a, 0xeb, 0x53, 0xca, 0x48, 0xb7, 0xf0, 0x41, 0x8d,
+  0xd2, 0xb4, 0x32, 0x8a, 0x96, 0x28, 0x7e, 0x17, 0x26, 0x92, 0xea, 0x12,
+  0xa4, 0x54, 0x6a, 0x91, 0xa2, 0x4d, 0x41, 0x8b, 0x02, 0x25, 0xb3, 0x48,
+  0x81, 0x60, 0x71, 0x96, 0xa2, 0x3f, 0x94, 0x97, 0x44, 0xfc, 0x67, 0x11,
+  0x05, 0x95, 0xd2, 0x54, 0x71, 0xfc, 0x92, 0x59, 0x88, 0x28, 0x5a, 0xe4,
+  0x48, 0x50, 0x55, 0x9e, 0x74, 0x94, 0x94, 0x71, 0x94, 0xcc, 0xa2, 0xa3,
+  0xa0, 0x4a, 0x41, 0x03, 0x73, 0x81, 0x4a, 0x54, 0x9e, 0x63, 0x15, 0x14,
+  0xe5, 0xf2, 0xad, 0x51, 0x9f, 0xc0, 0xc6, 0x2a, 0xcd, 0xff, 0xa9, 0xc6,
+  0x6c, 0xf7, 0x5e, 0x28, 0x08, 0x90, 0xa9, 0x5b, 0x85, 0xe8, 0x09, 0x4c,
+  0x0d, 0xe5, 0xb1, 0x47, 0x1c, 0xa8, 0x32, 0x45, 0x0a, 0xe0, 0x27, 0xbb,
+  0x38, 0x92, 0xea, 0x40, 0x73, 0xdd, 0x71, 0xa0, 0x97, 0x1f, 0x48, 0x74,
+  0x63, 0xb0, 0xe8, 0x49, 0x41, 0x20, 0x23, 0x16, 0x90, 0x54, 0x00, 0x00,
+  0x04, 0xe6, 0x97, 0xd0, 0x2a, 0xa2, 0x94, 0xf9, 0xeb, 0x53, 0xf4, 0x14,
+  0xd5, 0x3d, 0xdc, 0x57, 0x1c, 0xcb, 0x0a, 0xe0, 0x0a, 0x2a, 0xd4, 0xeb,
+  0xf9, 0xdd, 0x5d, 0xb6, 0x6d, 0xfb, 0xe1, 0x71, 0x71, 0x75, 0x66, 0x1b,
+  0xff, 0x31, 0x6f, 0x2f, 0xfe, 0x02, 0xdc, 0x6a, 0x94, 0x1e, 0xb2, 0x05,
+  0x00, 0x00
+};
+static const size_t k_logo_svg_br_len = 609;
+static const uint8_t k_logo_svg_br[] = {
+  0x1b, 0xb1, 0x05, 0x20, 0x9c, 0x85, 0xb1, 0x1b, 0xed, 0xa2, 0x30, 0x1d,
+  0xa4, 0x5b, 0xd3, 0xed, 0xad, 0x8d, 0x18, 0x18, 0x2a, 0x05, 0x9e, 0x6b,
+  0x73, 0xa9, 0x72, 0xa4, 0x89, 0x47, 0xf3, 0xb8, 0x90, 0xb1, 0x99, 0x3d,
+  0x33, 0x5f, 0xdd, 0x9b, 0x88, 0x5a, 0xf9, 0xe8, 0xda, 0xfa, 0x5d, 0xec,
+  0x1d, 0x02, 0x8a, 0xaa, 0x8a, 0x8f, 0xb1, 0x43, 0xc4, 0xff, 0xff, 0x2b,
+  0xd5, 0x8c, 0x65, 0xc4, 0xe6, 0x78, 0x04, 0x22, 0x18, 0xc2, 0xe4, 0xbe,
+  0xff, 0xb3, 0xee, 0x1b, 0x2d, 0xab, 0x86, 0xb4, 0x5c, 0xa1, 0x6a, 0x45,
+  0x0a, 0x58, 0xc6, 0x6a, 0x17, 0xf1, 0x1c, 0x2e, 0x56, 0xe1, 0x68, 0xcb,
+  0x62, 0x98, 0x97, 0xa8, 0x50, 0x55, 0xbb, 0xf1, 0x17, 0x59, 0x0e, 0xec,
+  0x4c, 0x62, 0xe1, 0xbb, 0x2f, 0x27, 0x5e, 0xd2, 0x85, 0xc7, 0x13, 0x7c,
+  0x3e, 0xc9, 0xf7, 0xdf, 0x68, 0xd2, 0x24, 0x49, 0x2c, 0xb3, 0xec, 0x8f,
+  0x95, 0xcf, 0xf7, 0x44, 0x15, 0x7c, 0xe4, 0x5f, 0xd7, 0x8f, 0xe5, 0x35,
+  0x94, 0xb8, 0x99, 0xfd, 0xc7, 0x77, 0x0f, 0xf5, 0xee, 0xef, 0x40, 0x21,
+  0x21, 0xa4, 0x09, 0x14, 0x84, 0xe4, 0x84, 0x15, 0xfc, 0xba, 0x46, 0x4c,
+  0xc7, 0xda, 0x83, 0x6b, 0x63, 0xe3, 0x97, 0xa9, 0x17, 0xaf, 0x6b, 0x74,
+  0xdb, 0x60, 0x8b, 0xc8, 0x5c, 0xc8, 0xaf, 0x3a, 0xb0, 0xf1, 0x39, 0xae,
+  0x98, 0x9a, 0x31, 0x25, 0x92, 0x62, 0x93, 0xa8, 0xe0, 0x91, 0xce, 0x30,
+  0xfa, 0xa4, 0x41, 0x7c, 0x42, 0xcb, 0x29, 0xa8, 0x3c, 0x4a, 0x7d, 0x12,
+  0x7f, 0x29, 0x94, 0xc2, 0x33, 0x56, 0x52, 0x4b, 0x4f, 0x81, 0xf6, 0xfd,
+  0x10, 0xf2, 0x03, 0x15, 0x66, 0xc5, 0x76, 0x3b, 0x85, 0x2b, 0x7e, 0xa8,
+  0x5d, 0xc0, 0x64, 0x47, 0xea, 0xcc, 0xd8, 0xe6, 0xe5, 0x59, 0xae, 0xb3,
+  0x71, 0xd4, 0x26, 0x06, 0xe6, 0xb0, 0x41, 0x8f, 0xd8, 0x12, 0xc1, 0x93,
+  0x8b, 0x6a, 0xeb, 0x37, 0xea, 0xe2, 0xdc, 0x88, 0x1c, 0x6e, 0x85, 0x2f,
+  0x4d, 0xc4, 0x92, 0xbe, 0x63, 0xd6, 0x76, 0x5d, 0x31, 0x89, 0x3e, 0x05,
+  0x0c, 0x91, 0x68, 0x4e, 0x52, 0x3a, 0x54, 0x29, 0x5f, 0xc1, 0x27, 0x0a,
+  0xaf, 0xaf, 0x2e, 0x36, 0x5e, 0xb0, 0x49, 0xb8, 0x8e, 0xcd, 0xea, 0x18,
+  0xdc, 0xba, 0xf5, 0xf7, 0xc1, 0x40, 0xf0, 0x79, 0xed, 0xb3, 0x88, 0x8a,
+  0xee, 0xe8, 0x46, 0x54, 0x3f, 0xa3, 0x29, 0x6b, 0x99, 0x91, 0x23, 0x2a,
+  0x24, 0x75, 0x41, 0x9c, 0x11, 0x2e, 0x26, 0x5b, 0x72, 0x46, 0x52, 0xa7,
+  0xf2, 0xc2, 0xf8, 0x25, 0x1d, 0xd1, 0xc9, 0xd9, 0x33, 0xf8, 0x5a, 0x7e,
+  0x44, 0x0a, 0xfa, 0x9c, 0x9a, 0xa0, 0xc6, 0x26, 0xe3, 0xdf, 0x73, 0x2c,
+  0xde, 0x68, 0x25, 0xa9, 0x09, 0xcb, 0x0b, 0x16, 0x48, 0xd1, 0x64, 0x85,
+  0x3a, 0xbc, 0xd8, 0x30, 0x8d, 0x04, 0xea, 0x8f, 0xe8, 0x42, 0xe7, 0x99,
+  0x41, 0x94, 0x4c, 0x2a, 0xf4, 0x0a, 0xe4, 0xb0, 0x04, 0x03, 0x84, 0x91,
+  0xcf, 0x25, 0x87, 0x19, 0x99, 0x88, 0x8d, 0x93, 0x86, 0x58, 0x1c, 0xad,
+  0xff, 0xb1, 0x21, 0x22, 0x79, 0x89, 0xa1, 0xab, 0x03, 0x2c, 0x6d, 0x44,
+  0x22, 0xfd, 0x4d, 0x7e, 0x65, 0x90, 0x02, 0xd5, 0x1e, 0x0a, 0x5c, 0x6c,
+  0xd2, 0x77, 0x74, 0xb9, 0x8a, 0x80, 0xae, 0x62, 0x5b, 0xa1, 0xe1, 0x2c,
+  0xac, 0xb3, 0x44, 0x93, 0xc1, 0x84, 0x91, 0x1c, 0xd5, 0xe4, 0x5e, 0xa9,
+  0x4d, 0x73, 0x9d, 0x05, 0x22, 0xc8, 0xe4, 0xb1, 0x4a, 0xa1, 0xe3, 0x78,
+  0x51, 0xf8, 0x4f, 0xcd, 0xaa, 0x47, 0x53, 0xc0, 0xfd, 0x6c, 0x15, 0x81,
+  0x30, 0xb9, 0x2c, 0xd3, 0x89, 0x30, 0x52, 0x64, 0xab, 0x52, 0x6a, 0x4c,
+  0xa1, 0x84, 0xc5, 0x3f, 0x0b, 0x64, 0xb2, 0xc2, 0x94, 0x9a, 0xda, 0x5b,
+  0x5c, 0x64, 0xf5, 0x7c, 0xb5, 0x92, 0x32, 0x10, 0xff, 0x6e, 0x49, 0x72,
+  0xc1, 0xee, 0x75, 0x95, 0x95, 0xe0, 0x5f, 0x5b, 0x08, 0x7d, 0x64, 0x98,
+  0x41, 0x9a, 0x04, 0x42, 0x8a, 0x99, 0x1c, 0xb4, 0xe0, 0xb7, 0x2c, 0x90,
+  0xfc, 0x86, 0xd5, 0xad, 0x28, 0xca, 0xbe, 0xd9, 0x05, 0x7f, 0x7b, 0x3c,
+  0x02, 0x09, 0x0c, 0x1c, 0x91, 0x15, 0x34, 0x9a, 0x19, 0x52, 0x8c, 0x45,
+  0x28, 0xd9, 0xf6, 0xff, 0xe4, 0xf8, 0x95, 0x44, 0x3d, 0x2a, 0xd2, 0xc8,
+  0xb1, 0xfc, 0x96, 0x03, 0x9a, 0xff, 0xa5, 0x1e, 0x8d, 0x3e, 0xb8, 0xbc,
+  0xfc, 0x3a, 0x91, 0x14, 0x18, 0x15, 0x4d, 0x67, 0x0c
+};
+static const size_t k_index_htm_prefix_len = 4245;
+static const uint32_t k_index_htm_prefix_crc = 0x10cfe6fe;
+static const size_t k_index_htm_prefix_gz_len = 1826;
+static const uint8_t k_index_htm_prefix_gz[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbc, 0x57,
+  0x6d, 0x6f, 0xdb, 0x38, 0x12, 0xfe, 0x2b, 0x2c, 0x83, 0x16, 0xd2, 0x46,
+  0x56, 0x6c, 0x27, 0x69, 0xbb, 0x52, 0x94, 0xbd, 0x6e, 0x9a, 0xbd, 0xed,
+  0xa2, 0x77, 0x2d, 0x9a, 0x7e, 0xb8, 0x43, 0x90, 0x0f, 0x94, 0x48, 0x59,
+  0xbc, 0xd0, 0xa2, 0x96, 0xa4, 0xec, 0xf8, 0xbc, 0xfa, 0xef, 0x3b, 0xa4,
+  0x5e, 0x2c, 0xe5, 0xe5, 0x80, 0xc3, 0x01, 0x87, 0x20, 0xb6, 0x35, 0x33,
+  0x9c, 0x79, 0xe6, 0x9d, 0xba, 0x78, 0xf5, 0xf1, 0xcb, 0xd5, 0xf7, 0x7f,
+  0x7e, 0xbd, 0x46, 0x85, 0x59, 0x8b, 0xcb, 0x0b, 0xfb, 0x89, 0x04, 0x29,
+  0x57, 0x09, 0x66, 0x25, 0x86, 0x67, 0x46, 0xe8, 0xe5, 0xc5, 0x9a, 0x19,
+  0x82, 0xb2, 0x82, 0x28, 0xcd, 0x4c, 0x82, 0x6b, 0x93, 0xcf, 0xde, 0xe3,
+  0x8e, 0x5a, 0x92, 0x35, 0x4b, 0xf0, 0x86, 0xb3, 0x6d, 0x25, 0x95, 0xc1,
+  0x28, 0x93, 0xa5, 0x61, 0x25, 0x48, 0x6d, 0x39, 0x35, 0x45, 0x42, 0xd9,
+  0x86, 0x67, 0x6c, 0xe6, 0x1e, 0x02, 0xc4, 0x4b, 0x6e, 0x38, 0x11, 0x33,
+  0x9d, 0x11, 0xc1, 0x92, 0x05, 0xe8, 0x10, 0xbc, 0xbc, 0x47, 0x8a, 0x89,
+  0x04, 0xeb, 0x02, 0xce, 0x67, 0xb5, 0x41, 0x1c, 0x54, 0x60, 0x64, 0x76,
+  0x15, 0xe8, 0xe5, 0x6b, 0xb2, 0x62, 0x27, 0x7a, 0xb3, 0x3a, 0x7e, 0x58,
+  0x0b, 0x8c, 0x0a, 0xc5, 0xf2, 0x04, 0x9f, 0x08, 0xb9, 0x92, 0x21, 0x10,
+  0x7f, 0xda, 0x24, 0x8c, 0xe5, 0xf9, 0x59, 0x76, 0x7e, 0xca, 0xde, 0xce,
+  0xc9, 0xe2, 0x5d, 0xf6, 0x16, 0x23, 0xcd, 0xff, 0xcd, 0x74, 0x82, 0x49,
+  0xb9, 0x03, 0xf5, 0xda, 0xec, 0x04, 0xbb, 0xb4, 0x4e, 0xed, 0x73, 0x00,
+  0x36, 0xcb, 0xc9, 0x9a, 0x8b, 0x5d, 0xf4, 0x4d, 0xa6, 0xd2, 0xc8, 0xe0,
+  0x57, 0x26, 0x36, 0xcc, 0xf0, 0x8c, 0x04, 0x1f, 0x14, 0xc0, 0x0a, 0x34,
+  0x29, 0xf5, 0x4c, 0x33, 0xc5, 0xf3, 0x18, 0x70, 0xb1, 0x59, 0xc1, 0xf8,
+  0xaa, 0x30, 0xd1, 0x22, 0x3c, 0x6f, 0xfe, 0xb2, 0x66, 0x94, 0x13, 0x6f,
+  0xcd, 0xcb, 0xd9, 0xd8, 0xa5, 0xe8, 0x6c, 0x3e, 0xaf, 0x1e, 0xfc, 0xfd,
+  0xd1, 0x56, 0x91, 0xaa, 0x62, 0x2a, 0xc8, 0xa5, 0x34, 0x4c, 0xed, 0x5b,
+  0xe6, 0xfb, 0xf9, 0xeb, 0x78, 0x4d, 0x1e, 0x3a, 0xd1, 0xc5, 0xdc, 0xca,
+  0x02, 0x41, 0xad, 0x78, 0x19, 0xcd, 0x11, 0xa9, 0x8d, 0x6c, 0x9a, 0x62,
+  0xd1, 0x22, 0xdb, 0xb6, 0xb6, 0x4e, 0xe7, 0xf3, 0xa9, 0xed, 0xc5, 0xfc,
+  0x75, 0x53, 0x2c, 0x83, 0xe2, 0x34, 0x28, 0xce, 0x26, 0x92, 0xa5, 0x54,
+  0x6b, 0x22, 0x9e, 0x0a, 0x57, 0x3d, 0x86, 0x4c, 0x0a, 0xa9, 0x22, 0xb5,
+  0x4a, 0x89, 0x37, 0x0f, 0xdc, 0x5f, 0xf8, 0x6e, 0xe1, 0x37, 0x82, 0xa4,
+  0x4c, 0xec, 0x29, 0xd7, 0x95, 0x20, 0xbb, 0x28, 0x15, 0x32, 0xbb, 0x6f,
+  0xba, 0x13, 0x4e, 0xbd, 0x8d, 0x5f, 0x14, 0xbe, 0x67, 0xeb, 0x86, 0x97,
+  0x55, 0x6d, 0x6e, 0x5d, 0x22, 0x0c, 0x7b, 0x30, 0x77, 0xc1, 0x88, 0x50,
+  0x11, 0xad, 0xb7, 0x52, 0xd1, 0x09, 0xb1, 0xac, 0xd7, 0x29, 0x53, 0x1d,
+  0x09, 0x00, 0x1a, 0xcf, 0xd1, 0xef, 0xfc, 0xa9, 0xb9, 0x2e, 0x04, 0x33,
+  0xc8, 0x81, 0x91, 0xeb, 0x68, 0xc1, 0xd6, 0xf1, 0x10, 0xa1, 0xd7, 0x71,
+  0x2a, 0x1f, 0x2c, 0x06, 0x5e, 0xae, 0xa2, 0x14, 0x0c, 0x30, 0x05, 0x72,
+  0x0f, 0x63, 0x2c, 0x69, 0x0d, 0xc7, 0xca, 0x89, 0x61, 0x5d, 0xa7, 0x6b,
+  0x0e, 0x00, 0x5b, 0x56, 0x40, 0xc2, 0xf6, 0xc7, 0xbe, 0x55, 0x10, 0xcd,
+  0xe3, 0x4e, 0x93, 0x22, 0x94, 0xd7, 0x3a, 0x5a, 0x42, 0x1a, 0x52, 0x92,
+  0xdd, 0xaf, 0x94, 0xac, 0x4b, 0x1a, 0x1d, 0x2d, 0xdf, 0x92, 0xb7, 0x3f,
+  0x92, 0xb8, 0x0d, 0xd8, 0xb6, 0xe0, 0x86, 0xc5, 0x59, 0xad, 0x34, 0x3c,
+  0x54, 0x92, 0x43, 0x39, 0xab, 0xf8, 0x10, 0x99, 0x45, 0xb8, 0x3c, 0x07,
+  0xc0, 0x93, 0xb0, 0x9f, 0xf7, 0xb0, 0x0b, 0x42, 0xe5, 0x76, 0x1a, 0xf2,
+  0xc5, 0x99, 0x8f, 0xe6, 0x08, 0x2c, 0xba, 0xff, 0x79, 0x30, 0x65, 0x2e,
+  0x2d, 0x73, 0x01, 0x8c, 0xf3, 0xa7, 0x4c, 0xc7, 0x3b, 0x05, 0xba, 0xe5,
+  0xcf, 0x2c, 0xe6, 0xff, 0xaa, 0x84, 0x9f, 0x09, 0x59, 0x54, 0xc8, 0x0d,
+  0xd4, 0xe8, 0xd3, 0xc0, 0x75, 0x8c, 0x47, 0xe1, 0x6b, 0xa9, 0xfb, 0x43,
+  0xa4, 0x66, 0x6d, 0x84, 0x8e, 0x96, 0x69, 0x9a, 0x12, 0x3a, 0x76, 0xb9,
+  0x05, 0x6a, 0xff, 0xe7, 0xe8, 0xb1, 0xfb, 0x41, 0xeb, 0xe1, 0xbb, 0x67,
+  0x98, 0x4b, 0xcb, 0x1c, 0x5c, 0xb4, 0x1f, 0x8f, 0x22, 0xd0, 0x84, 0x5a,
+  0xf0, 0xf5, 0xac, 0x4d, 0xdf, 0x7e, 0xa8, 0x07, 0x5b, 0x37, 0x7d, 0x57,
+  0xd9, 0x5c, 0x4e, 0xe8, 0xae, 0xe7, 0x23, 0x2d, 0x05, 0xa7, 0x3d, 0xc7,
+  0x8d, 0x91, 0xc8, 0xe6, 0x8c, 0xa8, 0xd9, 0xca, 0x56, 0x01, 0x8c, 0x28,
+  0xcf, 0x48, 0xa4, 0x6c, 0x02, 0xdb, 0xb0, 0x2f, 0x7e, 0x5c, 0x06, 0xc3,
+  0xbf, 0x3f, 0x49, 0x85, 0xef, 0xa3, 0xc5, 0xbc, 0x09, 0x73, 0x62, 0xfe,
+  0x13, 0x92, 0xd3, 0xff, 0x1f, 0x92, 0x2d, 0x51, 0x25, 0x34, 0x48, 0xd7,
+  0xe2, 0x47, 0xbf, 0xc0, 0xd0, 0x18, 0x8f, 0x86, 0x54, 0x0a, 0xda, 0x1c,
+  0xc1, 0x18, 0xcd, 0xf9, 0x2a, 0x87, 0x31, 0x31, 0xb4, 0x5f, 0x2e, 0x18,
+  0x54, 0x11, 0x7c, 0xcc, 0xec, 0xbc, 0x8a, 0xec, 0xc7, 0x58, 0xee, 0xf2,
+  0x87, 0xbd, 0x65, 0x46, 0x0b, 0x64, 0x3b, 0xb1, 0x39, 0xd2, 0x64, 0xc3,
+  0xdc, 0xf9, 0xb6, 0x8d, 0x80, 0xd8, 0xb7, 0xae, 0x91, 0x95, 0xeb, 0x5b,
+  0x27, 0xde, 0x8d, 0xb2, 0x23, 0x3b, 0x96, 0xf7, 0x7d, 0x4f, 0x0c, 0x4d,
+  0x6d, 0x79, 0xfd, 0x31, 0xe7, 0x64, 0xe4, 0x3a, 0xa8, 0xb9, 0x38, 0x69,
+  0x87, 0xf3, 0x85, 0xce, 0x14, 0xaf, 0xcc, 0xe5, 0xbf, 0xb4, 0x2c, 0x3f,
+  0x12, 0x43, 0x12, 0x4c, 0xe1, 0x33, 0xb4, 0x8f, 0x38, 0xce, 0xeb, 0x32,
+  0x33, 0x5c, 0x96, 0x48, 0x48, 0x42, 0x3d, 0x1f, 0x1c, 0x2e, 0x21, 0x9c,
+  0x2c, 0x04, 0x53, 0x1e, 0xbe, 0xd6, 0xd5, 0xe9, 0xf2, 0x93, 0x34, 0x3f,
+  0x13, 0xcd, 0x9c, 0x00, 0xa3, 0xd8, 0x8f, 0x79, 0xee, 0x51, 0x99, 0xd5,
+  0x6b, 0x88, 0x6b, 0x98, 0x4a, 0xba, 0x0b, 0x0b, 0xa2, 0x3f, 0x18, 0xa3,
+  0x38, 0x14, 0x35, 0xf3, 0x9c, 0x72, 0xdb, 0x20, 0x50, 0xd9, 0x8a, 0x95,
+  0xe0, 0x96, 0x3d, 0xe4, 0xef, 0x15, 0x33, 0xb5, 0x2a, 0x9b, 0x0d, 0x51,
+  0x88, 0x25, 0xc3, 0xf9, 0x15, 0x33, 0xd7, 0x82, 0xd9, 0x9f, 0x3f, 0xef,
+  0x3e, 0x51, 0x0f, 0x77, 0xfb, 0xcb, 0xea, 0x68, 0x2d, 0xb1, 0x37, 0x6f,
+  0x58, 0x68, 0x87, 0xe3, 0x55, 0xbb, 0xf6, 0xfc, 0x7d, 0x5a, 0x73, 0x41,
+  0x6f, 0x60, 0x84, 0x78, 0xbf, 0xdd, 0x7c, 0xf9, 0x7b, 0x58, 0xd9, 0x9d,
+  0xe9, 0x4d, 0x65, 0x42, 0xd6, 0xea, 0xd4, 0x7e, 0x3c, 0x32, 0x9b, 0x26,
+  0x25, 0xdb, 0xa2, 0x7f, 0xfc, 0xed, 0xf3, 0xaf, 0xc6, 0x54, 0xdf, 0xd8,
+  0xef, 0x35, 0xd3, 0xc6, 0xf3, 0x0f, 0x11, 0xc8, 0xc0, 0x7d, 0x2b, 0x47,
+  0x93, 0x91, 0x62, 0x53, 0x70, 0x1d, 0x2a, 0xa6, 0x2b, 0x88, 0x0b, 0xfb,
+  0x0e, 0x36, 0xfc, 0xf8, 0x00, 0x80, 0x1e, 0x0c, 0x35, 0x83, 0x1a, 0xe2,
+  0xd1, 0x47, 0x61, 0xfc, 0x2c, 0xe5, 0xbd, 0x46, 0x82, 0xdf, 0x33, 0x64,
+  0x0a, 0x88, 0x07, 0xda, 0x12, 0x8d, 0x08, 0xaa, 0x94, 0x4c, 0xe1, 0x78,
+  0x88, 0x6e, 0x0c, 0x31, 0xb5, 0x46, 0x57, 0x92, 0xb2, 0x08, 0xe1, 0xe3,
+  0x34, 0xd4, 0x8e, 0xe0, 0xc7, 0x84, 0xd2, 0x2e, 0x3a, 0xdf, 0xe5, 0x47,
+  0xb9, 0xf6, 0x70, 0xb1, 0xc0, 0x01, 0x86, 0xb8, 0x4a, 0x05, 0xdf, 0x57,
+  0xb2, 0x16, 0x14, 0xc1, 0x12, 0x70, 0xa9, 0x41, 0x6d, 0x95, 0xd5, 0x8a,
+  0x58, 0x14, 0x63, 0x3d, 0xc1, 0xbe, 0x6d, 0x13, 0xdc, 0xed, 0x2b, 0xc8,
+  0x47, 0x33, 0x04, 0x26, 0x0d, 0xad, 0x91, 0x0d, 0x98, 0xf8, 0xcc, 0x35,
+  0x04, 0x8f, 0x29, 0x0f, 0x5b, 0x75, 0x38, 0xc8, 0xc0, 0xd3, 0x67, 0x98,
+  0x9d, 0x75, 0x62, 0xb9, 0xb2, 0x62, 0xa5, 0x87, 0xff, 0x7a, 0xfd, 0x1d,
+  0x07, 0x7d, 0x71, 0x59, 0xb2, 0x86, 0xb4, 0x7b, 0xa3, 0x88, 0xf4, 0xc8,
+  0x58, 0xe7, 0x8c, 0x47, 0xfc, 0xbd, 0xde, 0x72, 0x93, 0x15, 0x1e, 0xe9,
+  0x23, 0x08, 0x21, 0x83, 0x22, 0xc3, 0x6e, 0x72, 0xe2, 0x08, 0x12, 0x4f,
+  0xc2, 0xac, 0xcf, 0xb8, 0x5b, 0xa8, 0x9f, 0x68, 0x82, 0xdd, 0x0f, 0xe8,
+  0x17, 0x7c, 0x4c, 0x42, 0xe8, 0x78, 0xf7, 0x68, 0x2b, 0x2f, 0xd9, 0x63,
+  0x4b, 0x8d, 0x2c, 0xb5, 0x79, 0x1a, 0x35, 0x27, 0x87, 0x83, 0x4e, 0x4d,
+  0x30, 0x68, 0x0e, 0x06, 0x05, 0x40, 0x83, 0x74, 0x5b, 0x63, 0x4f, 0x4f,
+  0xb7, 0x90, 0x02, 0xab, 0x3b, 0xc0, 0xf6, 0x9b, 0xf4, 0xb5, 0xae, 0x03,
+  0x7c, 0x84, 0x8f, 0x3b, 0xb5, 0x7e, 0xc3, 0x84, 0x66, 0xfb, 0xc7, 0xc7,
+  0x07, 0x07, 0x5b, 0x05, 0x07, 0xdb, 0x13, 0x3d, 0x83, 0xf9, 0x26, 0x55,
+  0x8c, 0xdc, 0xc7, 0x94, 0xe5, 0xa4, 0x16, 0x26, 0xfa, 0x1f, 0xb5, 0xc5,
+  0x4e, 0x5b, 0x33, 0xaa, 0xcd, 0x47, 0xfa, 0xd2, 0x80, 0x04, 0xac, 0xad,
+  0xfa, 0x3c, 0x81, 0x09, 0xe2, 0x9a, 0x52, 0x87, 0x82, 0x95, 0x2b, 0x53,
+  0x5c, 0x9e, 0xbe, 0x79, 0x33, 0xd0, 0x6e, 0x4f, 0xef, 0x5e, 0x25, 0x09,
+  0xac, 0x28, 0x96, 0xc3, 0x68, 0xa5, 0x3f, 0x8d, 0x19, 0xd1, 0xbe, 0x89,
+  0xad, 0x8a, 0xd5, 0x41, 0xc5, 0xed, 0xd9, 0x9d, 0x23, 0x65, 0x2f, 0xb6,
+  0x3a, 0x71, 0xed, 0xfd, 0x2a, 0x83, 0xc4, 0x1f, 0x64, 0x32, 0xc0, 0x6b,
+  0x86, 0x32, 0x49, 0xfd, 0xc6, 0x4e, 0x00, 0x90, 0x18, 0x77, 0x77, 0xc2,
+  0x2c, 0x95, 0x58, 0x2a, 0x5c, 0x96, 0x47, 0x83, 0x87, 0x53, 0x5b, 0x96,
+  0xcd, 0x98, 0xa8, 0xbd, 0x2c, 0xc8, 0xfd, 0xb8, 0xed, 0xea, 0xc1, 0x0a,
+  0x74, 0xbe, 0xda, 0xdd, 0x40, 0x24, 0x33, 0x23, 0x95, 0xb7, 0x6a, 0x81,
+  0x40, 0xd3, 0xbe, 0x28, 0x82, 0xfb, 0xdb, 0x27, 0xf6, 0x1b, 0x1a, 0xda,
+  0x5f, 0x25, 0xbd, 0x2a, 0x60, 0x0a, 0x78, 0xd9, 0xa8, 0xcc, 0x1f, 0x1b,
+  0x06, 0x88, 0x50, 0x95, 0x9e, 0x1b, 0x3d, 0x70, 0x31, 0x47, 0xf0, 0x6c,
+  0x81, 0xdf, 0xa6, 0x77, 0x4f, 0xb0, 0x43, 0x1e, 0x2c, 0xb9, 0x19, 0xa5,
+  0xea, 0x30, 0x65, 0xb2, 0x36, 0x41, 0x69, 0x72, 0x80, 0x11, 0x8f, 0xe7,
+  0x0b, 0x34, 0x2a, 0x5c, 0xa9, 0x04, 0x08, 0xf6, 0x89, 0x9b, 0xf7, 0x83,
+  0xec, 0xf6, 0x2e, 0xee, 0x21, 0x90, 0x64, 0x1e, 0x93, 0x8b, 0x5e, 0x24,
+  0x26, 0xc7, 0xc7, 0x0e, 0x4e, 0x76, 0x4b, 0xee, 0xba, 0x72, 0x49, 0x92,
+  0x14, 0x62, 0x10, 0x56, 0xb5, 0x2e, 0x1c, 0xd9, 0x8f, 0x01, 0x65, 0x25,
+  0xe0, 0x2a, 0xee, 0x11, 0x58, 0x93, 0x43, 0x31, 0x4d, 0x14, 0xd2, 0x89,
+  0xc2, 0x27, 0x9d, 0x4e, 0xad, 0x1e, 0x9b, 0xaf, 0x31, 0xb6, 0x34, 0xc9,
+  0x6e, 0xe7, 0xbd, 0xd5, 0xb1, 0xcf, 0x30, 0xa0, 0x6c, 0xc4, 0xaf, 0xc6,
+  0x93, 0xac, 0x1b, 0xca, 0x99, 0x1b, 0xde, 0xbf, 0xc0, 0xae, 0xb4, 0x53,
+  0x06, 0xc6, 0xf6, 0x64, 0xdc, 0x75, 0xe6, 0x74, 0x32, 0x5d, 0x4c, 0x93,
+  0x2c, 0x7e, 0x10, 0xc2, 0xc3, 0x3f, 0xdc, 0xba, 0xf5, 0xd4, 0x1e, 0xbe,
+  0x67, 0xbb, 0x3b, 0xd8, 0x32, 0xbd, 0x43, 0x34, 0x79, 0x56, 0x67, 0x07,
+  0x7c, 0xb6, 0x88, 0xe9, 0x25, 0xb8, 0x4c, 0x67, 0xb3, 0x16, 0x51, 0xf1,
+  0xbc, 0xf8, 0x2d, 0xbd, 0xb3, 0xa5, 0xfe, 0x78, 0x21, 0x0e, 0x16, 0x71,
+  0x5b, 0x8e, 0xe4, 0xe5, 0xd3, 0x1b, 0x22, 0x6a, 0x16, 0xb7, 0x8b, 0xf2,
+  0x45, 0x21, 0x77, 0xb9, 0x4c, 0x12, 0xdc, 0xbf, 0x26, 0x60, 0x5b, 0xc4,
+  0x2f, 0x4a, 0x4f, 0x37, 0xb4, 0x82, 0xdd, 0xc7, 0xdd, 0x5a, 0x86, 0x06,
+  0x07, 0x1d, 0xd8, 0xdf, 0xc3, 0xdb, 0xa2, 0x32, 0x1e, 0xfe, 0x2a, 0x98,
+  0x5d, 0xf5, 0x39, 0x17, 0x02, 0x49, 0x78, 0x53, 0x24, 0xf0, 0xdd, 0x4b,
+  0x23, 0x87, 0x4b, 0xe3, 0x61, 0x75, 0xd8, 0xae, 0x61, 0x7f, 0xfc, 0x41,
+  0x46, 0x99, 0xcd, 0xba, 0xe6, 0xf0, 0x0a, 0xdb, 0x89, 0x4d, 0x3b, 0x57,
+  0x9e, 0xdf, 0xba, 0x2f, 0xee, 0x9d, 0xd5, 0xf3, 0xcc, 0x6e, 0xef, 0xa4,
+  0x96, 0xdb, 0xee, 0x9d, 0xaf, 0x5f, 0x6e, 0x60, 0xf1, 0xe0, 0x93, 0xf6,
+  0x8a, 0xdd, 0xfa, 0x8e, 0xfd, 0x49, 0x6b, 0xe0, 0x1b, 0x00, 0x03, 0xf7,
+  0xb8, 0xe9, 0x72, 0xb4, 0x39, 0x6f, 0x97, 0x54, 0x36, 0x5a, 0xff, 0xa9,
+  0x37, 0x84, 0x61, 0x52, 0x80, 0x70, 0xb6, 0xdf, 0xb3, 0x29, 0x43, 0xf6,
+  0xc6, 0x06, 0x81, 0x3b, 0xd4, 0xec, 0xea, 0xa5, 0x63, 0x4e, 0x12, 0xe9,
+  0x3a, 0xcb, 0x98, 0xd6, 0x79, 0x2d, 0xc4, 0x2e, 0x44, 0xdf, 0x58, 0x0a,
+  0x2f, 0x82, 0x00, 0x28, 0x04, 0x15, 0xcd, 0x96, 0x97, 0x70, 0xb5, 0x0f,
+  0x65, 0x69, 0x1d, 0x4f, 0x7a, 0x8d, 0xa0, 0xaf, 0xbd, 0x8b, 0x35, 0x31,
+  0xdc, 0xe0, 0xda, 0xab, 0xdb, 0x85, 0xe1, 0x46, 0x30, 0xc4, 0x61, 0x07,
+  0xba, 0x5f, 0xf8, 0xf2, 0xfa, 0xe6, 0xeb, 0xe9, 0xf2, 0xe2, 0xc4, 0x3d,
+  0xf5, 0x37, 0x3c, 0xc7, 0x1f, 0xdf, 0xa0, 0xba, 0x77, 0x7c, 0xc8, 0x09,
+  0x74, 0xb1, 0x43, 0x75, 0xe2, 0x6e, 0x7d, 0x97, 0x7f, 0x02, 0x00, 0x00,
+  0xff, 0xff
 };
+static const size_t k_index_htm_suffix_len = 71;
+static const uint8_t k_index_htm_suffix[] = {
+  0x3c, 0x2f, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3e, 0x3c, 0x2f, 0x68,
+  0x65, 0x61, 0x64, 0x3e, 0x3c, 0x62, 0x6f, 0x64, 0x79, 0x20, 0x69, 0x64,
+  0x3d, 0x22, 0x62, 0x6f, 0x64, 0x79, 0x22, 0x3e, 0x3c, 0x64, 0x69, 0x76,
+  0x20, 0x69, 0x64, 0x3d, 0x22, 0x77, 0x72, 0x61, 0x70, 0x70, 0x65, 0x72,
+  0x22, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x3c, 0x2f, 0x62, 0x6f,
+  0x64, 0x79, 0x3e, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a
+};
+
+#define INTERNAL_FILES_BUNDLED_PAGE
+static constexpr InternalBundledPage kInternalBundledPage = { "/", k_index_htm_prefix_gz, k_index_htm_prefix_gz_len, k_index_htm_prefix_len, k_index_htm_prefix_crc, k_index_htm_suffix, k_index_htm_suffix_len };
+
+static constexpr InternalFile kInternalFiles[] = {
+    { "/esp32iotbase.css", "text/css", k_esp32iotbase_css_len, k_esp32iotbase_css_hash, k_esp32iotbase_css_gz, k_esp32iotbase_css_gz_len, k_esp32iotbase_css_br, k_esp32iotbase_css_br_len },
+    { "/esp32iotbase.js", "text/javascript", k_esp32iotbase_js_len, k_esp32iotbase_js_hash, k_esp32iotbase_js_gz, k_esp32iotbase_js_gz_len, k_esp32iotbase_js_br, k_esp32iotbase_js_br_len },
+    { "/logo.svg", "image/svg+xml", k_logo_svg_len, k_logo_svg_hash, k_logo_svg_gz, k_logo_svg_gz_len, k_logo_svg_br, k_logo_svg_br_len },
+};
+
+static constexpr size_t kInternalFilesBuckets = 5;
+// bucket (hash % kInternalFilesBuckets) -> index in kInternalFiles, -1 if empty
+static constexpr int8_t kInternalFilesIndex[kInternalFilesBuckets] = { 2, 0, 1, -1, -1, };
+
+static_assert(kInternalFilesIndex[InternalFilesHash("/esp32iotbase.css") % kInternalFilesBuckets] == 0, "Hash mismatch for /esp32iotbase.css");
+static_assert(kInternalFilesIndex[InternalFilesHash("/esp32iotbase.js") % kInternalFilesBuckets] == 1, "Hash mismatch for /esp32iotbase.js");
+static_assert(kInternalFilesIndex[InternalFilesHash("/logo.svg") % kInternalFilesBuckets] == 2, "Hash mismatch for /logo.svg");
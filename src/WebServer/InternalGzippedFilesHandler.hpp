@@ -1,47 +1,254 @@
 #pragma once
 
 #include <ESPAsyncWebServer.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+#include <rom/crc.h>
+#include <rom/miniz.h>
 #include "InternalGzippedFilesContent.hpp"
+#include "CachedJsonHandler.hpp"
+#include "ResponseSegments.hpp"
 
 
 class InternalGzippedFilesHandler : public AsyncWebHandler {
     public:
+        // pageDataFunc: returns the data.json content to embed into the bundled page (if there is one, see data2header.sh --bundle)
+        InternalGzippedFilesHandler(std::function<std::shared_ptr<const CachedJson>()> pageDataFunc = nullptr)
+            : pageDataFunc_(pageDataFunc)
+        {
+        }
+
         bool canHandle(AsyncWebServerRequest *request) {
-            return (request->method() == HTTP_GET && (request->url() == "/" ||
-                                                      request->url() == "/esp32iotbase.css" ||
-                                                      request->url() == "/esp32iotbase.js" ||
-                                                      request->url() == "/logo.svg"));
+            bool result = request->method() == HTTP_GET && (findFile_(request->url()) != nullptr || isBundledPage_(request->url()));
+            if (result) {
+                // ESPAsyncWebServer drops all headers not asked for
+                request->addInterestingHeader("If-None-Match");
+                request->addInterestingHeader("Accept-Encoding");
+            }
+            return result;
         }
 
         void handleRequest(AsyncWebServerRequest *request) {
-            
-            String contentType;
-            size_t contentLength;
-            const uint8_t * content;
-            if (request->url() == "/") {
-                contentType = "text/html";
-                contentLength = k_index_htm_gz_len;
-                content = k_index_htm_gz;
-            } else if (request->url() == "/esp32iotbase.css") {
-                contentType = "text/css";
-                contentLength = k_esp32iotbase_css_gz_len;
-                content = k_esp32iotbase_css_gz;
-            } else if (request->url() == "/esp32iotbase.js") {
-                contentType = "text/javascript";
-                contentLength = k_esp32iotbase_js_gz_len;
-                content = k_esp32iotbase_js_gz;
-            } else if (request->url() == "/logo.svg") {
-                contentType = "image/svg+xml";
-                contentLength = k_logo_svg_gz_len;
-                content = k_logo_svg_gz;
-            } else {
+
+            #ifdef INTERNAL_FILES_BUNDLED_PAGE
+                if (isBundledPage_(request->url())) {
+                    sendBundledPage_(request);
+                    return;
+                }
+            #endif
+
+            const InternalFile* file = findFile_(request->url());
+            if (!file) {
                 // should not happen
                 request->send(404);
                 return;
             }
-            
-            AsyncWebServerResponse *response = request->beginResponse_P(200, contentType, content, contentLength);
-            response->addHeader("Content-Encoding", "gzip");
+
+            // pick the smallest variant the client accepts
+            String acceptEncoding = request->hasHeader("Accept-Encoding") ? request->header("Accept-Encoding") : String();
+            const char * encoding = nullptr;
+            if (file->brotliContent && acceptsEncoding_(acceptEncoding, "br")) {
+                encoding = "br";
+            } else if (!request->hasHeader("Accept-Encoding") || acceptsEncoding_(acceptEncoding, "gzip")) {
+                // no header at all means no preference
+                encoding = "gzip";
+            }
+
+            // every representation needs its own strong ETag
+            String etag = String("\"") + file->hash + (encoding ? String("-") + encoding : String()) + "\"";
+            // references carrying the matching content hash (see data2header.sh) will never change
+            const char * cacheControl = "no-cache";
+            if (request->hasParam("v") && request->getParam("v")->value() == file->hash) {
+                cacheControl = "public, max-age=31536000, immutable";
+            }
+
+            AsyncWebServerResponse *response = nullptr;
+            if (request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf(etag) >= 0) {
+                response = request->beginResponse(304);
+            } else if (encoding && strcmp(encoding, "br") == 0) {
+                response = request->beginResponse_P(200, file->contentType, file->brotliContent, file->brotliLength);
+                response->addHeader("Content-Encoding", encoding);
+            } else if (!encoding) {
+                response = beginInflatedResponse_(request, file);
+            }
+            if (!response) {
+                // also used if inflating failed, nearly every client accepts gzip anyway
+                response = request->beginResponse_P(200, file->contentType, file->gzipContent, file->gzipLength);
+                response->addHeader("Content-Encoding", "gzip");
+                etag = String("\"") + file->hash + "-gzip\"";
+            }
+            response->addHeader("ETag", etag);
+            response->addHeader("Cache-Control", cacheControl);
+            response->addHeader("Vary", "Accept-Encoding");
             request->send(response);
         }
+
+    private:
+        std::function<std::shared_ptr<const CachedJson>()> pageDataFunc_;
+
+        // perfect hash generated by data2header.sh, so there is at most one candidate to compare
+        static const InternalFile* findFile_(const String &url) {
+            int8_t index = kInternalFilesIndex[InternalFilesHash(url.c_str()) % kInternalFilesBuckets];
+            if (index < 0 || strcmp(kInternalFiles[index].path, url.c_str()) != 0)
+                return nullptr;
+            return &kInternalFiles[index];
+        }
+
+        // checks for the coding in a header like "gzip, deflate;q=0.5, br;q=0"
+        static bool acceptsEncoding_(const String &acceptEncoding, const char* coding) {
+            int start = 0;
+            while (start < static_cast<int>(acceptEncoding.length())) {
+                int end = acceptEncoding.indexOf(',', start);
+                if (end < 0)
+                    end = acceptEncoding.length();
+                String entry = acceptEncoding.substring(start, end);
+                int parameters = entry.indexOf(';');
+                String name = parameters >= 0 ? entry.substring(0, parameters) : entry;
+                name.trim();
+                if (name.equalsIgnoreCase(coding) || name == "*") {
+                    if (parameters < 0)
+                        return true;
+                    int quality = entry.indexOf("q=", parameters);
+                    return quality < 0 || entry.substring(quality + 2).toFloat() > 0;
+                }
+                start = end + 1;
+            }
+            return false;
+        }
+
+        static bool isBundledPage_(const String &url) {
+            #ifdef INTERNAL_FILES_BUNDLED_PAGE
+                return url == kInternalBundledPage.path;
+            #else
+                return false;
+            #endif
+        }
+
+        #ifdef INTERNAL_FILES_BUNDLED_PAGE
+        // Sends prefix + data.json + suffix as one page. For gzip the prefix comes precompressed from flash,
+        // data and suffix follow uncompressed as stored deflate blocks, so nothing needs to be compressed at runtime.
+        // The data chunks are sent from the cache as they are, without copying them into one buffer.
+        void sendBundledPage_(AsyncWebServerRequest *request) {
+            const InternalBundledPage &page = kInternalBundledPage;
+            // without any data the page falls back to requesting /data.json
+            std::shared_ptr<const CachedJson> data = pageDataFunc_ ? pageDataFunc_() : nullptr;
+            std::shared_ptr<ResponseSegments> segments = std::make_shared<ResponseSegments>();
+            if (data)
+                segments->Keep(data);
+
+            bool gzip = !request->hasHeader("Accept-Encoding") || acceptsEncoding_(request->header("Accept-Encoding"), "gzip");
+            std::shared_ptr<uint8_t> inflatedPrefix;
+            if (!gzip)
+                inflatedPrefix = inflate_(page.gzipPrefix, page.gzipPrefixLength, page.prefixLength, false);
+
+            if (inflatedPrefix) {
+                segments->Keep(inflatedPrefix);
+                segments->Add(inflatedPrefix.get(), page.prefixLength);
+                if (data)
+                    for (const String &chunk : data->chunks)
+                        segments->Add(chunk);
+                segments->Add(page.suffix, page.suffixLength);
+            } else {
+                // also used if inflating failed
+                segments->Add(page.gzipPrefix, page.gzipPrefixLength);
+                uint32_t crc = page.prefixCrc;
+                size_t length = page.prefixLength;
+                if (data) {
+                    for (const String &chunk : data->chunks) {
+                        addStoredBlocks_(*segments, reinterpret_cast<const uint8_t*>(chunk.c_str()), chunk.length(), false);
+                        crc = crc32_le(crc, reinterpret_cast<const uint8_t*>(chunk.c_str()), chunk.length());
+                    }
+                    length += data->length;
+                }
+                addStoredBlocks_(*segments, page.suffix, page.suffixLength, true);
+                crc = crc32_le(crc, page.suffix, page.suffixLength);
+                length += page.suffixLength;
+
+                uint8_t trailer[8];
+                for (int shift = 0; shift < 32; shift += 8) {
+                    trailer[shift / 8] = static_cast<uint8_t>(crc >> shift);
+                    trailer[4 + shift / 8] = static_cast<uint8_t>(length >> shift);
+                }
+                segments->AddCopy(trailer, sizeof(trailer));
+            }
+
+            AsyncWebServerResponse *response = ResponseSegments::BeginResponse(request, "text/html", segments);
+            if (!inflatedPrefix)
+                response->addHeader("Content-Encoding", "gzip");
+            // contains the current configuration
+            response->addHeader("Cache-Control", "no-store");
+            response->addHeader("Vary", "Accept-Encoding");
+            request->send(response);
+        }
+
+        // continues a (byte aligned) deflate stream with the given data as stored block(s)
+        static void addStoredBlocks_(ResponseSegments &segments, const uint8_t* data, size_t length, bool final) {
+            const size_t kMaxStoredBlockLength = 65535;
+            size_t offset = 0;
+            do {
+                uint16_t blockLength = std::min(length - offset, kMaxStoredBlockLength);
+                // BFINAL + BTYPE 00 (stored), padding to the byte boundary, LEN, NLEN
+                uint8_t header[] = { static_cast<uint8_t>(final && offset + blockLength == length ? 1 : 0),
+                                     static_cast<uint8_t>(blockLength), static_cast<uint8_t>(blockLength >> 8),
+                                     static_cast<uint8_t>(~blockLength), static_cast<uint8_t>(~blockLength >> 8) };
+                segments.AddCopy(header, sizeof(header));
+                segments.Add(data + offset, blockLength);
+                offset += blockLength;
+            } while (offset < length);
+        }
+        #endif
+
+        // for the rare clients not accepting any compression: inflate the gzip variant into a temporary buffer
+        static AsyncWebServerResponse* beginInflatedResponse_(AsyncWebServerRequest *request, const InternalFile* file) {
+            std::shared_ptr<uint8_t> inflated = inflate_(file->gzipContent, file->gzipLength, file->length, true);
+            if (!inflated)
+                return nullptr;
+            std::shared_ptr<ResponseSegments> segments = std::make_shared<ResponseSegments>();
+            segments->Keep(inflated);
+            segments->Add(inflated.get(), file->length);
+            return ResponseSegments::BeginResponse(request, file->contentType, segments);
+        }
+
+        // final == false: the deflate stream is incomplete (bundled page prefix)
+        static std::shared_ptr<uint8_t> inflate_(const uint8_t* gzip, size_t gzipLength, size_t length, bool final) {
+            size_t headerLength = gzipHeaderLength_(gzip, gzipLength);
+            if (!headerLength)
+                return nullptr;
+
+            std::unique_ptr<tinfl_decompressor> decompressor(new (std::nothrow) tinfl_decompressor);
+            std::shared_ptr<uint8_t> inflated((uint8_t*) malloc(length), free);
+            if (!decompressor || !inflated)
+                return nullptr;
+
+            tinfl_init(decompressor.get());
+            size_t inLength = gzipLength - headerLength;
+            size_t outLength = length;
+            tinfl_status status = tinfl_decompress(decompressor.get(), gzip + headerLength, &inLength, inflated.get(), inflated.get(), &outLength,
+                                                   TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF | (final ? 0 : TINFL_FLAG_HAS_MORE_INPUT));
+            bool complete = status == TINFL_STATUS_DONE || (!final && status == TINFL_STATUS_NEEDS_MORE_INPUT);
+            if (!complete || outLength != length)
+                return nullptr;
+            return inflated;
+        }
+
+        // returns 0 for invalid headers
+        static size_t gzipHeaderLength_(const uint8_t* gzip, size_t length) {
+            const uint8_t kFlagHeaderCrc = 0x02, kFlagExtra = 0x04, kFlagName = 0x08, kFlagComment = 0x10;
+            if (length < 18 || gzip[0] != 0x1f || gzip[1] != 0x8b || gzip[2] != 8)
+                return 0;
+
+            uint8_t flags = gzip[3];
+            size_t position = 10;
+            if (flags & kFlagExtra)
+                position += 2 + (gzip[position] | (gzip[position + 1] << 8));
+            if (flags & kFlagName)
+                while (position < length && gzip[position++] != 0);
+            if (flags & kFlagComment)
+                while (position < length && gzip[position++] != 0);
+            if (flags & kFlagHeaderCrc)
+                position += 2;
+            return position < length ? position : 0;
+        }
 };
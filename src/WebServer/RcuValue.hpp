@@ -0,0 +1,139 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <utility>
+
+
+// Read-copy-update for a value that is read far more often than it gets changed (e.g. the UI model):
+// Readers pin the current version with nothing but atomic operations (no locks, no allocations), writers modify a copy
+// and publish it. A version gets freed as soon as it has been superseded and its last reader has unpinned it (by
+// whoever comes last), so writers never wait for readers and a version may be kept for as long as needed (e.g. during
+// a slow response).
+// Versions live in nodes that are reused but never freed (there are only as many as versions have been pinned at the
+// same time), so a reader racing a writer may safely touch a node that no longer holds the current version.
+template<typename T>
+class RcuValue {
+    private:
+        struct Node;
+
+    public:
+        // keeps a version alive, may be copied (e.g. into the lambdas of a chunked response)
+        class Pin {
+            public:
+                Pin(const Pin &other) : node_(other.node_) {
+                    if (node_)
+                        node_->readers.fetch_add(1);
+                }
+                Pin(Pin &&other) noexcept : node_(other.node_) {
+                    other.node_ = nullptr;
+                }
+                Pin& operator=(Pin other) noexcept {
+                    std::swap(node_, other.node_);
+                    return *this;
+                }
+                ~Pin() {
+                    if (node_)
+                        unpin_(node_);
+                }
+
+                const T& operator*() const {
+                    return *node_->value;
+                }
+                const T* operator->() const {
+                    return node_->value;
+                }
+
+            private:
+                friend class RcuValue;
+                explicit Pin(Node* node) : node_(node) {}
+                Node* node_;
+        };
+
+        RcuValue() {
+            Node* node = new Node();
+            node->value = new T();
+            node->state = kCurrent;
+            nodes_ = node;
+            current_ = node;
+        }
+        RcuValue(const RcuValue&) = delete;
+        RcuValue& operator=(const RcuValue&) = delete;
+        // there must not be any pins left
+        ~RcuValue() {
+            while (nodes_) {
+                Node* next = nodes_->next;
+                delete nodes_->value;
+                delete nodes_;
+                nodes_ = next;
+            }
+        }
+
+        Pin Read() const {
+            while (true) {
+                Node* node = current_.load();
+                node->readers.fetch_add(1);
+                // otherwise the node has been superseded (and maybe even reused) meanwhile
+                if (current_.load() == node)
+                    return Pin(node);
+                unpin_(node);
+            }
+        }
+
+        // Writers have to be serialized by the caller. func gets a copy of the current version to modify.
+        template<typename Func> void Update(Func func) {
+            // only writers supersede the current version, so it cannot go away here
+            Node* previous = current_.load();
+            T* value = new T(*previous->value);
+            func(*value);
+
+            Node* node = getFreeNode_();
+            node->value = value;
+            node->state = kCurrent;
+            current_ = node;
+
+            // freed right away unless there are readers left, the last of them frees it then
+            previous->state = kSuperseded;
+            if (previous->readers.load() == 0)
+                free_(previous);
+        }
+
+    private:
+        enum : uint8_t { kFree, kCurrent, kSuperseded, kFreeing };
+
+        struct Node {
+            std::atomic<uint32_t> readers{0};   ///< including readers about to find out that the node is not current anymore
+            std::atomic<uint8_t> state{kFree};
+            T* value = nullptr;
+            Node* next = nullptr;               ///< all nodes, only used by writers
+        };
+
+        std::atomic<Node*> current_;
+        Node* nodes_;
+
+        static void unpin_(Node* node) {
+            if (node->readers.fetch_sub(1) == 1 && node->state.load() == kSuperseded)
+                free_(node);
+        }
+
+        // by the writer or the last reader, whoever gets here first
+        static void free_(Node* node) {
+            uint8_t expected = kSuperseded;
+            if (!node->state.compare_exchange_strong(expected, kFreeing))
+                return;
+            delete node->value;
+            node->value = nullptr;
+            node->state = kFree;
+        }
+
+        Node* getFreeNode_() {
+            for (Node* node = nodes_; node; node = node->next) {
+                if (node->state.load() == kFree && node->readers.load() == 0)
+                    return node;
+            }
+            Node* node = new Node();
+            node->next = nodes_;
+            nodes_ = node;
+            return node;
+        }
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+// Response body made up of several buffers sent back to back (flash content, cached chunks, small generated parts),
+// so they never need to be copied into one contiguous buffer
+class ResponseSegments {
+    public:
+        void Add(const uint8_t* data, size_t length) {
+            if (!length)
+                return;
+            parts_.emplace_back(data, length);
+            length_ += length;
+        }
+
+        void Add(const String &string) {
+            Add(reinterpret_cast<const uint8_t*>(string.c_str()), string.length());
+        }
+
+        // for small generated parts only (e.g. block headers), they get copied
+        void AddCopy(const uint8_t* data, size_t length) {
+            // moving the vectors around keeps their content in place
+            copies_.emplace_back(data, data + length);
+            Add(copies_.back().data(), length);
+        }
+
+        // keeps the buffers referenced by Add() alive as long as the response needs them
+        void Keep(std::shared_ptr<const void> owner) {
+            owners_.push_back(owner);
+        }
+
+        size_t Length() const {
+            return length_;
+        }
+
+        // AwsResponseFiller semantics
+        size_t Read(uint8_t *buffer, size_t maxLen, size_t index) {
+            // the server reads sequentially, so seeking is just a fallback
+            if (index < position_) {
+                part_ = 0;
+                partOffset_ = 0;
+                position_ = 0;
+            }
+            while (position_ < index && part_ < parts_.size())
+                advance_(std::min(index - position_, parts_[part_].second - partOffset_));
+
+            size_t length = 0;
+            while (length < maxLen && part_ < parts_.size()) {
+                size_t chunkLength = std::min(maxLen - length, parts_[part_].second - partOffset_);
+                memcpy(buffer + length, parts_[part_].first + partOffset_, chunkLength);
+                length += chunkLength;
+                advance_(chunkLength);
+            }
+            return length;
+        }
+
+        static AsyncWebServerResponse* BeginResponse(AsyncWebServerRequest *request, const String &contentType, std::shared_ptr<ResponseSegments> segments) {
+            // the segments live along with the response (i.e. the lambda)
+            return request->beginResponse(contentType, segments->Length(), [segments](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return segments->Read(buffer, maxLen, index);
+            });
+        }
+
+    private:
+        std::vector<std::pair<const uint8_t*, size_t>> parts_;
+        std::vector<std::vector<uint8_t>> copies_;
+        std::vector<std::shared_ptr<const void>> owners_;
+        size_t length_ = 0;
+
+        size_t part_ = 0;
+        size_t partOffset_ = 0;
+        size_t position_ = 0;
+
+        void advance_(size_t length) {
+            partOffset_ += length;
+            position_ += length;
+            if (partOffset_ == parts_[part_].second) {
+                part_++;
+                partOffset_ = 0;
+            }
+        }
+};
@@ -0,0 +1,77 @@
+/*
+   Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+   by Felix Storm (http://github.com/felixstorm)
+   Licensed under GPLv3. See LICENSE for details.
+   */
+
+#include "WebInterface.hpp"
+#include <algorithm>
+#include "InternalFiles.hpp"
+
+
+UiModel::UiModel(const UiModel &other)
+    : idIndex_(other.idIndex_)
+{
+    elements_.reserve(other.elements_.size());
+    for (const auto &element : other.elements_)
+        elements_.push_back({element.id.Clone(), element.element.Clone(), element.content.Clone(), element.parent.Clone()});
+    attributes_.reserve(other.attributes_.size());
+    for (const auto &attribute : other.attributes_)
+        attributes_.push_back({attribute.element, attribute.key.Clone(), attribute.value.Clone()});
+}
+
+size_t UiModel::Add(UiText id, UiText element, UiText content, UiText parent)
+{
+    uint16_t elementIndex = elements_.size();
+    std::pair<uint32_t, uint16_t> indexEntry(InternalFilesHash(id.c_str()), elementIndex);
+    idIndex_.insert(std::upper_bound(idIndex_.begin(), idIndex_.end(), indexEntry), indexEntry);
+    elements_.push_back({std::move(id), std::move(element), std::move(content), std::move(parent)});
+    return elementIndex;
+}
+
+void UiModel::SetAttribute(size_t elementIndex, UiText key, UiText value)
+{
+    for (auto &attribute : attributes_) {
+        if (attribute.element == elementIndex && attribute.key == key.c_str()) {
+            attribute.value = std::move(value);
+            return;
+        }
+    }
+    attributes_.push_back({static_cast<uint16_t>(elementIndex), std::move(key), std::move(value)});
+}
+
+void UiModel::SetContent(size_t elementIndex, UiText content)
+{
+    elements_[elementIndex].content = std::move(content);
+}
+
+int UiModel::Find(const char* id) const
+{
+    uint32_t hash = InternalFilesHash(id);
+    auto found = std::lower_bound(idIndex_.begin(), idIndex_.end(), std::make_pair(hash, static_cast<uint16_t>(0)));
+    for (; found != idIndex_.end() && found->first == hash; found++) {
+        if (elements_[found->second].id == id)
+            return found->second;
+    }
+    return -1;
+}
+
+const char* UiModel::GetAttribute(size_t elementIndex, const char* key) const
+{
+    for (const auto &attribute : attributes_) {
+        if (attribute.element == elementIndex && attribute.key == key)
+            return attribute.value.c_str();
+    }
+    return nullptr;
+}
+
+size_t UiModel::HeapSize() const
+{
+    size_t size = elements_.capacity() * sizeof(Element) + attributes_.capacity() * sizeof(Attribute)
+                  + idIndex_.capacity() * sizeof(idIndex_[0]);
+    for (const auto &element : elements_)
+        size += element.id.HeapSize() + element.element.HeapSize() + element.content.HeapSize() + element.parent.HeapSize();
+    for (const auto &attribute : attributes_)
+        size += attribute.key.HeapSize() + attribute.value.HeapSize();
+    return size;
+}
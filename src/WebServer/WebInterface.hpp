@@ -6,45 +6,151 @@
    */
 
 #pragma once
-#include <map>
 
-struct InterfaceElement {
+#include <Arduino.h>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
+
+
+// Text within the UI model: either refers to static data (literals, i.e. flash) without any copy or holds a heap copy of
+// a dynamic value, which is shared (reference counted) by all versions of the UI model containing it
+class UiText {
     public:
-        InterfaceElement(const String &p_id, const String &p_element, const String &p_content, const String &p_parent) {
-            element = std::move(p_element);
-            id = std::move(p_id);
-            content = std::move(p_content);
-            parent = std::move(p_parent);
-        };
+        UiText() = default;
+        UiText(const UiText&) = delete;
+        UiText& operator=(const UiText&) = delete;
+        UiText(UiText &&other) noexcept : text_(other.text_), shared_(other.shared_) {
+            other.text_ = nullptr;
+            other.shared_ = nullptr;
+        }
+        UiText& operator=(UiText &&other) noexcept {
+            std::swap(text_, other.text_);
+            std::swap(shared_, other.shared_);
+            return *this;
+        }
+        ~UiText() {
+            if (shared_ && shared_->references.fetch_sub(1) == 1) {
+                shared_->~Shared();
+                free(shared_);
+            }
+        }
 
-        struct cmp_str
-        {
-            bool operator()(const String &a, const String &b) const
-            {
-                return strcmp(a.c_str(), b.c_str()) < 0;
+        // text has to stay valid as long as the UI model exists
+        static UiText Static(const char* text) {
+            UiText result;
+            result.text_ = text;
+            return result;
+        }
+        // static text stays static, heap text gets shared
+        UiText Clone() const {
+            UiText result;
+            result.text_ = text_;
+            result.shared_ = shared_;
+            if (shared_)
+                shared_->references.fetch_add(1);
+            return result;
+        }
+        static UiText Copy(const String &text) {
+            UiText result;
+            void* memory = text.length() ? malloc(sizeof(Shared) + text.length()) : nullptr;
+            if (memory) {
+                result.shared_ = new (memory) Shared();
+                memcpy(result.shared_->text, text.c_str(), text.length() + 1);
+                result.text_ = result.shared_->text;
             }
-        };
+            return result;
+        }
 
-        const String& getId() const
-        {
-            return id;
+        const char* c_str() const {
+            return text_ ? text_ : "";
+        }
+        bool operator==(const char* other) const {
+            return strcmp(c_str(), other) == 0;
         }
+        // counted for every version sharing it
+        size_t HeapSize() const {
+            return shared_ ? sizeof(Shared) + strlen(text_) : 0;
+        }
+
+    private:
+        struct Shared {
+            std::atomic<uint32_t> references{1};
+            char text[1];                       ///< actually as long as needed
+        };
+
+        const char* text_ = nullptr;
+        Shared* shared_ = nullptr;
+};
+
+struct UiAttributeDescriptor {
+    const char* key;
+    const char* value;
+};
+
+// Static part of the UI, meant to be declared constexpr so it stays in flash
+struct UiElementDescriptor {
+    const char* id;
+    const char* element;
+    const char* content;
+    const char* parent;
+    const char* configKey;                      ///< nullptr if the element is not a configuration input
+    UiAttributeDescriptor attributes[3];        ///< Unused entries are {nullptr, nullptr}
+};
 
-        String element;
-        String id;
-        String content;
-        String parent;
-        std::map<String, String, cmp_str> attributes;
+constexpr UiElementDescriptor UiFormInputDescriptor(const char* configKey, const char* label, UiAttributeDescriptor attribute = {nullptr, nullptr})
+{
+    return { configKey, "input", label, "#configform", configKey, { attribute } };
+}
 
-        void setAttribute(const String &key, const String &value) {
-            attributes[key] = value;
+// Elements and attributes in flat arrays, ids found through an index sorted by hash
+class UiModel {
+    public:
+        struct Element {
+            UiText id;
+            UiText element;
+            UiText content;
+            UiText parent;
         };
 
-        String getAttribute(const String &key) const {
-            auto found = attributes.find(key);
-            if (found != attributes.end()) {
-                return found->second;
-            }
-            return {""};
+        UiModel() = default;
+        // copies the arrays (without spare capacity) but shares all heap texts, i.e. only a changed text is new (see RcuValue)
+        UiModel(const UiModel &other);
+        UiModel& operator=(const UiModel&) = delete;
+
+        // returns the index of the new element
+        size_t Add(UiText id, UiText element, UiText content, UiText parent);
+        void SetAttribute(size_t elementIndex, UiText key, UiText value);
+        void SetContent(size_t elementIndex, UiText content);
+        // returns -1 if not found
+        int Find(const char* id) const;
+        // returns nullptr if not set
+        const char* GetAttribute(size_t elementIndex, const char* key) const;
+
+        size_t Size() const {
+            return elements_.size();
+        }
+        const Element& operator[](size_t elementIndex) const {
+            return elements_[elementIndex];
+        }
+
+        template<typename Func> void ForEachAttribute(size_t elementIndex, Func func) const {
+            for (const auto &attribute : attributes_)
+                if (attribute.element == elementIndex)
+                    func(attribute.key.c_str(), attribute.value.c_str());
         }
+
+        size_t HeapSize() const;
+
+    private:
+        struct Attribute {
+            uint16_t element;
+            UiText key;
+            UiText value;
+        };
+
+        std::vector<Element> elements_;
+        std::vector<Attribute> attributes_;
+        std::vector<std::pair<uint32_t, uint16_t>> idIndex_;   ///< (hash of id, element index), sorted
 };
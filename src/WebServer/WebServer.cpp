@@ -6,15 +6,68 @@
    */
 
 #include "WebServer.hpp"
+#include <rom/crc.h>
+#include "../BootProfiler.hpp"
+#include "../Metrics.hpp"
 
 
 namespace {
     const constexpr char* kLoggingTag = "IotBaseWeb";
+    const constexpr size_t kDataJsonChunkSize = 512;
+
+    // pseudo element in the render plan: start (close == false) or end of the #wrapper div
+    const constexpr uint16_t kRenderWrapper = 0xffff;
+
+    bool isVoidElement(const UiText &element)
+    {
+        for (const char* voidElement : {"input", "img", "br", "hr", "meta", "link"}) {
+            if (element == voidElement)
+                return true;
+        }
+        return false;
+    }
+
+    void appendHtmlEscaped(String &output, const char* text)
+    {
+        for (; *text; text++) {
+            switch (*text) {
+                case '&': output += "&amp;"; break;
+                case '<': output += "&lt;"; break;
+                case '>': output += "&gt;"; break;
+                case '"': output += "&quot;"; break;
+                default: output += *text;
+            }
+        }
+    }
+
+    void appendHtmlAttribute(String &output, const char* key, const char* value)
+    {
+        // like esp32iotbase.js: empty attributes are not set at all
+        if (!*value)
+            return;
+        output += ' ';
+        output += key;
+        output += "=\"";
+        appendHtmlEscaped(output, value);
+        output += '"';
+    }
 }
 
 WebServer::WebServer()
-    : server_(80)
+    : server_(80), events_(new EventStream("/events"))
+{
+    dataJsonMutex_ = xSemaphoreCreateMutex();
+    uiWriteMutex_ = xSemaphoreCreateMutex();
+}
+
+void WebServer::SetUiRendering(UiRendering uiRendering)
 {
+    uiRendering_ = uiRendering;
+}
+
+void WebServer::SetConfigApplyFunction(std::function<bool(const ConfigKey &key)> configApplyFunc)
+{
+    configApplyFunc_ = configApplyFunc;
 }
 
 void WebServer::AddCaptiveRequestHandler(IPAddress localIpAddress)
@@ -25,54 +78,84 @@ void WebServer::AddCaptiveRequestHandler(IPAddress localIpAddress)
 }
 
 void WebServer::Begin(Configuration &configuration, std::function<void()> submitFunc) {
+    IOTBASE_BOOT_PHASE("web.begin");
 
-    server_.addHandler(new InternalGzippedFilesHandler());
-
-    server_.on("/data.json" , HTTP_GET, [&configuration, this](AsyncWebServerRequest * request)
     {
-            AsyncJsonResponse *response = new AsyncJsonResponse(false, 8192);
-            
-            JsonObject _jsonData = response->getRoot();
-            JsonArray elements = _jsonData.createNestedArray("elements");
-
-            for (const auto &interfaceElement : interfaceElements_)
-            {
-                JsonObject element = elements.createNestedObject();
-                JsonObject attributes = element.createNestedObject("attributes");
-                element["element"] = interfaceElement.element;
-                element["id"] = interfaceElement.id;
-                element["content"] = interfaceElement.content;
-                element["parent"] = interfaceElement.parent;
-
-                for (const auto &attribute : interfaceElement.attributes)
-                {
-                    attributes[attribute.first] = String{attribute.second};
-                }
+        auto ui = ui_.Read();
+        ESP_LOGI(kLoggingTag, "UI model: %u elements using %u bytes of heap", ui->Size(), ui->HeapSize());
+    }
 
-                if (interfaceElement.getAttribute("data-configkey").length() != 0)
-                {
-                    if (interfaceElement.getAttribute("type")=="password")
+    configuration.OnChange([this]() { invalidateDataJson_(); });
+
+    if (uiRendering_ == UiRendering::server) {
+        // versioned references, so the browser may cache them forever
+        renderedPagePrefix_ = String("<!DOCTYPE html><html lang=\"en\"><head><meta charset=\"utf-8\"><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">")
+                              + "<link rel=\"shortcut icon\" type=\"image/svg+xml\" href=\"/logo.svg?v=" + k_logo_svg_hash + "\" sizes=\"any\">"
+                              + "<link rel=\"stylesheet\" href=\"/esp32iotbase.css?v=" + k_esp32iotbase_css_hash + "\">"
+                              // only needed to submit the form
+                              + "<script src=\"/esp32iotbase.js?v=" + k_esp32iotbase_js_hash + "\" defer></script>";
+
+        // has to come before InternalGzippedFilesHandler, which handles "/" as well
+        server_.on("/", HTTP_GET, [&configuration, this](AsyncWebServerRequest *request)
+        {
+                // the whole page gets rendered from the version of the UI there has been at the start, changes meanwhile
+                // create new versions, this one is only kept until the response is done
+                RcuValue<UiModel>::Pin ui = ui_.Read();
+                std::shared_ptr<std::vector<RenderStep>> plan = buildRenderPlan_(*ui);
+                std::shared_ptr<ChunkedResponseWriter> writer = std::make_shared<ChunkedResponseWriter>(renderedPagePrefix_.c_str(), "", "</body></html>",
+                    [ui, plan, &configuration, this](size_t index, String &output)
                     {
-                        attributes["placeholder"] = "(Password unchanged)";
-                        attributes["value"] = "";
-                    } else {
-                        attributes["value"] = configuration.GetRaw(interfaceElement.getAttribute("data-configkey").c_str());
-                    }
-                }
-            }
+                        if (index >= plan->size())
+                            return false;
+                        renderStep_(*ui, (*plan)[index], output, configuration);
+                        return true;
+                    });
+                AsyncWebServerResponse *response = ChunkedResponseWriter::BeginResponse(request, "text/html", writer);
+                // contains the current configuration
+                response->addHeader("Cache-Control", "no-store");
+                request->send(response);
+        });
+    }
 
-            if (LOG_LOCAL_LEVEL >= ESP_LOG_VERBOSE) {
-                std::ostringstream output;
-                serializeJsonPretty(_jsonData, output);
-                ESP_LOGV(kLoggingTag, "\r\n%s", output.str().c_str());
-            }
+    // the bundled page (if any) embeds the same data as /data.json
+    server_.addHandler(new InternalGzippedFilesHandler([&configuration, this]()
+    {
+            return getDataJson_(configuration);
+    }));
 
-            response->setLength();
+    server_.addHandler(new CachedJsonHandler("/data.json", [&configuration, this]()
+    {
+            return getDataJson_(configuration);
+    }));
+
+    server_.addHandler(events_);
 
-            // NOTE: AsyncServer.send(ptr* foo) deletes `response` after async send.
+    MetricsRegistry::Gauge eventClients = Metrics.AddGauge("iotbase_web_event_clients", "Clients connected to /events");
+    MetricsRegistry::Counter eventsDropped = Metrics.AddCounter("iotbase_web_events_dropped_total", "Events dropped for slow /events clients");
+    Metrics.AddCollector([this, eventClients, eventsDropped]()
+    {
+            eventClients.Set(events_->GetClientCount());
+            eventsDropped.SetTotal(events_->GetDroppedEvents());
+    });
+
+    // Prometheus text format, written family by family
+    server_.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request)
+    {
+            Metrics.Collect();
+            std::shared_ptr<ChunkedResponseWriter> writer = std::make_shared<ChunkedResponseWriter>("", "", "", [](size_t index, String &output)
+            {
+                    return Metrics.WritePrometheusFamily(index, output);
+            });
+            AsyncWebServerResponse *response = ChunkedResponseWriter::BeginResponse(request, "text/plain; version=0.0.4", writer);
+            response->addHeader("Cache-Control", "no-store");
             request->send(response);
     });
 
+    server_.on("/bootreport.json", HTTP_GET, [](AsyncWebServerRequest *request)
+    {
+            request->send(200, "application/json", BootProfile.ToJsonString());
+    });
+
     server_.on("/submitconfig", HTTP_POST, [&configuration, submitFunc, this](AsyncWebServerRequest *request)
     {
             ESP_LOG_WEBREQUEST(ESP_LOG_VERBOSE, kLoggingTag, request);
@@ -97,6 +180,36 @@ void WebServer::Begin(Configuration &configuration, std::function<void()> submit
                 submitFunc();
     });
 
+    // for changing the configuration via the API and restarting, /update additionally requires OTA to be active
+    auto adminPasswordFunc = [&configuration]() { return configuration.Get(ConfigKey::OtaPassword); };
+    server_.addHandler(new ConfigApiHandler("/api/config", configuration, adminPasswordFunc, configApplyFunc_));
+
+    #ifndef ESP32IOTBASE_NO_OTA
+        server_.addHandler(new FirmwareUpdateHandler("/update", [&configuration]()
+        {
+                return configuration.Get(ConfigKey::OtaActive).equalsIgnoreCase("false") ? String() : configuration.Get(ConfigKey::OtaPassword);
+        }, submitFunc, [this](size_t written, size_t total)
+        {
+                SendEvent("update", String("{\"written\":") + written + ",\"total\":" + total + "}");
+        }));
+    #endif
+
+    // e.g. after /api/config reported that a restart is required, authenticated like /api/config
+    server_.on("/api/restart", HTTP_POST, [submitFunc, adminPasswordFunc](AsyncWebServerRequest *request)
+    {
+            String password = adminPasswordFunc();
+            if (password.isEmpty() || !request->authenticate("admin", password.c_str())) {
+                request->requestAuthentication(nullptr, true);
+                return;
+            }
+            if (!submitFunc) {
+                request->send(501);
+                return;
+            }
+            request->send(202);
+            submitFunc();
+    });
+
     server_.onNotFound([this](AsyncWebServerRequest *request)
     {
         ESP_LOG_WEBREQUEST(ESP_LOG_VERBOSE, kLoggingTag, request);
@@ -107,40 +220,307 @@ void WebServer::Begin(Configuration &configuration, std::function<void()> submit
     server_.begin();
 }
 
-// Remark: The server should be stopped before any changes to the interface elements are done to avoid inconsistent results if a request comes in at that very moment.
-// However, ESPAsyncWebServer does not support any kind of end() function or something like that in the moment.
-void WebServer::UiAddElement(const String &elementId, const String &elementName, const String &content, const String &parent, const String &configVariable)
+bool WebServer::SendEvent(const char* event, const String &data)
 {
-    interfaceElements_.emplace_back(elementId, std::move(elementName), std::move(content), std::move(parent));
-    if (configVariable.length() != 0) {
-        UiSetElementAttribute(elementId, "data-configkey", std::move(configVariable));
+    return events_->Send(event, data.c_str());
+}
+
+size_t WebServer::GetEventClientCount() const
+{
+    return events_->GetClientCount();
+}
+
+void WebServer::ForwardLogToEvents()
+{
+    events_->ForwardLog();
+}
+
+bool WebServer::serializeDataJsonElement_(const UiModel &ui, size_t index, String &output, Configuration &configuration)
+{
+    if (index >= ui.Size())
+        return false;
+    const UiModel::Element &uiElement = ui[index];
+
+    const char* configKey = ui.GetAttribute(index, "data-configkey");
+    const char* type = ui.GetAttribute(index, "type");
+    bool isPassword = type && strcmp(type, "password") == 0;
+    String configValue = configKey && !isPassword ? configuration.GetRaw(configKey) : String();
+    size_t attributeCount = 0;
+    ui.ForEachAttribute(index, [&attributeCount](const char*, const char*) { attributeCount++; });
+
+    // const char* are only referenced by the document, just the config value (String) gets copied
+    DynamicJsonDocument jsonDocument(JSON_OBJECT_SIZE(5) + JSON_OBJECT_SIZE(attributeCount + 2) + configValue.length() + 1);
+
+    JsonObject element = jsonDocument.to<JsonObject>();
+    JsonObject attributes = element.createNestedObject("attributes");
+    element["element"] = uiElement.element.c_str();
+    element["id"] = uiElement.id.c_str();
+    element["content"] = uiElement.content.c_str();
+    element["parent"] = uiElement.parent.c_str();
+
+    ui.ForEachAttribute(index, [&attributes](const char* key, const char* value)
+    {
+        attributes[key] = value;
+    });
+
+    if (configKey)
+    {
+        if (isPassword)
+        {
+            attributes["placeholder"] = "(Password unchanged)";
+            attributes["value"] = "";
+        } else {
+            attributes["value"] = configValue;
+        }
+    }
+
+    if (jsonDocument.overflowed())
+        ESP_LOGE(kLoggingTag, "JSON document for UI element '%s' is too small", uiElement.id.c_str());
+    if (LOG_LOCAL_LEVEL >= ESP_LOG_VERBOSE) {
+        std::ostringstream verboseOutput;
+        serializeJsonPretty(jsonDocument, verboseOutput);
+        ESP_LOGV(kLoggingTag, "\r\n%s", verboseOutput.str().c_str());
     }
+
+    serializeJson(jsonDocument, output);
+    // allows embedding it into a <script> block as well, "<\/" means the same in JSON
+    output.replace("</", "<\\/");
+    return true;
+}
+
+std::shared_ptr<const CachedJson> WebServer::getDataJson_(Configuration &configuration)
+{
+    xSemaphoreTake(dataJsonMutex_, portMAX_DELAY);
+    std::shared_ptr<const CachedJson> cached = dataJsonCache_;
+    uint32_t generation = dataJsonGeneration_;
+    xSemaphoreGive(dataJsonMutex_);
+    if (cached)
+        return cached;
+
+    // serialized element by element into small chunks, so neither the whole document nor the whole output
+    // ever needs to be in one piece of memory
+    auto ui = ui_.Read();
+    ChunkedResponseWriter writer("{\"elements\":[", ",", "]}", [&ui, &configuration, this](size_t index, String &output)
+    {
+        return serializeDataJsonElement_(*ui, index, output, configuration);
+    });
+    std::shared_ptr<CachedJson> built = std::make_shared<CachedJson>();
+    uint32_t crc = 0;
+    char chunk[kDataJsonChunkSize + 1];
+    size_t chunkLength;
+    while ((chunkLength = writer.Read(reinterpret_cast<uint8_t*>(chunk), kDataJsonChunkSize)) > 0) {
+        chunk[chunkLength] = 0;
+        built->chunks.emplace_back(chunk);
+        built->length += chunkLength;
+        crc = crc32_le(crc, reinterpret_cast<const uint8_t*>(chunk), chunkLength);
+    }
+    char etag[11];
+    snprintf(etag, sizeof(etag), "\"%08x\"", (unsigned int) crc);
+    built->etag = etag;
+    ESP_LOGD(kLoggingTag, "Rebuilt data.json (%u bytes in %u chunks)", built->length, built->chunks.size());
+
+    // do not cache it if anything has changed while building it
+    xSemaphoreTake(dataJsonMutex_, portMAX_DELAY);
+    if (generation == dataJsonGeneration_)
+        dataJsonCache_ = built;
+    xSemaphoreGive(dataJsonMutex_);
+
+    return built;
+}
+
+void WebServer::invalidateDataJson_()
+{
+    xSemaphoreTake(dataJsonMutex_, portMAX_DELAY);
+    dataJsonGeneration_++;
+    dataJsonCache_.reset();
+    xSemaphoreGive(dataJsonMutex_);
+}
+
+// Order in which the elements get rendered (opening and closing tags), resolving the parents the same way as esp32iotbase.js
+std::shared_ptr<std::vector<WebServer::RenderStep>> WebServer::buildRenderPlan_(const UiModel &ui)
+{
+    const int kHead = -1, kWrapper = -2, kBody = -3;
+    size_t count = ui.Size();
+
+    std::vector<int> parents(count);
+    for (size_t i = 0; i < count; i++) {
+        const char* parent = ui[i].parent.c_str();
+        int found = -1;
+        if (strcmp(parent, "head") == 0) {
+            parents[i] = kHead;
+            continue;
+        } else if (strcmp(parent, "body") == 0) {
+            parents[i] = kBody;
+            continue;
+        } else if (parent[0] == '#') {
+            found = ui.Find(parent + 1);
+        } else {
+            // tag name, i.e. the first element of that type
+            for (size_t j = 0; j < i && found < 0; j++) {
+                if (ui[j].element == parent)
+                    found = j;
+            }
+        }
+        // only elements added before may be parents (rules out any cycles), everything else ends up in #wrapper
+        parents[i] = found >= 0 && static_cast<size_t>(found) < i ? found : kWrapper;
+    }
+
+    std::shared_ptr<std::vector<RenderStep>> plan = std::make_shared<std::vector<RenderStep>>();
+    plan->reserve(2 * count + 2);
+    std::function<void(int)> addChildren = [&](int parent) {
+        for (size_t i = 0; i < count; i++) {
+            if (parents[i] != parent)
+                continue;
+            plan->push_back({static_cast<uint16_t>(i), false});
+            addChildren(i);
+            // inputs with content get wrapped into a label
+            if (!isVoidElement(ui[i].element) || (ui[i].element == "input" && *ui[i].content.c_str()))
+                plan->push_back({static_cast<uint16_t>(i), true});
+        }
+    };
+    addChildren(kHead);
+    plan->push_back({kRenderWrapper, false});
+    addChildren(kWrapper);
+    plan->push_back({kRenderWrapper, true});
+    addChildren(kBody);
+    return plan;
+}
+
+void WebServer::renderStep_(const UiModel &ui, const RenderStep &step, String &output, Configuration &configuration)
+{
+    if (step.element == kRenderWrapper) {
+        output = step.close ? "</div>" : "</head><body id=\"body\" data-serverrendered><div id=\"wrapper\">";
+        return;
+    }
+    const UiModel::Element &uiElement = ui[step.element];
+    // same as esp32iotbase.js: inputs with content get wrapped into a label
+    bool isLabeledInput = uiElement.element == "input" && *uiElement.content.c_str();
+    if (step.close) {
+        output += "</";
+        output += isLabeledInput ? "label" : uiElement.element.c_str();
+        output += '>';
+        return;
+    }
+
+    if (isLabeledInput) {
+        output += "<label id=\"labelfor";
+        appendHtmlEscaped(output, uiElement.id.c_str());
+        output += "\" for=\"";
+        appendHtmlEscaped(output, uiElement.id.c_str());
+        output += "\">";
+        appendHtmlEscaped(output, uiElement.content.c_str());
+    }
+
+    output += '<';
+    output += uiElement.element.c_str();
+    appendHtmlAttribute(output, "id", uiElement.id.c_str());
+
+    const char* configKey = ui.GetAttribute(step.element, "data-configkey");
+    const char* type = ui.GetAttribute(step.element, "type");
+    bool isPassword = type && strcmp(type, "password") == 0;
+    ui.ForEachAttribute(step.element, [&output, configKey, isPassword](const char* key, const char* value)
+    {
+        // same as in data.json: the current configuration value takes precedence
+        if (configKey && (strcmp(key, "value") == 0 || (isPassword && strcmp(key, "placeholder") == 0)))
+            return;
+        appendHtmlAttribute(output, key, value);
+    });
+    if (configKey) {
+        if (isPassword)
+            appendHtmlAttribute(output, "placeholder", "(Password unchanged)");
+        else
+            appendHtmlAttribute(output, "value", configuration.GetRaw(configKey).c_str());
+    }
+    output += '>';
+
+    if (!isLabeledInput)
+        appendHtmlEscaped(output, uiElement.content.c_str());
+}
+
+void WebServer::UiAddElement(const String &elementId, const String &elementName, const String &content, const String &parent, const String &configVariable)
+{
+    updateUi_([&](UiModel &ui)
+    {
+        lastElement_ = ui.Add(UiText::Copy(elementId), UiText::Copy(elementName), UiText::Copy(content), UiText::Copy(parent));
+        if (configVariable.length() != 0)
+            ui.SetAttribute(lastElement_, UiText::Static("data-configkey"), UiText::Copy(configVariable));
+    });
+}
+
+void WebServer::UiAddElements(const UiElementDescriptor* descriptors, size_t count)
+{
+    updateUi_([&](UiModel &ui)
+    {
+        for (size_t i = 0; i < count; i++) {
+            const UiElementDescriptor &descriptor = descriptors[i];
+            lastElement_ = ui.Add(UiText::Static(descriptor.id), UiText::Static(descriptor.element), UiText::Static(descriptor.content), UiText::Static(descriptor.parent));
+            for (const auto &attribute : descriptor.attributes) {
+                if (attribute.key)
+                    ui.SetAttribute(lastElement_, UiText::Static(attribute.key), UiText::Static(attribute.value));
+            }
+            if (descriptor.configKey)
+                setConfigKey_(ui, lastElement_, descriptor.configKey);
+        }
+    });
 }
 
 void WebServer::UiAddFormInput(const ConfigKey &configVariable, const String &content)
 {
-    String elementIdAndConfigVariable = configVariable._to_string();
-    UiAddElement(elementIdAndConfigVariable, "input", content, "#configform", elementIdAndConfigVariable);
+    // better-enums names are static
+    const char* elementIdAndConfigVariable = configVariable._to_string();
+    updateUi_([&](UiModel &ui)
+    {
+        lastElement_ = ui.Add(UiText::Static(elementIdAndConfigVariable), UiText::Static("input"), UiText::Copy(content), UiText::Static("#configform"));
+        setConfigKey_(ui, lastElement_, elementIdAndConfigVariable);
+    });
+}
+
+void WebServer::setConfigKey_(UiModel &ui, size_t elementIndex, const char* configKey)
+{
+    if (!ConfigKey::_is_valid(configKey))
+        ESP_LOGE(kLoggingTag, "UI element '%s' refers to unknown config key '%s'", ui[elementIndex].id.c_str(), configKey);
+    ui.SetAttribute(elementIndex, UiText::Static("data-configkey"), UiText::Static(configKey));
 
     // add potential default value as placeholder
-    auto configDefault = Config->StringDefaults.find(configVariable._to_string());
+    auto configDefault = Config->StringDefaults.find(configKey);
     if (configDefault != Config->StringDefaults.end())
-        UiSetLastEleAttr("placeholder", configDefault->second);
+        ui.SetAttribute(elementIndex, UiText::Static("placeholder"), UiText::Copy(configDefault->second));
 }
 
 void WebServer::UiSetElementAttribute(const String &elementId, const String &attributeKey, const String &attributeValue)
 {
-    for (auto &element : interfaceElements_) {
-        if (element.getId() == elementId) {
-            element.setAttribute(attributeKey, attributeValue);
-            return;
-        }
-    }
+    updateUi_([&](UiModel &ui)
+    {
+        int elementIndex = ui.Find(elementId.c_str());
+        if (elementIndex >= 0)
+            ui.SetAttribute(elementIndex, UiText::Copy(attributeKey), UiText::Copy(attributeValue));
+    });
 }
 
 void WebServer::UiSetLastEleAttr(const String &attributeKey, const String &attributeValue)
 {
-    interfaceElements_.back().setAttribute(attributeKey, attributeValue);
+    updateUi_([&](UiModel &ui)
+    {
+        if (lastElement_ >= 0)
+            ui.SetAttribute(lastElement_, UiText::Copy(attributeKey), UiText::Copy(attributeValue));
+    });
+}
+
+void WebServer::UiSetElementContent(const String &elementId, const String &content)
+{
+    // status elements often get set to what they show already, which needs no new version at all
+    {
+        auto ui = ui_.Read();
+        int elementIndex = ui->Find(elementId.c_str());
+        if (elementIndex >= 0 && (*ui)[elementIndex].content == content.c_str())
+            return;
+    }
+    updateUi_([&](UiModel &ui)
+    {
+        int elementIndex = ui.Find(elementId.c_str());
+        if (elementIndex >= 0)
+            ui.SetContent(elementIndex, UiText::Copy(content));
+    });
 }
 
 
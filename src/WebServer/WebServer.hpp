@@ -16,6 +16,7 @@
 
 #include "Configuration.hpp"
 #include "WebInterface.hpp"
+#include "RcuValue.hpp"
 
 // declared up here since the handlers (may) need it
 void WebServerDebugPrintRequestImpl(esp_log_level_t level, const char* tag, const char* logPrefix, AsyncWebServerRequest *request);
@@ -28,25 +29,87 @@ void WebServerDebugPrintRequestImpl(esp_log_level_t level, const char* tag, cons
     } while(0);
 
 #include "InternalGzippedFilesHandler.hpp"
+#include "CachedJsonHandler.hpp"
+#include "ChunkedResponseWriter.hpp"
 #include "CaptiveRequestHandler.hpp"
+#include "EventStream.hpp"
+#include "ConfigApiHandler.hpp"
+#include "FirmwareUpdateHandler.hpp"
 
 
 class WebServer {
     public:
+        // client: esp32iotbase.js builds the UI from data.json, server: the UI gets streamed as ready-made HTML (no JavaScript needed for the first paint)
+        enum class UiRendering {client, server};
+
         WebServer();
 
+        // has to be called before Begin()
+        void SetUiRendering(UiRendering uiRendering);
+        // for /api/config: applies a changed key at runtime, returns false if a restart is required (default for all keys)
+        void SetConfigApplyFunction(std::function<bool(const ConfigKey &key)> configApplyFunc);
+
         void Begin(Configuration &configuration, std::function<void()> submitFunc = 0);
         void AddCaptiveRequestHandler(IPAddress localIpAddress);
 
         Configuration* Config;
 
+        // The UI may be changed at any time, even while the server is running: requests keep reading the version they
+        // started with, changes get published as a whole once complete.
+        // dynamic values, they get copied
         void UiAddElement(const String &elementId, const String &elementName, const String &content, const String &parent = "#configform", const String &configVariable = "");
+        // static parts of the UI (declared constexpr), they stay in flash
+        void UiAddElements(const UiElementDescriptor* descriptors, size_t count);
+        template<size_t N> void UiAddElements(const UiElementDescriptor (&descriptors)[N]) {
+            UiAddElements(descriptors, N);
+        }
         void UiAddFormInput(const ConfigKey &configVariable, const String &content);
         void UiSetElementAttribute(const String &elementId, const String &attributeKey, const String &attributeValue);
         void UiSetLastEleAttr(const String &attributeKey, const String &attributeValue);
+        // e.g. for status elements
+        void UiSetElementContent(const String &elementId, const String &content);
+
+        // live events at /events (Server-Sent Events), may be called from any task and never blocks
+        bool SendEvent(const char* event, const String &data);
+        size_t GetEventClientCount() const;
+        // makes all log output available as "log" events, off by default as the log may contain sensitive data
+        void ForwardLogToEvents();
 
     private:
         AsyncWebServer server_;
+        // owned by server_ once Begin() has been called
+        EventStream* events_;
+
+        RcuValue<UiModel> ui_;
+        // serializes all changes to ui_ (and lastElement_)
+        SemaphoreHandle_t uiWriteMutex_ = 0;
+        int lastElement_ = -1;
+
+        UiRendering uiRendering_ = UiRendering::client;
+        std::function<bool(const ConfigKey &key)> configApplyFunc_;
+        String renderedPagePrefix_;
+        struct RenderStep {
+            uint16_t element;
+            bool close;
+        };
+
+        // serialized data.json, rebuilt on demand after any change to the UI elements or the configuration
+        SemaphoreHandle_t dataJsonMutex_ = 0;
+        std::shared_ptr<const CachedJson> dataJsonCache_;
+        uint32_t dataJsonGeneration_ = 0;
+
+        template<typename Func> void updateUi_(Func func) {
+            xSemaphoreTake(uiWriteMutex_, portMAX_DELAY);
+            // the copy shares all texts, so a change only allocates the arrays and the changed text
+            ui_.Update(func);
+            xSemaphoreGive(uiWriteMutex_);
+            invalidateDataJson_();
+        }
 
-        std::vector<InterfaceElement> interfaceElements_;
+        bool serializeDataJsonElement_(const UiModel &ui, size_t index, String &output, Configuration &configuration);
+        std::shared_ptr<const CachedJson> getDataJson_(Configuration &configuration);
+        void invalidateDataJson_();
+        void setConfigKey_(UiModel &ui, size_t elementIndex, const char* configKey);
+        std::shared_ptr<std::vector<RenderStep>> buildRenderPlan_(const UiModel &ui);
+        void renderStep_(const UiModel &ui, const RenderStep &step, String &output, Configuration &configuration);
 };
@@ -9,6 +9,16 @@ jsonData = "data.json";
 
 function load() {
     console.log('Esp32IotBase loaded');
+    // server rendered page: everything is already in place
+    if (document.body.hasAttribute("data-serverrendered")) {
+        return;
+    }
+    // bundled page: the server has already embedded data.json, so no further request is needed
+    var initialData = document.getElementById("initialdata");
+    if (initialData && initialData.textContent) {
+        buildSite(JSON.parse(initialData.textContent).elements);
+        return;
+    }
     var request = new XMLHttpRequest();
     function transferComplete() {
         var data = JSON.parse(this.responseText);
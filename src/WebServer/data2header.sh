@@ -2,11 +2,45 @@
 
 echo "Converting files in folder \"data\" to C Header file data.h"
 
+# --bundle: inline CSS & JS into index.htm, the server then also embeds data.json so the page needs a single request only
+[ "$1" == "--bundle" ] && BUNDLE=1
+
 DATA="data/"
 CURRDIR="$(pwd)"
 TMPDIR="$CURRDIR/tmp/"
+BUNDLEDIR="$CURRDIR/tmpbundle/"
 OUTFILE="$CURRDIR/InternalGzippedFilesContent.hpp"
 
+# FNV-1a, has to match InternalFilesHash() in InternalFiles.hpp
+fnv1a() {
+	local STR="$1" HASH=2166136261 POS CHAR
+	for ((POS = 0; POS < ${#STR}; POS++)); do
+		printf -v CHAR '%d' "'${STR:POS:1}"
+		HASH=$(( ((HASH ^ CHAR) * 16777619) & 0xFFFFFFFF ))
+	done
+	echo $HASH
+}
+
+urlpath() {
+	case "$1" in
+		index.htm) echo "/" ;;
+		*) echo "/$1" ;;
+	esac
+}
+
+contenttype() {
+	case "${1##*.}" in
+		htm|html) echo "text/html" ;;
+		css) echo "text/css" ;;
+		js) echo "text/javascript" ;;
+		svg) echo "image/svg+xml" ;;
+		json) echo "application/json" ;;
+		png) echo "image/png" ;;
+		ico) echo "image/x-icon" ;;
+		*) echo "application/octet-stream" ;;
+	esac
+}
+
 
 mkdir $TMPDIR
 #change into data folder
@@ -23,7 +57,61 @@ yui-compressor -o '.js$:.js' *.js
 #"> 
 #		<" becomes "><"
 sed  -i ':a;N;$!ba;s/>\s*</></g' *.htm
-gzip *
+
+# content hashes (used as ETag and for versioned URLs), the HTML files get calculated last as they refer to the others
+declare -A HASHES
+for i in $(ls -1 | grep -v '\.htm$'); do
+	HASHES[$i]=$(sha256sum $i | cut -c1-16)
+	# make references versioned, so they can be cached forever
+	sed -i "s#$i\"#$i?v=${HASHES[$i]}\"#g" *.htm
+done
+for i in $(ls -1 *.htm); do
+	HASHES[$i]=$(sha256sum $i | cut -c1-16)
+done
+
+if [ -n "$BUNDLE" ]; then
+	mkdir $BUNDLEDIR
+	# splits the page right where the server inserts data.json:
+	# - prefix.gz: gzip header + sync flushed (i.e. byte aligned and not final) deflate blocks
+	# - suffix: kept uncompressed, the server sends it in the final stored block right after the data
+	# - prefix: length and CRC-32 of the uncompressed prefix (needed for the gzip trailer)
+	python3 - $BUNDLEDIR <<'PYTHON'
+import glob, os, re, sys, zlib
+html = open('index.htm').read()
+# the files stay available on their own as well, the server rendered UI refers to them
+for name in glob.glob('*.css') + glob.glob('*.js'):
+	content = open(name).read()
+	if name.endswith('.css'):
+		html = re.sub(r'<link rel="stylesheet" href="%s(\?v=\w+)?">' % re.escape(name), lambda m: '<style>%s</style>' % content, html)
+	else:
+		html = re.sub(r'<script src="%s(\?v=\w+)?"\s*></script>' % re.escape(name), lambda m: '<script>%s</script>' % content, html)
+position = html.index('</head>')
+prefix = (html[:position] + '<script id="initialdata" type="application/json">').encode()
+suffix = ('</script>' + html[position:]).encode()
+compressor = zlib.compressobj(9, zlib.DEFLATED, -15)
+deflated = compressor.compress(prefix) + compressor.flush(zlib.Z_SYNC_FLUSH)
+# same header as gzip -n
+open(sys.argv[1] + 'prefix.gz', 'wb').write(b'\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03' + deflated)
+open(sys.argv[1] + 'suffix', 'wb').write(suffix)
+open(sys.argv[1] + 'prefix', 'w').write('%d 0x%08x' % (len(prefix), zlib.crc32(prefix)))
+os.remove('index.htm')
+PYTHON
+fi
+
+# compress every file with gzip and (if available) brotli
+# -n: leave out name & timestamp to get reproducible output
+declare -A SIZES
+for i in $(ls -1); do
+	SIZES[$i]=$(stat -c%s $i)
+	if command -v brotli >/dev/null; then
+		brotli -q 11 -o $i.br $i
+	fi
+	gzip -9 -n $i
+	# brotli is only worth it if it is actually smaller
+	if [ -f $i.br ] && [ $(stat -c%s $i.br) -ge $(stat -c%s $i.gz) ]; then
+		rm $i.br
+	fi
+done
 cat > $OUTFILE <<DELIMITER
 /*
    Esp32IotBase - ESP32 library to simplify the basics of IoT projects
@@ -33,8 +121,9 @@ cat > $OUTFILE <<DELIMITER
    */
 
 #include <pgmspace.h>
+#include "InternalFiles.hpp"
 //
-// converted data/* to gzipped flash variables
+// converted data/* to gzipped (and brotli compressed, if smaller) flash variables
 //
 
 
@@ -42,15 +131,76 @@ DELIMITER
 
 #convert contents into array of bytes
 INDEX=0
-for i in $(ls -1); do
+TABLE=""
+for i in $(ls -1 *.gz); do
+
+	ORIGINAL=${i%.gz}
+	FILENAME=${ORIGINAL//[.]/_}
+	printf "static const size_t k_"$FILENAME"_len = "${SIZES[$ORIGINAL]}";\n" >> $OUTFILE
+	printf "static const char k_"$FILENAME"_hash[] = \""${HASHES[$ORIGINAL]}"\";\n" >> $OUTFILE
+	BROTLI="nullptr, 0"
+	for ENCODING in gz br; do
+		[ -f $ORIGINAL.$ENCODING ] || continue
+		CONTENT=$(cat $ORIGINAL.$ENCODING | xxd -i)
+		CONTENT_LEN=$(echo $CONTENT | grep -o '0x' | wc -l)
+		printf "static const size_t k_"$FILENAME"_"$ENCODING"_len = "$CONTENT_LEN";\n" >> $OUTFILE
+		printf "static const uint8_t k_"$FILENAME"_"$ENCODING"[] = {\n$CONTENT\n};" >> $OUTFILE
+		echo >> $OUTFILE
+		unset CONTENT
+		[ $ENCODING == br ] && BROTLI="k_${FILENAME}_br, k_${FILENAME}_br_len"
+	done
+
+	PATHS[$INDEX]=$(urlpath $ORIGINAL)
+	TABLE+="    { \"${PATHS[$INDEX]}\", \"$(contenttype $ORIGINAL)\", k_${FILENAME}_len, k_${FILENAME}_hash, k_${FILENAME}_gz, k_${FILENAME}_gz_len, $BROTLI },\n"
+	INDEX=$((INDEX + 1))
+done
 
-	CONTENT=$(cat $i | xxd -i)
-	CONTENT_LEN=$(echo $CONTENT | grep -o '0x' | wc -l)
-	FILENAME=${i//[.]/_}
-	printf "static const size_t k_"$FILENAME"_len = "$CONTENT_LEN";\n" >> $OUTFILE
-	printf "static const uint8_t k_"$FILENAME"[] = {\n$CONTENT\n};" >> $OUTFILE
-	echo >> $OUTFILE
-	unset CONTENT
+# find the smallest number of buckets without any hash collisions (perfect hash)
+for ((BUCKETS = INDEX; ; BUCKETS++)); do
+	unset BUCKETINDEX
+	declare -A BUCKETINDEX
+	COLLISION=0
+	for ((FILE = 0; FILE < INDEX; FILE++)); do
+		BUCKET=$(( $(fnv1a "${PATHS[$FILE]}") % BUCKETS ))
+		if [ -n "${BUCKETINDEX[$BUCKET]}" ]; then
+			COLLISION=1
+			break
+		fi
+		BUCKETINDEX[$BUCKET]=$FILE
+	done
+	[ $COLLISION -eq 0 ] && break
+done
+
+if [ -n "$BUNDLE" ]; then
+	read PREFIX_LEN PREFIX_CRC < $BUNDLEDIR/prefix
+	printf "static const size_t k_index_htm_prefix_len = $PREFIX_LEN;\n" >> $OUTFILE
+	printf "static const uint32_t k_index_htm_prefix_crc = $PREFIX_CRC;\n" >> $OUTFILE
+	for PART in prefix.gz suffix; do
+		FILENAME=${PART//[.]/_}
+		CONTENT=$(cat $BUNDLEDIR/$PART | xxd -i)
+		CONTENT_LEN=$(echo $CONTENT | grep -o '0x' | wc -l)
+		printf "static const size_t k_index_htm_"$FILENAME"_len = "$CONTENT_LEN";\n" >> $OUTFILE
+		printf "static const uint8_t k_index_htm_"$FILENAME"[] = {\n$CONTENT\n};" >> $OUTFILE
+		echo >> $OUTFILE
+		unset CONTENT
+	done
+	printf "\n#define INTERNAL_FILES_BUNDLED_PAGE\n" >> $OUTFILE
+	printf "static constexpr InternalBundledPage kInternalBundledPage = { \"/\", k_index_htm_prefix_gz, k_index_htm_prefix_gz_len, k_index_htm_prefix_len, k_index_htm_prefix_crc, k_index_htm_suffix, k_index_htm_suffix_len };\n" >> $OUTFILE
+	rm $BUNDLEDIR/*
+	rmdir $BUNDLEDIR
+fi
+
+printf "\nstatic constexpr InternalFile kInternalFiles[] = {\n$TABLE};\n" >> $OUTFILE
+printf "\nstatic constexpr size_t kInternalFilesBuckets = $BUCKETS;\n" >> $OUTFILE
+printf "// bucket (hash %% kInternalFilesBuckets) -> index in kInternalFiles, -1 if empty\n" >> $OUTFILE
+printf "static constexpr int8_t kInternalFilesIndex[kInternalFilesBuckets] = {" >> $OUTFILE
+for ((BUCKET = 0; BUCKET < BUCKETS; BUCKET++)); do
+	printf " ${BUCKETINDEX[$BUCKET]:--1}," >> $OUTFILE
+done
+printf " };\n\n" >> $OUTFILE
+# make sure the C++ hash function agrees with ours
+for ((FILE = 0; FILE < INDEX; FILE++)); do
+	printf "static_assert(kInternalFilesIndex[InternalFilesHash(\"${PATHS[$FILE]}\") %% kInternalFilesBuckets] == $FILE, \"Hash mismatch for ${PATHS[$FILE]}\");\n" >> $OUTFILE
 done
 rm $TMPDIR/*
 rmdir $TMPDIR 2>/dev/null || (sleep 1 && rmdir $TMPDIR)
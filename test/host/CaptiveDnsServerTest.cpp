@@ -0,0 +1,151 @@
+#include "HostTest.hpp"
+#include "WebServer/CaptiveDnsServer.hpp"
+#include <esp_timer.h>
+#include <lwip/sockets.h>
+#include <sys/time.h>
+#include <vector>
+
+
+namespace {
+    const uint16_t kPort = 15353;
+    const uint16_t kTypeA = 1;
+    const uint16_t kTypeAaaa = 28;
+
+    CaptiveDnsServer& getServer()
+    {
+        static CaptiveDnsServer server;
+        static bool started = server.Begin(IPAddress(192, 168, 4, 1), kPort);
+        CHECK(started);
+        return server;
+    }
+
+    void appendUint16(std::vector<uint8_t> &message, uint16_t value)
+    {
+        message.push_back(value >> 8);
+        message.push_back(value & 0xff);
+    }
+
+    uint16_t readUint16(const std::vector<uint8_t> &message, size_t position)
+    {
+        return (message[position] << 8) | message[position + 1];
+    }
+
+    // standard query (recursion desired) with a single question
+    std::vector<uint8_t> buildQuery(const char* name, uint16_t type, uint16_t flags = 0x0100)
+    {
+        std::vector<uint8_t> message;
+        appendUint16(message, 0x1234);
+        appendUint16(message, flags);
+        appendUint16(message, 1);
+        appendUint16(message, 0);
+        appendUint16(message, 0);
+        appendUint16(message, 0);
+        while (*name) {
+            const char* end = strchr(name, '.');
+            size_t length = end ? end - name : strlen(name);
+            message.push_back(length);
+            message.insert(message.end(), name, name + length);
+            name += length + (end ? 1 : 0);
+        }
+        message.push_back(0);
+        appendUint16(message, type);
+        appendUint16(message, 1);
+        return message;
+    }
+
+    // returns the response, empty if there is none
+    std::vector<uint8_t> query(const std::vector<uint8_t> &message)
+    {
+        getServer();
+        int client = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        struct timeval timeout = {0, 300 * 1000};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(kPort);
+        sendto(client, message.data(), message.size(), 0, (struct sockaddr*) &address, sizeof(address));
+
+        std::vector<uint8_t> response(512);
+        ssize_t length = recv(client, response.data(), response.size(), 0);
+        close(client);
+        response.resize(length > 0 ? length : 0);
+        return response;
+    }
+}
+
+TEST(AnswersAQueriesWithOwnAddress)
+{
+    std::vector<uint8_t> message = buildQuery("connectivitycheck.gstatic.com", kTypeA);
+    std::vector<uint8_t> response = query(message);
+    CHECK(response.size() == message.size() + 16);
+    if (response.size() != message.size() + 16)
+        return;
+    CHECK(readUint16(response, 0) == 0x1234);
+    // response, authoritative, recursion desired and available
+    CHECK(readUint16(response, 2) == 0x8580);
+    CHECK(readUint16(response, 4) == 1);
+    CHECK(readUint16(response, 6) == 1);
+    CHECK(std::equal(message.begin() + 12, message.end(), response.begin() + 12));
+    const uint8_t answer[] = { 0xc0, 0x0c, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x04, 192, 168, 4, 1 };
+    CHECK(memcmp(response.data() + message.size(), answer, sizeof(answer)) == 0);
+}
+
+TEST(AnswersOtherTypesWithoutRecords)
+{
+    std::vector<uint8_t> message = buildQuery("example.com", kTypeAaaa);
+    std::vector<uint8_t> response = query(message);
+    CHECK(response.size() == message.size());
+    if (response.size() == message.size())
+        CHECK(readUint16(response, 6) == 0);
+}
+
+TEST(DropsAdditionalRecords)
+{
+    std::vector<uint8_t> message = buildQuery("example.com", kTypeA);
+    size_t questionEnd = message.size();
+    // EDNS OPT record
+    message[11] = 1;
+    const uint8_t opt[] = { 0x00, 0x00, 0x29, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    message.insert(message.end(), opt, opt + sizeof(opt));
+    std::vector<uint8_t> response = query(message);
+    CHECK(response.size() == questionEnd + 16);
+    if (response.size() == questionEnd + 16)
+        CHECK(readUint16(response, 10) == 0);
+}
+
+TEST(IgnoresInvalidQueries)
+{
+    // a response
+    CHECK(query(buildQuery("example.com", kTypeA, 0x8180)).empty());
+    // shorter than a header
+    CHECK(query(std::vector<uint8_t>(5, 0)).empty());
+    // name running past the end
+    std::vector<uint8_t> truncated = buildQuery("example.com", kTypeA);
+    truncated.resize(truncated.size() - 6);
+    CHECK(query(truncated).empty());
+    // compressed name
+    std::vector<uint8_t> compressed = buildQuery("", kTypeA);
+    compressed.insert(compressed.begin() + 12, { 0xc0, 0x0c });
+    compressed.erase(compressed.begin() + 14);
+    CHECK(query(compressed).empty());
+}
+
+TEST(CountsQueries)
+{
+    CaptiveDnsServer::Statistics before = getServer().GetStatistics();
+    CHECK(!query(buildQuery("example.com", kTypeA)).empty());
+    CHECK(query(std::vector<uint8_t>(5, 0)).empty());
+
+    // the statistics get updated right after sending
+    CaptiveDnsServer::Statistics after;
+    int64_t timeout = esp_timer_get_time() + 1000 * 1000;
+    do {
+        after = getServer().GetStatistics();
+    } while (after.queries < before.queries + 2 && esp_timer_get_time() < timeout);
+    CHECK(after.queries == before.queries + 2);
+    CHECK(after.answered == before.answered + 1);
+    CHECK(after.ignored == before.ignored + 1);
+    CHECK(after.minUs <= after.maxUs);
+    CHECK(after.totalUs >= after.maxUs);
+}
@@ -0,0 +1,145 @@
+#include "HostTest.hpp"
+#include "HostNvs.hpp"
+#include "WebServer/ConfigUpdate.hpp"
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+    struct Fixture {
+        Configuration configuration;
+        size_t changes = 0;
+
+        Fixture() {
+            HostNvsReset();
+            configuration.Begin();
+            configuration.OnChange([this]() { changes++; });
+        }
+    };
+
+    std::vector<const char*> getAccessibleKeys()
+    {
+        std::vector<const char*> keys;
+        for (ConfigKey key : ConfigKey::_values()) {
+            if (ConfigUpdate::IsKeyAccessible(key._to_string()))
+                keys.push_back(key._to_string());
+        }
+        return keys;
+    }
+}
+
+TEST(RefusesUnknownAndInternalKeys)
+{
+    ConfigUpdate update;
+    CHECK(!update.Add("NoSuchKey", "value"));
+    CHECK(!update.Add("QuickBootCount", "0"));
+    CHECK(update.Add("DeviceName", "device"));
+    CHECK(!ConfigUpdate::IsKeyAccessible("devicename"));
+    CHECK(ConfigUpdate::IsSecret(ConfigKey::WifiPassword));
+    CHECK(!ConfigUpdate::IsSecret(ConfigKey::WifiSsid));
+}
+
+TEST(WritesChangedKeysOnlyAndSavesOnce)
+{
+    Fixture fixture;
+    fixture.configuration.Set(ConfigKey::DeviceName, "device");
+    HostNvsStats before = HostNvsGetStats();
+    size_t changesBefore = fixture.changes;
+
+    ConfigUpdate update;
+    CHECK(update.Add("DeviceName", "device"));
+    CHECK(update.Add("MqttHost", "broker"));
+    CHECK(update.Add("MqttUser", "user"));
+    ConfigUpdate::Result result = update.Apply(fixture.configuration, [](const ConfigKey&) { return true; });
+
+    CHECK(result.changed.size() == 2);
+    CHECK(result.changed.size() == 2 && strcmp(result.changed[0], "MqttHost") == 0 && strcmp(result.changed[1], "MqttUser") == 0);
+    CHECK(!result.restartRequired);
+    CHECK(fixture.configuration.Get(ConfigKey::MqttHost) == "broker");
+    CHECK(HostNvsGetStats().writes == before.writes + 2);
+    CHECK(HostNvsGetStats().commits == before.commits + 1);
+    CHECK(fixture.changes == changesBefore + 2);
+}
+
+TEST(SavesNothingWithoutChanges)
+{
+    Fixture fixture;
+    fixture.configuration.Set(ConfigKey::DeviceName, "device");
+    HostNvsStats before = HostNvsGetStats();
+
+    ConfigUpdate update;
+    update.Add("DeviceName", "device");
+    ConfigUpdate::Result result = update.Apply(fixture.configuration, nullptr);
+
+    CHECK(result.changed.empty());
+    CHECK(!result.restartRequired);
+    CHECK(HostNvsGetStats().writes == before.writes);
+    CHECK(HostNvsGetStats().commits == before.commits);
+}
+
+TEST(RequiresRestartForKeysNotAppliedAtRuntime)
+{
+    Fixture fixture;
+    std::vector<std::string> applied;
+    auto applyFunc = [&applied](const ConfigKey &key) {
+        applied.push_back(key._to_string());
+        return key != +ConfigKey::WifiSsid;
+    };
+
+    ConfigUpdate runtime;
+    runtime.Add("SyslogServer", "logs");
+    CHECK(!runtime.Apply(fixture.configuration, applyFunc).restartRequired);
+
+    ConfigUpdate restart;
+    restart.Add("WifiSsid", "network");
+    restart.Add("MqttHost", "broker");
+    CHECK(restart.Apply(fixture.configuration, applyFunc).restartRequired);
+    CHECK(applied.size() == 3);
+
+    // and without any runtime support at all
+    ConfigUpdate unsupported;
+    unsupported.Add("MqttUser", "user");
+    CHECK(unsupported.Apply(fixture.configuration, nullptr).restartRequired);
+}
+
+TEST(AppliesTenThousandSingleKeyUpdates)
+{
+    Fixture fixture;
+    std::vector<const char*> keys = getAccessibleKeys();
+    const char* values[] = { "first", "second", "third" };
+    std::map<std::string, std::string> expected;
+    size_t expectedChanges = 0;
+    size_t failures = 0;
+    std::minstd_rand random(42);
+    HostNvsStats before = HostNvsGetStats();
+
+    for (size_t i = 0; i < 10000; i++) {
+        const char* key = keys[i % keys.size()];
+        // about a third of the updates change nothing
+        const char* value = values[random() % 3];
+        bool changes = expected[key] != value;
+
+        ConfigUpdate update;
+        if (!update.Add(key, value))
+            failures++;
+        ConfigUpdate::Result result = update.Apply(fixture.configuration, [](const ConfigKey&) { return true; });
+        if (result.changed.size() != (changes ? 1 : 0) || (changes && strcmp(result.changed[0], key) != 0) || result.restartRequired)
+            failures++;
+        if (fixture.configuration.Get(key) != value)
+            failures++;
+        expected[key] = value;
+        expectedChanges += changes;
+    }
+
+    CHECK(failures == 0);
+    CHECK(expectedChanges > 1000 && expectedChanges < 10000);
+    CHECK(fixture.changes == expectedChanges);
+    CHECK(HostNvsGetStats().writes == before.writes + expectedChanges);
+    CHECK(HostNvsGetStats().commits == before.commits + expectedChanges);
+    for (const auto &entry : expected)
+        CHECK(fixture.configuration.Get(entry.first.c_str()) == entry.second.c_str());
+    // not accessible, so never touched
+    CHECK(fixture.configuration.GetRaw("QuickBootCount").isEmpty());
+}
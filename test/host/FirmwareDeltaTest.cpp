@@ -0,0 +1,244 @@
+#include "HostTest.hpp"
+#include "HostFlash.hpp"
+#include "FirmwareDelta.hpp"
+#include <mbedtls/sha256.h>
+#include <esp_timer.h>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+namespace {
+    typedef std::vector<uint8_t> Bytes;
+
+    Bytes createImage(size_t size, unsigned seed)
+    {
+        std::minstd_rand random(seed);
+        Bytes image(size);
+        for (uint8_t &byte : image)
+            byte = random();
+        image[0] = 0xe9;
+        return image;
+    }
+
+    Bytes getSha256(const Bytes &data)
+    {
+        Bytes sha256(FirmwareUpdater::kSha256Length);
+        mbedtls_sha256_context context;
+        mbedtls_sha256_init(&context);
+        mbedtls_sha256_starts_ret(&context, 0);
+        mbedtls_sha256_update_ret(&context, data.data(), data.size());
+        mbedtls_sha256_finish_ret(&context, sha256.data());
+        mbedtls_sha256_free(&context);
+        return sha256;
+    }
+
+    void appendUint32(Bytes &data, uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+            data.push_back(value >> (8 * i));
+    }
+
+    // builds a patch (see FirmwareDelta.hpp) along with the image it produces
+    class Patch {
+        public:
+            Bytes data;
+            Bytes image;
+
+            explicit Patch(const Bytes &source) : source_(source) {}
+
+            void Copy(uint32_t offset, uint32_t length) {
+                data.push_back(0x01);
+                appendUint32(data, offset);
+                appendUint32(data, length);
+                image.insert(image.end(), source_.begin() + offset, source_.begin() + offset + length);
+            }
+            void Add(uint32_t offset, const Bytes &delta) {
+                data.push_back(0x02);
+                appendUint32(data, offset);
+                appendUint32(data, delta.size());
+                data.insert(data.end(), delta.begin(), delta.end());
+                for (size_t i = 0; i < delta.size(); i++)
+                    image.push_back(source_[offset + i] + delta[i]);
+            }
+            void Insert(const Bytes &bytes) {
+                data.push_back(0x03);
+                appendUint32(data, bytes.size());
+                data.insert(data.end(), bytes.begin(), bytes.end());
+                image.insert(image.end(), bytes.begin(), bytes.end());
+            }
+            // the header goes first, so this has to be the last call
+            Bytes Finish() {
+                data.push_back(0x00);
+                Bytes patch = { 'I', 'B', 'D', '1' };
+                appendUint32(patch, source_.size());
+                Bytes sourceSha256 = getSha256(source_);
+                patch.insert(patch.end(), sourceSha256.begin(), sourceSha256.end());
+                appendUint32(patch, image.size());
+                Bytes imageSha256 = getSha256(image);
+                patch.insert(patch.end(), imageSha256.begin(), imageSha256.end());
+                patch.insert(patch.end(), data.begin(), data.end());
+                return patch;
+            }
+
+        private:
+            const Bytes &source_;
+    };
+
+    Bytes createSource()
+    {
+        Bytes source = createImage(60 * 1000, 1);
+        HostFlashReset(source);
+        return source;
+    }
+
+    // a typical patch: changed header, unchanged code, code with adjusted addresses, new code
+    Patch createPatch(const Bytes &source)
+    {
+        Patch patch(source);
+        patch.Insert(createImage(100, 2));
+        patch.Copy(100, 20000);
+        Bytes delta(15000);
+        for (size_t i = 0; i < delta.size(); i += 4)
+            delta[i] = 4;
+        patch.Add(20100, delta);
+        patch.Insert(Bytes(3000, 0x55));
+        patch.Copy(0, 1);
+        return patch;
+    }
+
+    bool writeInPieces(FirmwareDelta &delta, const Bytes &patch, size_t pieceLength)
+    {
+        for (size_t offset = 0; offset < patch.size(); offset += pieceLength) {
+            if (!delta.Write(patch.data() + offset, std::min(pieceLength, patch.size() - offset)))
+                return false;
+        }
+        return true;
+    }
+
+    // returns false if the writer does not finish in time
+    bool finish(FirmwareUpdater &updater)
+    {
+        updater.End();
+        int64_t timeout = esp_timer_get_time() + 5 * 1000 * 1000;
+        while (!updater.Poll()) {
+            if (esp_timer_get_time() > timeout)
+                return false;
+            vTaskDelay(1);
+        }
+        return true;
+    }
+
+    bool isWrittenAsIs(const Bytes &image)
+    {
+        Bytes partition = HostFlashGetUpdatePartition();
+        return std::equal(image.begin(), image.end(), partition.begin());
+    }
+}
+
+TEST(AppliesPatchesWhateverTheyAreSplitInto)
+{
+    Bytes source = createSource();
+    Patch patch = createPatch(source);
+    Bytes data = patch.Finish();
+    FirmwareUpdater updater;
+    FirmwareDelta delta(updater);
+    CHECK(FirmwareDelta::IsDelta(data.data(), data.size()));
+
+    // single bytes split every header field and command, odd pieces split the data
+    for (size_t pieceLength : { (size_t) 1, (size_t) 1436, data.size() }) {
+        HostFlashReset(source);
+        delta.Reset();
+        CHECK(writeInPieces(delta, data, pieceLength));
+        CHECK(delta.IsComplete());
+        CHECK(delta.GetError() == nullptr);
+        CHECK(delta.GetImageSize() == patch.image.size());
+        CHECK(finish(updater));
+        CHECK(updater.GetError() == ESP_OK);
+        CHECK(isWrittenAsIs(patch.image));
+        CHECK(HostFlashGetStats().bootPartitionSet);
+    }
+}
+
+TEST(RequiresExpectedImage)
+{
+    Bytes source = createSource();
+    Patch patch = createPatch(source);
+    Bytes data = patch.Finish();
+    FirmwareUpdater updater;
+    FirmwareDelta delta(updater);
+
+    Bytes otherSha256 = getSha256(source);
+    delta.Reset(otherSha256.data());
+    CHECK(!delta.Write(data.data(), data.size()));
+    CHECK(delta.GetError() != nullptr);
+    CHECK(!updater.IsRunning());
+
+    Bytes sha256 = getSha256(patch.image);
+    delta.Reset(sha256.data());
+    CHECK(delta.Write(data.data(), data.size()));
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_OK);
+}
+
+TEST(RefusesPatchesForOtherFirmware)
+{
+    Bytes source = createSource();
+    Patch patch = createPatch(source);
+    Bytes data = patch.Finish();
+    HostFlashReset(createImage(source.size(), 3));
+
+    FirmwareUpdater updater;
+    FirmwareDelta delta(updater);
+    delta.Reset();
+    // the running firmware gets checked by the updater, before anything is written
+    delta.Write(data.data(), data.size());
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_ERR_INVALID_VERSION);
+    CHECK(HostFlashGetStats().writes == 0);
+}
+
+TEST(RefusesBrokenPatches)
+{
+    Bytes source = createSource();
+    FirmwareUpdater updater;
+    FirmwareDelta delta(updater);
+
+    Bytes image = createImage(100, 4);
+    CHECK(!FirmwareDelta::IsDelta(image.data(), image.size()));
+    delta.Reset();
+    CHECK(!delta.Write(image.data(), image.size()));
+    CHECK(strcmp(delta.GetError(), "Not a firmware patch.") == 0);
+    CHECK(!updater.IsRunning());
+
+    // each broken patch gets applied as far as it goes, the caller aborts the update then
+    struct Broken {
+        const char* error;
+        std::function<void(Bytes &data)> breakFunc;
+    };
+    const size_t endOfCopy = FirmwareDelta::kHeaderLength + 9;
+    const Broken brokenPatches[] = {
+        { "Patch produces more than the image size.", [](Bytes &data) {
+            Bytes copy = { 0x01, 0, 0, 0, 0, 0xff, 0xff, 0, 0 };
+            data.insert(data.end() - 1, copy.begin(), copy.end());
+        } },
+        { "Patch ended before the image was complete.", [endOfCopy](Bytes &data) { data.insert(data.begin() + endOfCopy, 0x00); } },
+        { "Data after the end of the patch.", [](Bytes &data) { data.push_back(0x00); } },
+        { "Unknown patch command.", [](Bytes &data) { data.insert(data.end() - 1, 0x04); } },
+    };
+    for (const Broken &broken : brokenPatches) {
+        HostFlashReset(source);
+        Patch patch(source);
+        patch.Copy(0, 1000);
+        patch.Insert(Bytes(1000, 0x55));
+        Bytes data = patch.Finish();
+        broken.breakFunc(data);
+
+        delta.Reset();
+        CHECK(!delta.Write(data.data(), data.size()));
+        CHECK(delta.GetError() && strcmp(delta.GetError(), broken.error) == 0);
+        updater.Abort();
+        CHECK(!updater.IsRunning());
+        CHECK(!HostFlashGetStats().bootPartitionSet);
+    }
+}
@@ -0,0 +1,246 @@
+#include "HostTest.hpp"
+#include "HostFlash.hpp"
+#include "FirmwareUpdater.hpp"
+#include <mbedtls/sha256.h>
+#include <esp_timer.h>
+#include <random>
+#include <vector>
+
+
+namespace {
+    typedef std::vector<uint8_t> Bytes;
+
+    // starts with the image magic byte
+    Bytes createImage(size_t size, unsigned seed)
+    {
+        std::minstd_rand random(seed);
+        Bytes image(size);
+        for (uint8_t &byte : image)
+            byte = random();
+        image[0] = 0xe9;
+        return image;
+    }
+
+    Bytes getSha256(const Bytes &data)
+    {
+        Bytes sha256(FirmwareUpdater::kSha256Length);
+        mbedtls_sha256_context context;
+        mbedtls_sha256_init(&context);
+        mbedtls_sha256_starts_ret(&context, 0);
+        mbedtls_sha256_update_ret(&context, data.data(), data.size());
+        mbedtls_sha256_finish_ret(&context, sha256.data());
+        mbedtls_sha256_free(&context);
+        return sha256;
+    }
+
+    // in pieces of the size of a typical TCP segment
+    bool writeAll(FirmwareUpdater &updater, const Bytes &data)
+    {
+        for (size_t offset = 0; offset < data.size(); offset += 1436) {
+            if (!updater.Write(data.data() + offset, std::min<size_t>(data.size() - offset, 1436)))
+                return false;
+        }
+        return true;
+    }
+
+    // returns false if the writer does not finish in time
+    bool finish(FirmwareUpdater &updater)
+    {
+        updater.End();
+        int64_t timeout = esp_timer_get_time() + 5 * 1000 * 1000;
+        while (!updater.Poll()) {
+            if (esp_timer_get_time() > timeout)
+                return false;
+            vTaskDelay(1);
+        }
+        return true;
+    }
+
+    bool isWrittenAsIs(const Bytes &image)
+    {
+        Bytes partition = HostFlashGetUpdatePartition();
+        return std::equal(image.begin(), image.end(), partition.begin());
+    }
+
+    // the sectors holding the image exactly once, the others not at all
+    bool isErasedOnce(size_t imageSize)
+    {
+        HostFlashStats stats = HostFlashGetStats();
+        for (size_t sector = 0; sector < stats.sectorErases.size(); sector++) {
+            if (stats.sectorErases[sector] != (sector * SPI_FLASH_SEC_SIZE < imageSize ? 1u : 0u))
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST(WritesHashesAndActivatesImage)
+{
+    HostFlashReset(Bytes());
+    Bytes image = createImage(150 * 1000 + 7, 1);
+    Bytes sha256 = getSha256(image);
+    FirmwareUpdater updater;
+    std::vector<size_t> progress;
+
+    CHECK(updater.Begin(image.size(), sha256.data(), [&progress](size_t written) { progress.push_back(written); }));
+    CHECK(updater.IsRunning());
+    CHECK(writeAll(updater, image));
+    CHECK(finish(updater));
+
+    CHECK(!updater.IsRunning());
+    CHECK(updater.GetError() == ESP_OK);
+    CHECK(updater.GetWritten() == image.size());
+    CHECK(memcmp(updater.GetSha256(), sha256.data(), sha256.size()) == 0);
+    CHECK(isWrittenAsIs(image));
+    CHECK(isErasedOnce(image.size()));
+    CHECK(HostFlashGetStats().bootPartitionSet);
+    // every 64 KB
+    CHECK(progress.size() == 2);
+    CHECK(progress.size() == 2 && progress[0] >= 64 * 1024 && progress[1] >= progress[0] + 64 * 1024);
+}
+
+TEST(WritesImagesOfUnknownSize)
+{
+    HostFlashReset(Bytes());
+    Bytes image = createImage(3 * SPI_FLASH_SEC_SIZE, 2);
+    FirmwareUpdater updater;
+    CHECK(updater.Begin(0));
+    CHECK(writeAll(updater, image));
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_OK);
+    CHECK(memcmp(updater.GetSha256(), getSha256(image).data(), FirmwareUpdater::kSha256Length) == 0);
+    CHECK(isErasedOnce(image.size()));
+}
+
+TEST(RefusesMismatchingImages)
+{
+    Bytes image = createImage(20 * 1000, 3);
+    Bytes otherSha256 = getSha256(createImage(20 * 1000, 4));
+
+    HostFlashReset(Bytes());
+    FirmwareUpdater updater;
+    CHECK(updater.Begin(image.size(), otherSha256.data()));
+    CHECK(writeAll(updater, image));
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_ERR_INVALID_CRC);
+    CHECK(!HostFlashGetStats().bootPartitionSet);
+
+    // shorter than announced
+    HostFlashReset(Bytes());
+    CHECK(updater.Begin(image.size() + 1));
+    CHECK(writeAll(updater, image));
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_ERR_INVALID_SIZE);
+    CHECK(!HostFlashGetStats().bootPartitionSet);
+
+    // longer than announced
+    HostFlashReset(Bytes());
+    CHECK(updater.Begin(image.size() - 1));
+    CHECK(!writeAll(updater, image));
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_ERR_INVALID_SIZE);
+
+    // larger than the partition
+    CHECK(!updater.Begin(kHostFlashPartitionSize + 1));
+    CHECK(!updater.IsRunning());
+
+    // not an app image, as verified by esp_ota_set_boot_partition()
+    HostFlashReset(Bytes());
+    image[0] = 0;
+    CHECK(updater.Begin(image.size()));
+    CHECK(writeAll(updater, image));
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_ERR_OTA_VALIDATE_FAILED);
+}
+
+TEST(AssemblesImageFromRunningFirmware)
+{
+    Bytes running = createImage(100 * 1000, 5);
+    HostFlashReset(running);
+    Bytes head = createImage(5000, 6);
+    Bytes delta(30000);
+    for (size_t i = 0; i < delta.size(); i++)
+        delta[i] = i % 3;
+    Bytes tail = createImage(777, 7);
+
+    // head, a copy across several sectors, an added part right after it (so both are in the same sector), the tail
+    Bytes image(head);
+    image.insert(image.end(), running.begin() + 1234, running.begin() + 1234 + 40000);
+    for (size_t i = 0; i < delta.size(); i++)
+        image.push_back(running[60000 + i] + delta[i]);
+    image.insert(image.end(), tail.begin(), tail.end());
+
+    FirmwareUpdater updater;
+    CHECK(updater.Begin(image.size(), getSha256(image).data(), nullptr, running.size(), getSha256(running).data()));
+    CHECK(updater.Write(head.data(), head.size()));
+    CHECK(updater.WriteCopied(1234, 40000));
+    CHECK(updater.WriteAdded(60000, delta.data(), delta.size()));
+    CHECK(updater.Write(tail.data(), tail.size()));
+    CHECK(finish(updater));
+
+    CHECK(updater.GetError() == ESP_OK);
+    CHECK(isWrittenAsIs(image));
+    CHECK(isErasedOnce(image.size()));
+    CHECK(HostFlashGetStats().bootPartitionSet);
+}
+
+TEST(ChecksRunningFirmwareBeforeWriting)
+{
+    Bytes running = createImage(10 * 1000, 8);
+    HostFlashReset(running);
+    Bytes otherSha256 = getSha256(createImage(10 * 1000, 9));
+
+    FirmwareUpdater updater;
+    CHECK(updater.Begin(0, nullptr, nullptr, running.size(), otherSha256.data()));
+    updater.WriteCopied(0, 5000);
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_ERR_INVALID_VERSION);
+    CHECK(HostFlashGetStats().writes == 0);
+    CHECK(isErasedOnce(0));
+
+    // nothing beyond the running image
+    HostFlashReset(running);
+    CHECK(updater.Begin(0, nullptr, nullptr, running.size()));
+    updater.WriteCopied(running.size() - 10, 20);
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_ERR_INVALID_SIZE);
+    CHECK(!HostFlashGetStats().bootPartitionSet);
+}
+
+TEST(StopsOnFlashErrors)
+{
+    HostFlashReset(Bytes());
+    HostFlashFailWritesFrom(50 * 1000, ESP_FAIL);
+    Bytes image = createImage(100 * 1000, 10);
+
+    FirmwareUpdater updater;
+    CHECK(updater.Begin(image.size()));
+    // the error shows up in Write() once the writer has got there
+    writeAll(updater, image);
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_FAIL);
+    CHECK(updater.GetWritten() < 50 * 1000);
+    CHECK(!HostFlashGetStats().bootPartitionSet);
+}
+
+TEST(AbortsAndStartsOver)
+{
+    HostFlashReset(Bytes());
+    Bytes image = createImage(40 * 1000, 11);
+
+    FirmwareUpdater updater;
+    CHECK(updater.Begin(image.size()));
+    CHECK(updater.Write(image.data(), 10 * 1000));
+    // only one at a time
+    CHECK(!updater.Begin(image.size()));
+    updater.Abort();
+    CHECK(!updater.IsRunning());
+    CHECK(!HostFlashGetStats().bootPartitionSet);
+
+    CHECK(updater.Begin(image.size()));
+    CHECK(writeAll(updater, image));
+    CHECK(finish(updater));
+    CHECK(updater.GetError() == ESP_OK);
+    CHECK(isWrittenAsIs(image));
+    CHECK(HostFlashGetStats().bootPartitionSet);
+}
@@ -0,0 +1,175 @@
+#include "HostTest.hpp"
+#include "GzipInflater.hpp"
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+namespace {
+    typedef std::vector<uint8_t> Bytes;
+
+    const uint8_t kFlagHeaderCrc = 0x02;
+    const uint8_t kFlagExtra = 0x04;
+    const uint8_t kFlagName = 0x08;
+    const uint8_t kFlagComment = 0x10;
+
+    // compressible, but not too much: runs of random bytes repeating at random distances
+    Bytes createData(size_t size)
+    {
+        std::minstd_rand random(1);
+        Bytes data;
+        while (data.size() < size) {
+            if (data.size() > 1000 && random() % 2) {
+                size_t start = data.size() - 1 - random() % 1000;
+                for (size_t i = 0; i < 50 && data.size() < size; i++)
+                    data.push_back(data[start + i]);
+            } else {
+                for (size_t i = 0; i < 50 && data.size() < size; i++)
+                    data.push_back(random());
+            }
+        }
+        return data;
+    }
+
+    Bytes deflate(const Bytes &data)
+    {
+        z_stream stream = {};
+        deflateInit2(&stream, 9, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+        Bytes compressed(deflateBound(&stream, data.size()));
+        stream.next_in = const_cast<uint8_t*>(data.data());
+        stream.avail_in = data.size();
+        stream.next_out = compressed.data();
+        stream.avail_out = compressed.size();
+        deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+        return compressed;
+    }
+
+    // as described in RFC 1952, with the optional header fields selected by flags
+    Bytes gzip(const Bytes &data, uint8_t flags)
+    {
+        Bytes gzipped = { 0x1f, 0x8b, 0x08, flags, 0x12, 0x34, 0x56, 0x78, 0x02, 0x03 };
+        if (flags & kFlagExtra) {
+            Bytes extra(300, 0xee);
+            gzipped.push_back(extra.size() & 0xff);
+            gzipped.push_back(extra.size() >> 8);
+            gzipped.insert(gzipped.end(), extra.begin(), extra.end());
+        }
+        if (flags & kFlagName) {
+            const char name[] = "firmware.bin";
+            gzipped.insert(gzipped.end(), name, name + sizeof(name));
+        }
+        if (flags & kFlagComment) {
+            const char comment[] = "a comment";
+            gzipped.insert(gzipped.end(), comment, comment + sizeof(comment));
+        }
+        if (flags & kFlagHeaderCrc) {
+            uint32_t crc = crc32(0, gzipped.data(), gzipped.size());
+            gzipped.push_back(crc & 0xff);
+            gzipped.push_back((crc >> 8) & 0xff);
+        }
+        Bytes compressed = deflate(data);
+        gzipped.insert(gzipped.end(), compressed.begin(), compressed.end());
+        uint32_t trailer[] = { static_cast<uint32_t>(crc32(0, data.data(), data.size())), static_cast<uint32_t>(data.size()) };
+        gzipped.insert(gzipped.end(), reinterpret_cast<uint8_t*>(trailer), reinterpret_cast<uint8_t*>(trailer) + sizeof(trailer));
+        return gzipped;
+    }
+
+    struct Result {
+        bool written = true;
+        Bytes output;
+        size_t largestChunk = 0;
+    };
+
+    Result inflate(GzipInflater &inflater, const Bytes &gzipped, size_t pieceLength)
+    {
+        Result result;
+        CHECK(inflater.Begin([&result](const uint8_t* data, size_t length) {
+            result.output.insert(result.output.end(), data, data + length);
+            result.largestChunk = std::max(result.largestChunk, length);
+            return true;
+        }));
+        for (size_t offset = 0; offset < gzipped.size() && result.written; offset += pieceLength)
+            result.written = inflater.Write(gzipped.data() + offset, std::min(pieceLength, gzipped.size() - offset));
+        return result;
+    }
+}
+
+TEST(InflatesWithAnyHeaderFields)
+{
+    Bytes data = createData(100 * 1000);
+    GzipInflater inflater;
+    const uint8_t flagCombinations[] = { 0, kFlagExtra, kFlagName, kFlagComment, kFlagHeaderCrc, kFlagExtra | kFlagName | kFlagComment | kFlagHeaderCrc };
+    for (uint8_t flags : flagCombinations) {
+        Bytes gzipped = gzip(data, flags);
+        CHECK(GzipInflater::IsGzip(gzipped.data(), gzipped.size()));
+        // single bytes split every header field
+        for (size_t pieceLength : { (size_t) 1, (size_t) 1436, gzipped.size() }) {
+            Result result = inflate(inflater, gzipped, pieceLength);
+            CHECK(result.written);
+            CHECK(inflater.IsComplete());
+            CHECK(inflater.GetError() == nullptr);
+            CHECK(inflater.GetOutputLength() == data.size());
+            CHECK(result.output == data);
+            // the output gets handed over straight from the window
+            CHECK(result.largestChunk <= GzipInflater::kWindowSize);
+            inflater.End();
+        }
+    }
+}
+
+TEST(InflatesEmptyData)
+{
+    GzipInflater inflater;
+    Result result = inflate(inflater, gzip(Bytes(), 0), 1);
+    CHECK(result.written);
+    CHECK(inflater.IsComplete());
+    CHECK(result.output.empty());
+}
+
+TEST(RefusesInvalidData)
+{
+    Bytes data = createData(1000);
+    GzipInflater inflater;
+
+    Bytes notGzip = data;
+    CHECK(!GzipInflater::IsGzip(notGzip.data(), notGzip.size()));
+    CHECK(!inflate(inflater, notGzip, notGzip.size()).written);
+    CHECK(inflater.GetError() && strcmp(inflater.GetError(), "Not gzip data.") == 0);
+
+    // only deflate is supported
+    Bytes otherMethod = gzip(data, 0);
+    otherMethod[2] = 7;
+    CHECK(!inflate(inflater, otherMethod, 1).written);
+    CHECK(inflater.GetError() && strcmp(inflater.GetError(), "Not gzip data.") == 0);
+
+    // a final block of the reserved type
+    Bytes invalidBlock = gzip(data, kFlagName);
+    invalidBlock[10 + sizeof("firmware.bin")] = 0x07;
+    CHECK(!inflate(inflater, invalidBlock, invalidBlock.size()).written);
+    CHECK(inflater.GetError() && strcmp(inflater.GetError(), "Invalid compressed data.") == 0);
+    CHECK(!inflater.IsComplete());
+
+    // not complete without the end of the compressed data
+    Bytes truncated = gzip(data, 0);
+    truncated.resize(truncated.size() / 2);
+    CHECK(inflate(inflater, truncated, 100).written);
+    CHECK(!inflater.IsComplete());
+    inflater.End();
+}
+
+TEST(StopsWhenOutputFails)
+{
+    Bytes gzipped = gzip(createData(100 * 1000), 0);
+    GzipInflater inflater;
+    size_t outputs = 0;
+    CHECK(inflater.Begin([&outputs](const uint8_t*, size_t) { return ++outputs < 2; }));
+    CHECK(!inflater.Write(gzipped.data(), gzipped.size()));
+    CHECK(outputs == 2);
+    // the data is fine
+    CHECK(inflater.GetError() == nullptr);
+    CHECK(!inflater.Write(gzipped.data(), gzipped.size()));
+    CHECK(outputs == 2);
+    inflater.End();
+}
@@ -0,0 +1,39 @@
+#include "HostTest.hpp"
+#include <vector>
+
+
+namespace {
+    struct Test {
+        const char* name;
+        HostTestFunc func;
+    };
+
+    std::vector<Test>& getTests()
+    {
+        static std::vector<Test> tests;
+        return tests;
+    }
+
+    int failures = 0;
+}
+
+HostTestRegistration::HostTestRegistration(const char* name, HostTestFunc func)
+{
+    getTests().push_back({name, func});
+}
+
+void HostTestFail(const char* file, int line, const char* expression)
+{
+    fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+    failures++;
+}
+
+int main()
+{
+    for (const Test &test : getTests()) {
+        int failuresBefore = failures;
+        test.func();
+        printf("%s %s\n", failures == failuresBefore ? "PASS" : "FAIL", test.name);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,20 @@
+// Minimal test runner for the host tests: TEST(name) { CHECK(...); }, each executable runs all of its tests.
+#pragma once
+
+#include <cstdio>
+
+typedef void (*HostTestFunc)();
+
+struct HostTestRegistration {
+    HostTestRegistration(const char* name, HostTestFunc func);
+};
+
+void HostTestFail(const char* file, int line, const char* expression);
+
+#define TEST(name) \
+    static void name(); \
+    static HostTestRegistration name##Registration(#name, name); \
+    static void name()
+
+#define CHECK(expression) \
+    do { if (!(expression)) HostTestFail(__FILE__, __LINE__, #expression); } while (0)
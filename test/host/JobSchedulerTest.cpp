@@ -0,0 +1,195 @@
+#include "HostTest.hpp"
+#include "JobScheduler.hpp"
+#include <esp_timer.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace {
+    // runs on its own task for all tests, jobs left behind by one test do not affect the others
+    JobScheduler& getScheduler()
+    {
+        static JobScheduler scheduler("TestJobs");
+        static bool started = [&]() {
+            scheduler.Begin();
+            return xTaskCreate(JobScheduler::Run, "TestJobs", 4096, &scheduler, 2, nullptr) == pdPASS;
+        }();
+        CHECK(started);
+        return scheduler;
+    }
+
+    int64_t getMs()
+    {
+        return esp_timer_get_time() / 1000;
+    }
+
+    // returns false on timeout
+    template<typename Predicate> bool waitUntil(Predicate predicate, uint32_t timeoutMs = 2000)
+    {
+        int64_t timeout = getMs() + timeoutMs;
+        while (!predicate()) {
+            if (getMs() > timeout)
+                return false;
+            delay(1);
+        }
+        return true;
+    }
+}
+
+TEST(RunsPeriodicJobs)
+{
+    JobScheduler &scheduler = getScheduler();
+    std::atomic<int> runs{0};
+    int64_t started = getMs();
+    JobScheduler::JobId job = scheduler.Every(20, [&runs]() { runs++; }, "periodic");
+    CHECK(job != JobScheduler::kInvalidJob);
+    // first run after one period
+    CHECK(waitUntil([&runs]() { return runs == 1; }));
+    CHECK(getMs() - started >= 20);
+
+    delay(500);
+    CHECK(scheduler.Cancel(job));
+    int runsAtCancel = runs;
+    // drift-free: about every 20 ms, however late single runs are
+    CHECK(runsAtCancel >= 15 && runsAtCancel <= 27);
+    JobScheduler::Stats stats;
+    CHECK(!scheduler.GetStats(job, stats));
+    delay(100);
+    CHECK(runs == runsAtCancel);
+}
+
+TEST(RunsOneShotJobsOnce)
+{
+    JobScheduler &scheduler = getScheduler();
+    std::atomic<int> runs{0};
+    int64_t started = getMs();
+    std::atomic<int64_t> ranAt{0};
+    JobScheduler::JobId job = scheduler.After(30, [&]() { runs++; ranAt = getMs(); });
+    CHECK(waitUntil([&runs]() { return runs == 1; }));
+    CHECK(ranAt - started >= 30);
+    delay(100);
+    CHECK(runs == 1);
+    // gone once it has run, also for an id reusing its entry
+    CHECK(!scheduler.Cancel(job));
+    JobScheduler::JobId next = scheduler.After(1000, []() {});
+    CHECK((next & 0xff) == (job & 0xff));
+    CHECK(!scheduler.Cancel(job));
+    CHECK(scheduler.Cancel(next));
+
+    std::atomic<bool> immediate{false};
+    scheduler.After(0, [&immediate]() { immediate = true; });
+    CHECK(waitUntil([&immediate]() { return immediate.load(); }, 50));
+}
+
+TEST(RunsJobsInOrderOfDueTime)
+{
+    JobScheduler &scheduler = getScheduler();
+    std::mutex mutex;
+    std::vector<int> order;
+    // added in reverse order, partly within the same 10 ms tick
+    for (int delayMs : { 95, 60, 55, 30, 3, 1 }) {
+        scheduler.After(delayMs, [&, delayMs]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(delayMs);
+        });
+    }
+    CHECK(waitUntil([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order.size() == 6;
+    }));
+    CHECK(order == std::vector<int>({ 1, 3, 30, 55, 60, 95 }));
+}
+
+TEST(WaitsForJobsBeyondOneRoundOfTheWheel)
+{
+    JobScheduler &scheduler = getScheduler();
+    // the wheel covers 640 ms, so these share slots with earlier rounds
+    const int64_t delaysMs[] = { 700, 1280 + 50 };
+    std::atomic<int64_t> ranAt[2];
+    int64_t started = getMs();
+    for (int i = 0; i < 2; i++) {
+        ranAt[i] = 0;
+        scheduler.After(delaysMs[i], [&ranAt, i]() { ranAt[i] = getMs(); });
+    }
+    // something in every slot of the first round
+    JobScheduler::JobId busy = scheduler.Every(10, []() {});
+    CHECK(waitUntil([&ranAt]() { return ranAt[1] != 0; }, 3000));
+    scheduler.Cancel(busy);
+    for (int i = 0; i < 2; i++)
+        CHECK(ranAt[i] - started >= delaysMs[i] && ranAt[i] - started < delaysMs[i] + 200);
+}
+
+TEST(DoesNotRunLongPeriodsEarly)
+{
+    JobScheduler &scheduler = getScheduler();
+    std::atomic<int> runs{0};
+    // just beyond 32 bits of microseconds, 704 us if truncated to them
+    const uint32_t longMs = 4294968;
+    JobScheduler::JobId periodic = scheduler.Every(longMs, [&runs]() { runs++; });
+    JobScheduler::JobId oneShot = scheduler.After(longMs, [&runs]() { runs++; });
+    delay(200);
+    CHECK(runs == 0);
+    CHECK(scheduler.Cancel(periodic));
+    CHECK(scheduler.Cancel(oneShot));
+}
+
+TEST(CancelsFromWithinJobs)
+{
+    JobScheduler &scheduler = getScheduler();
+    std::atomic<int> runs{0};
+    std::atomic<int> otherRuns{0};
+    JobScheduler::JobId other = scheduler.Every(10, [&otherRuns]() { otherRuns++; });
+    std::atomic<JobScheduler::JobId> self{JobScheduler::kInvalidJob};
+    std::atomic<bool> cancelled{false};
+    self = scheduler.Every(10, [&]() {
+        if (++runs == 3) {
+            cancelled = scheduler.Cancel(self) && scheduler.Cancel(other);
+        }
+    });
+    CHECK(waitUntil([&cancelled]() { return cancelled.load(); }));
+    int otherRunsAtCancel = otherRuns;
+    delay(100);
+    CHECK(runs == 3);
+    CHECK(otherRuns == otherRunsAtCancel);
+    CHECK(!scheduler.Cancel(self));
+}
+
+TEST(CountsOverruns)
+{
+    JobScheduler &scheduler = getScheduler();
+    std::atomic<int> runs{0};
+    // takes 3.5 periods
+    JobScheduler::JobId job = scheduler.Every(10, [&runs]() {
+        runs++;
+        delay(35);
+    }, "slow");
+    CHECK(waitUntil([&runs]() { return runs >= 5; }));
+    JobScheduler::Stats stats;
+    CHECK(scheduler.GetStats(job, stats));
+    scheduler.Cancel(job);
+    // skips three runs each time
+    CHECK(stats.overruns >= 3 * (stats.runs - 1));
+    CHECK(stats.maxRunTimeUs >= 35 * 1000);
+    // but starts the next one right away
+    CHECK(stats.maxJitterUs < 20 * 1000);
+}
+
+TEST(LimitsJobs)
+{
+    JobScheduler scheduler("TestLimits");
+    scheduler.Begin();
+    CHECK(scheduler.Every(0, []() {}) == JobScheduler::kInvalidJob);
+    std::vector<JobScheduler::JobId> jobs;
+    size_t invalid = 0;
+    for (size_t i = 0; i < JobScheduler::kMaxJobs; i++) {
+        jobs.push_back(scheduler.After(1000, []() {}));
+        invalid += jobs.back() == JobScheduler::kInvalidJob;
+    }
+    CHECK(invalid == 0);
+    CHECK(scheduler.After(1000, []() {}) == JobScheduler::kInvalidJob);
+    CHECK(scheduler.Cancel(jobs[5]));
+    CHECK(scheduler.After(1000, []() {}) != JobScheduler::kInvalidJob);
+    CHECK(!scheduler.Cancel(JobScheduler::kInvalidJob));
+    CHECK(!scheduler.Cancel(0x7fff00ff));
+}
@@ -0,0 +1,140 @@
+#include "HostTest.hpp"
+#include "Metrics.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace {
+    String writeAll(const MetricsRegistry &registry)
+    {
+        String output;
+        for (size_t i = 0; registry.WritePrometheusFamily(i, output); i++)
+            ;
+        return output;
+    }
+}
+
+TEST(WritesCountersAndGauges)
+{
+    std::unique_ptr<MetricsRegistry> registry(new MetricsRegistry());
+    MetricsRegistry::Counter counter = registry->AddCounter("test_events_total", "Events");
+    MetricsRegistry::Gauge gauge = registry->AddGauge("test_level", "Level", "sensor=\"a\"");
+    counter.Increment();
+    counter.Increment(41);
+    gauge.Set(10);
+    gauge.Add(-15);
+
+    CHECK(writeAll(*registry) ==
+        "# HELP test_events_total Events\n"
+        "# TYPE test_events_total counter\n"
+        "test_events_total 42\n"
+        "# HELP test_level Level\n"
+        "# TYPE test_level gauge\n"
+        "test_level{sensor=\"a\"} -5\n");
+}
+
+TEST(WritesCountersUnsigned)
+{
+    std::unique_ptr<MetricsRegistry> registry(new MetricsRegistry());
+    MetricsRegistry::Counter counter = registry->AddCounter("test_bytes_total", "Bytes");
+    counter.SetTotal(4000000000u);
+    CHECK(writeAll(*registry).endsWith("test_bytes_total 4000000000\n"));
+}
+
+TEST(WritesCumulativeHistogramBuckets)
+{
+    static const uint32_t bounds[] = { 10, 100 };
+    std::unique_ptr<MetricsRegistry> registry(new MetricsRegistry());
+    MetricsRegistry::Histogram histogram = registry->AddHistogram("test_latency_us", "Latency", bounds, "path=\"/\"");
+    for (uint32_t value : { 5u, 10u, 11u, 100u, 1000u })
+        histogram.Observe(value);
+
+    CHECK(writeAll(*registry) ==
+        "# HELP test_latency_us Latency\n"
+        "# TYPE test_latency_us histogram\n"
+        "test_latency_us_bucket{path=\"/\",le=\"10\"} 2\n"
+        "test_latency_us_bucket{path=\"/\",le=\"100\"} 4\n"
+        "test_latency_us_bucket{path=\"/\",le=\"+Inf\"} 5\n"
+        "test_latency_us_sum{path=\"/\"} 1126\n"
+        "test_latency_us_count{path=\"/\"} 5\n");
+}
+
+TEST(GroupsMetricsOfTheSameNameIntoOneFamily)
+{
+    std::unique_ptr<MetricsRegistry> registry(new MetricsRegistry());
+    registry->AddCounter("test_runs_total", "Runs", "task=\"a\"").Increment(1);
+    registry->AddGauge("test_other", "Other");
+    registry->AddCounter("test_runs_total", "Runs", "task=\"b\"").Increment(2);
+
+    CHECK(registry->GetMetricCount() == 3);
+    String output;
+    CHECK(registry->WritePrometheusFamily(0, output));
+    CHECK(output ==
+        "# HELP test_runs_total Runs\n"
+        "# TYPE test_runs_total counter\n"
+        "test_runs_total{task=\"a\"} 1\n"
+        "test_runs_total{task=\"b\"} 2\n");
+    // already written along with the first one
+    output = "";
+    CHECK(registry->WritePrometheusFamily(2, output));
+    CHECK(output.isEmpty());
+    CHECK(!registry->WritePrometheusFamily(3, output));
+}
+
+TEST(IgnoresMetricsThatDoNotFit)
+{
+    std::unique_ptr<MetricsRegistry> registry(new MetricsRegistry());
+    String longLabels(String("task=\"") + "0123456789012345678901234567890123456789" + "\"");
+    MetricsRegistry::Counter ignored = registry->AddCounter("test_long_total", "Long labels", longLabels);
+    ignored.Increment();
+    CHECK(registry->GetMetricCount() == 0);
+
+    for (size_t i = 0; i < MetricsRegistry::kMaxMetrics; i++)
+        registry->AddGauge("test_gauge", "Gauge", String("index=\"") + String(static_cast<unsigned>(i)) + "\"");
+    MetricsRegistry::Gauge full = registry->AddGauge("test_full", "Full");
+    full.Set(1);
+    CHECK(registry->GetMetricCount() == MetricsRegistry::kMaxMetrics);
+
+    // buckets are limited separately
+    static const uint32_t bounds[MetricsRegistry::kMaxHistogramBuckets] = {};
+    std::unique_ptr<MetricsRegistry> bucketRegistry(new MetricsRegistry());
+    bucketRegistry->AddHistogram("test_histogram", "Too many buckets", bounds).Observe(1);
+    CHECK(bucketRegistry->GetMetricCount() == 0);
+}
+
+TEST(RunsCollectorsBeforeScraping)
+{
+    std::unique_ptr<MetricsRegistry> registry(new MetricsRegistry());
+    MetricsRegistry::Gauge gauge = registry->AddGauge("test_sampled", "Sampled");
+    int collected = 0;
+    CHECK(registry->AddCollector([&]() { gauge.Set(++collected); }));
+    registry->Collect();
+    registry->Collect();
+    CHECK(writeAll(*registry).endsWith("test_sampled 2\n"));
+}
+
+TEST(CountsConcurrentUpdates)
+{
+    static const uint32_t bounds[] = { 1 };
+    std::unique_ptr<MetricsRegistry> registry(new MetricsRegistry());
+    MetricsRegistry::Counter counter = registry->AddCounter("test_concurrent_total", "Concurrent");
+    MetricsRegistry::Histogram histogram = registry->AddHistogram("test_concurrent", "Concurrent", bounds);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 100000; j++) {
+                counter.Increment();
+                histogram.Observe(j & 1);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    String output = writeAll(*registry);
+    CHECK(output.indexOf("test_concurrent_total 400000\n") >= 0);
+    CHECK(output.indexOf("test_concurrent_bucket{le=\"+Inf\"} 400000\n") >= 0);
+    CHECK(output.indexOf("test_concurrent_sum 200000\n") >= 0);
+}
@@ -0,0 +1,137 @@
+#include "HostTest.hpp"
+#include "WebServer/RcuValue.hpp"
+#include "WebServer/WebInterface.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace {
+    std::atomic<int> liveValues{0};
+
+    // keeps track of how many versions exist, with an invariant for readers to check
+    struct Value {
+        int generation = 0;
+        std::vector<int> items;
+
+        Value() { liveValues++; }
+        Value(const Value &other) : generation(other.generation), items(other.items) { liveValues++; }
+        ~Value() { liveValues--; }
+        bool IsConsistent() const { return items.size() == static_cast<size_t>(generation % 16); }
+    };
+
+    void advance(Value &value)
+    {
+        value.generation++;
+        value.items.assign(value.generation % 16, value.generation);
+    }
+}
+
+TEST(PinnedVersionsOutliveUpdates)
+{
+    {
+        RcuValue<Value> value;
+        RcuValue<Value>::Pin first = value.Read();
+        value.Update(advance);
+        RcuValue<Value>::Pin copy = first;
+        value.Update(advance);
+
+        CHECK(first->generation == 0);
+        CHECK(copy->generation == 0);
+        CHECK(value.Read()->generation == 2);
+        // the current one and the pinned first one, the second one has never been pinned
+        CHECK(liveValues == 2);
+
+        first = value.Read();
+        CHECK(liveValues == 2);
+        copy = std::move(first);
+        CHECK(liveValues == 1);
+        CHECK((*copy).generation == 2);
+    }
+    CHECK(liveValues == 0);
+}
+
+TEST(ReadersNeverSeePartialUpdates)
+{
+    {
+        RcuValue<Value> value;
+        std::atomic<bool> stop{false};
+        std::atomic<int> inconsistent{0};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; i++) {
+            readers.emplace_back([&]() {
+                int lastGeneration = 0;
+                while (!stop) {
+                    RcuValue<Value>::Pin pin = value.Read();
+                    RcuValue<Value>::Pin kept = pin;
+                    // versions only ever move forward
+                    if (!pin->IsConsistent() || pin->generation < lastGeneration)
+                        inconsistent++;
+                    lastGeneration = pin->generation;
+                    std::this_thread::yield();
+                    if (!kept->IsConsistent() || kept->generation != lastGeneration)
+                        inconsistent++;
+                }
+            });
+        }
+        for (int i = 0; i < 20000; i++)
+            value.Update(advance);
+        stop = true;
+        for (auto &reader : readers)
+            reader.join();
+
+        CHECK(inconsistent == 0);
+        CHECK(value.Read()->generation == 20000);
+        // every superseded version has been freed by whoever came last
+        CHECK(liveValues == 1);
+    }
+    CHECK(liveValues == 0);
+}
+
+TEST(CopiesShareTexts)
+{
+    UiModel model;
+    size_t index = model.Add(UiText::Static("status"), UiText::Static("p"), UiText::Copy("connected"), UiText::Static("#wrapper"));
+    model.SetAttribute(index, UiText::Static("class"), UiText::Copy("good"));
+
+    UiModel copy(model);
+    CHECK(copy[index].content.c_str() == model[index].content.c_str());
+    CHECK(copy[index].id.c_str() == model[index].id.c_str());
+    CHECK(copy.GetAttribute(index, "class") == model.GetAttribute(index, "class"));
+    CHECK(copy.Find("status") == static_cast<int>(index));
+
+    // changing the copy leaves the original alone
+    copy.SetContent(index, UiText::Copy("disconnected"));
+    CHECK(model[index].content == "connected");
+    CHECK(copy[index].content == "disconnected");
+
+    // texts outlive the model they have been created in
+    std::unique_ptr<UiModel> survivor;
+    {
+        UiModel temporary;
+        temporary.Add(UiText::Static("id"), UiText::Static("p"), UiText::Copy("text"), UiText::Static("body"));
+        survivor.reset(new UiModel(temporary));
+    }
+    CHECK((*survivor)[0].content == "text");
+}
+
+TEST(UpdatesOnlyAllocateChangedTexts)
+{
+    RcuValue<UiModel> ui;
+    ui.Update([](UiModel &model) {
+        for (int i = 0; i < 50; i++)
+            model.Add(UiText::Copy(String("element") + String(i)), UiText::Static("p"), UiText::Copy("content"), UiText::Static("body"));
+    });
+
+    RcuValue<UiModel>::Pin before = ui.Read();
+    ui.Update([](UiModel &model) { model.SetContent(model.Find("element7"), UiText::Copy("changed")); });
+    RcuValue<UiModel>::Pin after = ui.Read();
+
+    CHECK(after->Size() == 50);
+    CHECK((*after)[7].content == "changed");
+    CHECK((*before)[7].content == "content");
+    size_t shared = 0;
+    for (size_t i = 0; i < after->Size(); i++)
+        shared += (*after)[i].content.c_str() == (*before)[i].content.c_str();
+    CHECK(shared == 49);
+}
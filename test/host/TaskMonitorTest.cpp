@@ -0,0 +1,172 @@
+#include "HostTest.hpp"
+#include "TaskMonitor.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace {
+    struct Stall {
+        std::string task;
+        uint32_t lateMs;
+        TaskMonitor::StallAction action;
+    };
+
+    // what the monitored task does, set by the test while it is running
+    struct Scenario {
+        TaskMonitor* monitor;
+        TaskMonitor::StallAction action = TaskMonitor::StallAction::alert;
+        std::atomic<bool> beating{true};
+        std::atomic<bool> stop{false};
+        std::atomic<bool> stopped{false};
+        std::atomic<int> starts{0};
+        std::atomic<int> heartbeatsExpected{0};
+    };
+
+    // beats every 5 ms, but only while beating is set, the first start stops beating for good after 100 ms if wanted
+    void monitoredTask(void* scenarioPointer)
+    {
+        Scenario &scenario = *static_cast<Scenario*>(scenarioPointer);
+        int start = ++scenario.starts;
+        if (scenario.monitor->ExpectHeartbeats(50, scenario.action))
+            scenario.heartbeatsExpected++;
+        while (!scenario.stop) {
+            if (scenario.beating || start > 1)
+                TaskMonitor::Heartbeat();
+            vTaskDelay(5);
+        }
+        scenario.stopped = true;
+        vTaskDelete(nullptr);
+    }
+
+    // the monitored tasks keep using the monitor until they are stopped, so it is never freed
+    TaskMonitor* createMonitor(std::vector<Stall> &stalls, std::mutex &stallsMutex)
+    {
+        TaskMonitor* monitor = new TaskMonitor();
+        monitor->Begin();
+        monitor->OnStall([&](const char* task, uint32_t lateMs, TaskMonitor::StallAction action) {
+            std::lock_guard<std::mutex> lock(stallsMutex);
+            stalls.push_back({ task, lateMs, action });
+        });
+        return monitor;
+    }
+
+    // supervises (every 10 ms instead of every second) for the given time
+    void supervise(TaskMonitor &monitor, uint32_t ms)
+    {
+        for (uint32_t elapsed = 0; elapsed < ms; elapsed += 10) {
+            monitor.Supervise();
+            delay(10);
+        }
+    }
+
+    bool stopTask(Scenario &scenario)
+    {
+        scenario.stop = true;
+        for (int i = 0; i < 100 && !scenario.stopped; i++)
+            delay(5);
+        return scenario.stopped;
+    }
+
+    String getMetrics()
+    {
+        String output;
+        for (size_t i = 0; Metrics.WritePrometheusFamily(i, output); i++)
+            ;
+        return output;
+    }
+}
+
+TEST(AlertsOnStallsAndResumedHeartbeats)
+{
+    std::vector<Stall> stalls;
+    std::mutex stallsMutex;
+    Scenario scenario;
+    scenario.monitor = createMonitor(stalls, stallsMutex);
+    CHECK(scenario.monitor->Create(monitoredTask, "TestAlert", 4096, &scenario, 1, TaskMonitor::kLeastLoadedCore));
+
+    supervise(*scenario.monitor, 150);
+    CHECK(scenario.heartbeatsExpected == 1);
+    CHECK(stalls.empty());
+
+    scenario.beating = false;
+    supervise(*scenario.monitor, 200);
+    {
+        std::lock_guard<std::mutex> lock(stallsMutex);
+        // once per stall, however long it lasts
+        CHECK(stalls.size() == 1);
+        if (stalls.size() == 1) {
+            CHECK(stalls[0].task == "TestAlert");
+            CHECK(stalls[0].lateMs > 0 && stalls[0].lateMs < 100);
+            CHECK(stalls[0].action == TaskMonitor::StallAction::alert);
+        }
+    }
+
+    // resuming ends the stall, the next one gets reported again
+    scenario.beating = true;
+    supervise(*scenario.monitor, 100);
+    CHECK(stalls.size() == 1);
+    CHECK(getMetrics().indexOf("iotbase_task_heartbeat_lateness_milliseconds_count 1\n") >= 0);
+    scenario.beating = false;
+    supervise(*scenario.monitor, 200);
+    CHECK(stalls.size() == 2);
+    CHECK(getMetrics().indexOf("iotbase_task_stalls_total{task=\"TestAlert\"} 2\n") >= 0);
+    CHECK(scenario.starts == 1);
+    CHECK(stopTask(scenario));
+}
+
+TEST(RestartsStalledTasks)
+{
+    std::vector<Stall> stalls;
+    std::mutex stallsMutex;
+    Scenario scenario;
+    scenario.action = TaskMonitor::StallAction::restartTask;
+    scenario.monitor = createMonitor(stalls, stallsMutex);
+    CHECK(scenario.monitor->Create(monitoredTask, "TestRestart", 4096, &scenario, 1, 0));
+
+    supervise(*scenario.monitor, 100);
+    scenario.beating = false;
+    supervise(*scenario.monitor, 300);
+
+    // the restarted task expects heartbeats again and keeps beating
+    CHECK(scenario.starts == 2);
+    CHECK(scenario.heartbeatsExpected == 2);
+    CHECK(stalls.size() == 1);
+    CHECK(stalls.size() == 1 && stalls[0].action == TaskMonitor::StallAction::restartTask);
+    CHECK(stopTask(scenario));
+}
+
+TEST(ExpectsHeartbeatsOnlyFromMonitoredTasks)
+{
+    std::vector<Stall> stalls;
+    std::mutex stallsMutex;
+    TaskMonitor* monitor = createMonitor(stalls, stallsMutex);
+
+    // not added at all
+    Scenario unmonitored;
+    unmonitored.monitor = monitor;
+    xTaskCreate(monitoredTask, "TestUnmonitored", 4096, &unmonitored, 1, nullptr);
+    // added, but cannot be restarted without having been created by the monitor
+    Scenario added;
+    added.monitor = monitor;
+    added.action = TaskMonitor::StallAction::restartTask;
+    TaskHandle_t handle;
+    xTaskCreate(monitoredTask, "TestAdded", 4096, &added, 1, &handle);
+    monitor->Add(handle, tskNO_AFFINITY);
+
+    // waits up to 100 ms for the creator to add the task
+    delay(300);
+    CHECK(unmonitored.starts == 1 && unmonitored.heartbeatsExpected == 0);
+    CHECK(added.starts == 1 && added.heartbeatsExpected == 0);
+    unmonitored.beating = false;
+    added.beating = false;
+    supervise(*monitor, 200);
+    CHECK(stalls.empty());
+
+    // does nothing on other tasks
+    TaskMonitor::Heartbeat();
+    CHECK(TaskMonitor::GetHeartbeatPeriod() == 0);
+    CHECK(stopTask(unmonitored));
+    CHECK(stopTask(added));
+}
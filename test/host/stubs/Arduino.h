@@ -0,0 +1,99 @@
+// Host stand-in for the parts of Arduino-ESP32 used by the library.
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "esp_err.h"
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+
+#define IRAM_ATTR
+#define RTC_NOINIT_ATTR
+
+void delay(uint32_t ms);
+unsigned long millis();
+
+// part of newlib, but only of glibc since 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+size_t strlcpy(char* destination, const char* source, size_t size);
+#endif
+
+class EspClass {
+    public:
+        void restart() { esp_restart(); }
+};
+extern EspClass ESP;
+
+// Arduino's String on top of std::string
+class String {
+    public:
+        String() = default;
+        String(const char* text) : text_(text ? text : "") {}
+        String(const std::string &text) : text_(text) {}
+        explicit String(char character) : text_(1, character) {}
+        explicit String(int value) : text_(std::to_string(value)) {}
+        explicit String(unsigned value) : text_(std::to_string(value)) {}
+        explicit String(long value) : text_(std::to_string(value)) {}
+        explicit String(unsigned long value) : text_(std::to_string(value)) {}
+        explicit String(long long value) : text_(std::to_string(value)) {}
+        explicit String(unsigned long long value) : text_(std::to_string(value)) {}
+
+        const char* c_str() const { return text_.c_str(); }
+        unsigned length() const { return text_.length(); }
+        bool isEmpty() const { return text_.empty(); }
+        bool reserve(unsigned size) { text_.reserve(size); return true; }
+        char operator[](unsigned index) const { return index < text_.length() ? text_[index] : 0; }
+        char& operator[](unsigned index) { return text_[index]; }
+
+        String& operator+=(const String &other) { text_ += other.text_; return *this; }
+        String& operator+=(const char* other) { text_ += other ? other : ""; return *this; }
+        String& operator+=(char other) { text_ += other; return *this; }
+        String& operator+=(int other) { text_ += std::to_string(other); return *this; }
+        String& operator+=(unsigned other) { text_ += std::to_string(other); return *this; }
+        bool concat(const String &other) { text_ += other.text_; return true; }
+        bool concat(const char* other, unsigned length) { text_.append(other, length); return true; }
+
+        bool operator==(const String &other) const { return text_ == other.text_; }
+        bool operator==(const char* other) const { return text_ == (other ? other : ""); }
+        bool operator!=(const String &other) const { return text_ != other.text_; }
+        bool operator!=(const char* other) const { return !(*this == other); }
+        bool operator<(const String &other) const { return text_ < other.text_; }
+        bool equals(const String &other) const { return *this == other; }
+
+        bool startsWith(const String &prefix) const { return text_.compare(0, prefix.text_.length(), prefix.text_) == 0; }
+        bool endsWith(const String &suffix) const {
+            return text_.length() >= suffix.text_.length() && text_.compare(text_.length() - suffix.text_.length(), std::string::npos, suffix.text_) == 0;
+        }
+        int indexOf(char character, unsigned from = 0) const {
+            size_t position = text_.find(character, from);
+            return position == std::string::npos ? -1 : static_cast<int>(position);
+        }
+        int indexOf(const String &text, unsigned from = 0) const {
+            size_t position = text_.find(text.text_, from);
+            return position == std::string::npos ? -1 : static_cast<int>(position);
+        }
+        String substring(unsigned from) const { return from < text_.length() ? String(text_.substr(from)) : String(); }
+        String substring(unsigned from, unsigned to) const { return from < to && from < text_.length() ? String(text_.substr(from, to - from)) : String(); }
+        void trim() {
+            size_t begin = text_.find_first_not_of(" \t\r\n");
+            size_t end = text_.find_last_not_of(" \t\r\n");
+            text_ = begin == std::string::npos ? std::string() : text_.substr(begin, end - begin + 1);
+        }
+        long toInt() const { return strtol(text_.c_str(), nullptr, 10); }
+
+    private:
+        std::string text_;
+};
+
+inline String operator+(const String &left, const String &right) { String result(left); result += right; return result; }
+inline String operator+(const String &left, const char* right) { String result(left); result += right; return result; }
+inline String operator+(const char* left, const String &right) { String result(left); result += right; return result; }
+inline String operator+(const String &left, char right) { String result(left); result += right; return result; }
+inline bool operator==(const char* left, const String &right) { return right == left; }
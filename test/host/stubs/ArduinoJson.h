@@ -0,0 +1,4 @@
+// Host stand-in for ArduinoJson: only the types named by headers of tested code, there is no implementation.
+#pragma once
+
+class JsonObject {};
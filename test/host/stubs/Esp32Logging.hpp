@@ -0,0 +1,12 @@
+// Host stand-in for Esp32ExtendedLogging: errors and warnings go to stderr, everything else is dropped.
+#pragma once
+
+#include <Arduino.h>
+#include <cstdio>
+
+#define ESP_LOGE(tag, format, ...) fprintf(stderr, "E (%s) " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) fprintf(stderr, "W (%s) " format "\n", tag, ##__VA_ARGS__)
+// still compiled, so the arguments count as used
+#define ESP_LOGI(tag, format, ...) do { if (0) fprintf(stderr, format, ##__VA_ARGS__); } while (0)
+#define ESP_LOGD(tag, format, ...) do { if (0) fprintf(stderr, format, ##__VA_ARGS__); } while (0)
+#define ESP_LOGV(tag, format, ...) do { if (0) fprintf(stderr, format, ##__VA_ARGS__); } while (0)
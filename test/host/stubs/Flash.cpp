@@ -0,0 +1,121 @@
+#include "HostFlash.hpp"
+#include <esp_ota_ops.h>
+#include <esp_spi_flash.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+
+namespace {
+    const esp_partition_t partitions[2] = {
+        { 0x10000, kHostFlashPartitionSize, "app0" },
+        { 0x10000 + kHostFlashPartitionSize, kHostFlashPartitionSize, "app1" },
+    };
+
+    std::mutex mutex;
+    std::vector<uint8_t> contents[2] = {
+        std::vector<uint8_t>(kHostFlashPartitionSize, 0xff), std::vector<uint8_t>(kHostFlashPartitionSize, 0xff) };
+    HostFlashStats stats = { std::vector<size_t>(kHostFlashPartitionSize / SPI_FLASH_SEC_SIZE), 0, false };
+    size_t failWritesFrom = SIZE_MAX;
+    esp_err_t failWritesError = ESP_OK;
+
+    // nullptr if it is not one of ours or the range does not fit
+    std::vector<uint8_t>* getContents(const esp_partition_t* partition, size_t offset, size_t length)
+    {
+        if (partition != &partitions[0] && partition != &partitions[1])
+            return nullptr;
+        if (offset > partition->size || length > partition->size - offset)
+            return nullptr;
+        return &contents[partition - partitions];
+    }
+}
+
+void HostFlashReset(const std::vector<uint8_t> &runningImage)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    contents[0].assign(kHostFlashPartitionSize, 0xff);
+    std::copy(runningImage.begin(), runningImage.begin() + std::min(runningImage.size(), kHostFlashPartitionSize), contents[0].begin());
+    contents[1].assign(kHostFlashPartitionSize, 0xff);
+    stats = { std::vector<size_t>(kHostFlashPartitionSize / SPI_FLASH_SEC_SIZE), 0, false };
+    failWritesFrom = SIZE_MAX;
+    failWritesError = ESP_OK;
+}
+
+std::vector<uint8_t> HostFlashGetUpdatePartition()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return contents[1];
+}
+
+HostFlashStats HostFlashGetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void HostFlashFailWritesFrom(size_t offset, esp_err_t error)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    failWritesFrom = offset;
+    failWritesError = error;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<uint8_t>* partitionContents = getContents(partition, offset, length);
+    if (!partitionContents)
+        return ESP_ERR_INVALID_ARG;
+    memcpy(data, partitionContents->data() + offset, length);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t offset, const void* data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<uint8_t>* partitionContents = getContents(partition, offset, length);
+    if (!partitionContents)
+        return ESP_ERR_INVALID_ARG;
+    if (partition == &partitions[1] && offset + length > failWritesFrom)
+        return failWritesError;
+    stats.writes++;
+    for (size_t i = 0; i < length; i++)
+        (*partitionContents)[offset + i] &= static_cast<const uint8_t*>(data)[i];
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t length)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<uint8_t>* partitionContents = getContents(partition, offset, length);
+    if (!partitionContents || offset % SPI_FLASH_SEC_SIZE || length % SPI_FLASH_SEC_SIZE)
+        return ESP_ERR_INVALID_ARG;
+    memset(partitionContents->data() + offset, 0xff, length);
+    if (partition == &partitions[1]) {
+        for (size_t sector = offset / SPI_FLASH_SEC_SIZE; sector < (offset + length) / SPI_FLASH_SEC_SIZE; sector++)
+            stats.sectorErases[sector]++;
+    }
+    return ESP_OK;
+}
+
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t*)
+{
+    return &partitions[1];
+}
+
+const esp_partition_t* esp_ota_get_running_partition()
+{
+    return &partitions[0];
+}
+
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* partition)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (partition != &partitions[1])
+        return ESP_ERR_INVALID_ARG;
+    if (contents[1][0] != 0xe9)
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    stats.bootPartitionSet = true;
+    return ESP_OK;
+}
@@ -0,0 +1,288 @@
+#include "freertos/FreeRTOS.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+struct HostTask {
+    std::string name;
+    std::atomic<bool> deleted{false};
+    std::mutex mutex;
+    std::condition_variable notified;
+    uint32_t notifications = 0;
+};
+
+struct HostQueue {
+    size_t length;
+    size_t itemSize;
+    std::deque<std::vector<uint8_t>> items;
+    std::mutex mutex;
+    std::condition_variable changed;
+};
+
+struct HostEventGroup {
+    EventBits_t bits = 0;
+    std::mutex mutex;
+    std::condition_variable changed;
+};
+
+namespace {
+    // ends the thread of a task deleting itself (unwinding its stack)
+    struct TaskExit {};
+
+    const std::chrono::steady_clock::time_point kStart = std::chrono::steady_clock::now();
+
+    std::mutex tasksMutex;
+    std::vector<HostTask*> tasks;       // never freed, handles stay valid
+    thread_local HostTask* currentTask = nullptr;
+
+    HostTask* addTask(const char* name)
+    {
+        HostTask* task = new HostTask();
+        task->name = name ? name : "";
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        tasks.push_back(task);
+        return task;
+    }
+
+    // waits for predicate with the FreeRTOS timeout semantics, returns its result
+    template<typename Predicate> bool waitFor(std::condition_variable &condition, std::unique_lock<std::mutex> &lock, TickType_t ticksToWait,
+                                               Predicate predicate)
+    {
+        if (ticksToWait == portMAX_DELAY) {
+            condition.wait(lock, predicate);
+            return true;
+        }
+        return condition.wait_for(lock, std::chrono::milliseconds(ticksToWait), predicate);
+    }
+}
+
+int64_t esp_timer_get_time()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - kStart).count();
+}
+
+void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+unsigned long millis()
+{
+    return esp_timer_get_time() / 1000;
+}
+
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+size_t strlcpy(char* destination, const char* source, size_t size)
+{
+    size_t length = strlen(source);
+    if (size) {
+        size_t copied = std::min(length, size - 1);
+        memcpy(destination, source, copied);
+        destination[copied] = 0;
+    }
+    return length;
+}
+#endif
+
+EspClass ESP;
+
+const char* esp_err_to_name(esp_err_t error)
+{
+    return error == ESP_OK ? "ESP_OK" : "ERROR";
+}
+
+void esp_restart()
+{
+    fflush(nullptr);
+    _Exit(3);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t func, const char* name, uint32_t, void* parameter, UBaseType_t, TaskHandle_t* handle,
+                                   BaseType_t)
+{
+    HostTask* task = addTask(name);
+    if (handle)
+        *handle = task;
+    std::thread([task, func, parameter]() {
+        currentTask = task;
+        try {
+            func(parameter);
+        } catch (const TaskExit&) {
+        }
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t func, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority, TaskHandle_t* handle)
+{
+    return xTaskCreatePinnedToCore(func, name, stackSize, parameter, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t handle)
+{
+    if (!handle || handle == currentTask) {
+        xTaskGetCurrentTaskHandle()->deleted = true;
+        throw TaskExit();
+    }
+    handle->deleted = true;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    delay(ticks);
+    if (currentTask && currentTask->deleted)
+        throw TaskExit();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    // threads not created by xTaskCreate() (e.g. main()) get registered as needed
+    if (!currentTask)
+        currentTask = addTask("main");
+    return currentTask;
+}
+
+const char* pcTaskGetTaskName(TaskHandle_t handle)
+{
+    return (handle ? handle : xTaskGetCurrentTaskHandle())->name.c_str();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t)
+{
+    return 1024;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks()
+{
+    std::lock_guard<std::mutex> lock(tasksMutex);
+    return tasks.size();
+}
+
+TickType_t xTaskGetTickCount()
+{
+    return static_cast<TickType_t>(esp_timer_get_time() / 1000);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle)
+{
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    handle->notifications++;
+    handle->notified.notify_all();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait)
+{
+    HostTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    waitFor(task->notified, lock, ticksToWait, [task]() { return task->notifications != 0; });
+    uint32_t notifications = task->notifications;
+    if (notifications)
+        task->notifications = clearOnExit ? 0 : notifications - 1;
+    return notifications;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    HostQueue* queue = new HostQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->changed, lock, ticksToWait, [queue]() { return queue->items.size() < queue->length; }))
+        return pdFALSE;
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    queue->items.emplace_back(bytes, bytes + (item ? queue->itemSize : 0));
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->changed, lock, ticksToWait, [queue]() { return !queue->items.empty(); }))
+        return pdFALSE;
+    if (item)
+        memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->items.size();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+    // available right away
+    SemaphoreHandle_t semaphore = xQueueCreate(1, 0);
+    xSemaphoreGive(semaphore);
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary()
+{
+    return xQueueCreate(1, 0);
+}
+
+EventGroupHandle_t xEventGroupCreate()
+{
+    return new HostEventGroup();
+}
+
+void vEventGroupDelete(EventGroupHandle_t group)
+{
+    delete group;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    std::lock_guard<std::mutex> lock(group->mutex);
+    group->bits |= bits;
+    group->changed.notify_all();
+    return group->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    std::lock_guard<std::mutex> lock(group->mutex);
+    EventBits_t previous = group->bits;
+    group->bits &= ~bits;
+    return previous;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group)
+{
+    std::lock_guard<std::mutex> lock(group->mutex);
+    return group->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit, BaseType_t waitForAll, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(group->mutex);
+    auto satisfied = [group, bits, waitForAll]() { return waitForAll ? (group->bits & bits) == bits : (group->bits & bits) != 0; };
+    bool success = waitFor(group->changed, lock, ticksToWait, satisfied);
+    EventBits_t result = group->bits;
+    if (success && clearOnExit)
+        group->bits &= ~bits;
+    return result;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <esp_err.h>
+#include <vector>
+
+// The flash stand-in holds two app partitions, the first one running. Like NOR flash, writing can only clear bits, so
+// anything written without erasing first ends up garbled.
+static const size_t kHostFlashPartitionSize = 256 * 1024;
+
+// what the flash stand-in has been asked to do since the last reset
+struct HostFlashStats {
+    std::vector<size_t> sectorErases;   ///< of the update partition, per sector
+    size_t writes;                      ///< esp_partition_write() calls
+    bool bootPartitionSet;
+};
+
+// sets the running image (the rest of its partition erased), erases the update partition
+void HostFlashReset(const std::vector<uint8_t> &runningImage);
+// contents of the update partition
+std::vector<uint8_t> HostFlashGetUpdatePartition();
+HostFlashStats HostFlashGetStats();
+// lets writes to the update partition fail from the given offset on (SIZE_MAX: never)
+void HostFlashFailWritesFrom(size_t offset, esp_err_t error);
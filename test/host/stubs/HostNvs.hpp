@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+
+// what the NVS stand-in has been asked to do since the last reset (which also clears the store)
+struct HostNvsStats {
+    size_t writes;      ///< nvs_set_*() and nvs_erase_key() calls
+    size_t commits;
+};
+
+void HostNvsReset();
+HostNvsStats HostNvsGetStats();
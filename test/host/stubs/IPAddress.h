@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Arduino.h>
+
+class IPAddress {
+    public:
+        IPAddress() : address_{0, 0, 0, 0} {}
+        IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) : address_{first, second, third, fourth} {}
+        // in network order, as lwip has it
+        IPAddress(uint32_t address) { memcpy(address_, &address, 4); }
+        operator uint32_t() const { uint32_t address; memcpy(&address, address_, 4); return address; }
+
+        uint8_t operator[](int index) const { return address_[index]; }
+        uint8_t& operator[](int index) { return address_[index]; }
+        String toString() const {
+            char text[16];
+            snprintf(text, sizeof(text), "%u.%u.%u.%u", address_[0], address_[1], address_[2], address_[3]);
+            return text;
+        }
+
+    private:
+        uint8_t address_[4];
+};
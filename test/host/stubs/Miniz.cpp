@@ -0,0 +1,32 @@
+#include <rom/miniz.h>
+
+
+void tinfl_init(tinfl_decompressor* decompressor)
+{
+    if (decompressor->initialized) {
+        inflateReset(&decompressor->stream);
+        return;
+    }
+    // raw deflate, as in the data part of gzip
+    decompressor->initialized = inflateInit2(&decompressor->stream, -15) == Z_OK;
+}
+
+tinfl_status tinfl_decompress(tinfl_decompressor* decompressor, const mz_uint8* inNext, size_t* inSize, mz_uint8*, mz_uint8* outNext,
+                              size_t* outSize, const mz_uint32)
+{
+    z_stream &stream = decompressor->stream;
+    stream.next_in = const_cast<mz_uint8*>(inNext);
+    stream.avail_in = *inSize;
+    stream.next_out = outNext;
+    stream.avail_out = *outSize;
+    int result = decompressor->initialized ? inflate(&stream, Z_NO_FLUSH) : Z_STREAM_ERROR;
+    *inSize -= stream.avail_in;
+    *outSize -= stream.avail_out;
+
+    if (result == Z_STREAM_END)
+        return TINFL_STATUS_DONE;
+    // no progress possible is not an error for tinfl
+    if (result != Z_OK && result != Z_BUF_ERROR)
+        return TINFL_STATUS_FAILED;
+    return stream.avail_out ? TINFL_STATUS_NEEDS_MORE_INPUT : TINFL_STATUS_HAS_MORE_OUTPUT;
+}
@@ -0,0 +1,110 @@
+#include "HostNvs.hpp"
+#include <nvs_flash.h>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+
+
+namespace {
+    std::mutex mutex;
+    std::map<std::string, std::string> strings;
+    std::map<std::string, int32_t> integers;
+    HostNvsStats stats = {};
+}
+
+void HostNvsReset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    strings.clear();
+    integers.clear();
+    stats = {};
+}
+
+HostNvsStats HostNvsGetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+esp_err_t nvs_flash_init()
+{
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase()
+{
+    HostNvsReset();
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char*, nvs_open_mode, nvs_handle* handle)
+{
+    *handle = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.commits++;
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_all(nvs_handle)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    strings.clear();
+    integers.clear();
+    stats.writes++;
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle, const char* key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.writes++;
+    return strings.erase(key) + integers.erase(key) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_set_str(nvs_handle, const char* key, const char* value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.writes++;
+    strings[key] = value;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_str(nvs_handle, const char* key, char* value, size_t* length)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto entry = strings.find(key);
+    if (entry == strings.end())
+        return ESP_ERR_NVS_NOT_FOUND;
+    size_t required = entry->second.length() + 1;
+    if (value) {
+        if (*length < required)
+            return ESP_ERR_NVS_INVALID_LENGTH;
+        memcpy(value, entry->second.c_str(), required);
+    }
+    *length = required;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_i32(nvs_handle, const char* key, int32_t value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.writes++;
+    integers[key] = value;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_i32(nvs_handle, const char* key, int32_t* value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto entry = integers.find(key);
+    if (entry == integers.end())
+        return ESP_ERR_NVS_NOT_FOUND;
+    *value = entry->second;
+    return ESP_OK;
+}
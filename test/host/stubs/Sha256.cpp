@@ -0,0 +1,29 @@
+#include <mbedtls/sha256.h>
+#include <openssl/evp.h>
+
+
+void mbedtls_sha256_init(mbedtls_sha256_context* context)
+{
+    context->digest = EVP_MD_CTX_new();
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context* context)
+{
+    EVP_MD_CTX_free(static_cast<EVP_MD_CTX*>(context->digest));
+    context->digest = nullptr;
+}
+
+int mbedtls_sha256_starts_ret(mbedtls_sha256_context* context, int is224)
+{
+    return EVP_DigestInit_ex(static_cast<EVP_MD_CTX*>(context->digest), is224 ? EVP_sha224() : EVP_sha256(), nullptr) == 1 ? 0 : -1;
+}
+
+int mbedtls_sha256_update_ret(mbedtls_sha256_context* context, const unsigned char* input, size_t length)
+{
+    return EVP_DigestUpdate(static_cast<EVP_MD_CTX*>(context->digest), input, length) == 1 ? 0 : -1;
+}
+
+int mbedtls_sha256_finish_ret(mbedtls_sha256_context* context, unsigned char output[32])
+{
+    return EVP_DigestFinal_ex(static_cast<EVP_MD_CTX*>(context->digest), output, nullptr) == 1 ? 0 : -1;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "esp_partition.h"
+
+#define ESP_ERR_OTA_VALIDATE_FAILED 0x1503
+
+// two app partitions, the first one is running
+const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* startFrom);
+const esp_partition_t* esp_ota_get_running_partition();
+// only checks the image magic byte
+esp_err_t esp_ota_set_boot_partition(const esp_partition_t* partition);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "esp_err.h"
+
+typedef struct {
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+} esp_partition_t;
+
+// backed by memory, see HostFlash.hpp
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* data, size_t length);
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t offset, const void* data, size_t length);
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t length);
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstdint>
+
+// us since the start of the process (real time)
+int64_t esp_timer_get_time();
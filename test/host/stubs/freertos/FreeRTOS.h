@@ -0,0 +1,82 @@
+// Host stand-in for the parts of FreeRTOS (as in ESP-IDF) used by the library: tasks are std::threads, queues,
+// semaphores, event groups and notifications are built on mutexes and condition variables, a tick is 1 ms of real time.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t EventBits_t;
+
+#define portMAX_DELAY ((TickType_t) 0xffffffff)
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define configTICK_RATE_HZ 1000
+#define configMAX_TASK_NAME_LEN 16
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t) (ms))
+#define tskNO_AFFINITY 0x7fffffff
+#define portNUM_PROCESSORS 2
+#define CONFIG_ARDUINO_RUNNING_CORE 1
+#define CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS 0
+
+// spinlocks are plain (non-recursive) spinlocks here
+struct portMUX_TYPE {
+    std::atomic<bool> locked;
+};
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) do { while ((mux)->locked.exchange(true, std::memory_order_acquire)) std::this_thread::yield(); } while (0)
+#define portEXIT_CRITICAL(mux) (mux)->locked.store(false, std::memory_order_release)
+#define portENTER_CRITICAL_ISR(mux) portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux) portEXIT_CRITICAL(mux)
+
+struct HostTask;
+struct HostQueue;
+struct HostEventGroup;
+typedef HostTask* TaskHandle_t;
+typedef HostQueue* QueueHandle_t;
+typedef HostQueue* SemaphoreHandle_t;
+typedef HostEventGroup* EventGroupHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+// tasks
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t func, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority,
+                                   TaskHandle_t* handle, BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t func, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority, TaskHandle_t* handle);
+// only the calling task can be deleted right away (by ending its thread), other tasks end at their next vTaskDelay()
+void vTaskDelete(TaskHandle_t handle);
+void vTaskDelay(TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+const char* pcTaskGetTaskName(TaskHandle_t handle);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t handle);
+UBaseType_t uxTaskGetNumberOfTasks();
+TickType_t xTaskGetTickCount();
+BaseType_t xTaskNotifyGive(TaskHandle_t handle);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait);
+
+// queues and semaphores
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+#define xQueueSendToBack xQueueSend
+#define xSemaphoreTake(semaphore, ticksToWait) xQueueReceive((semaphore), nullptr, (ticksToWait))
+#define xSemaphoreGive(semaphore) xQueueSend((semaphore), nullptr, 0)
+#define vSemaphoreDelete vQueueDelete
+
+// event groups
+EventGroupHandle_t xEventGroupCreate();
+void vEventGroupDelete(EventGroupHandle_t group);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit, BaseType_t waitForAll, TickType_t ticksToWait);
@@ -0,0 +1,15 @@
+// Host stand-in for the mbedTLS SHA-256 API (as in ESP-IDF 3.x), computed by OpenSSL.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+typedef struct {
+    void* digest;
+} mbedtls_sha256_context;
+
+void mbedtls_sha256_init(mbedtls_sha256_context* context);
+void mbedtls_sha256_free(mbedtls_sha256_context* context);
+int mbedtls_sha256_starts_ret(mbedtls_sha256_context* context, int is224);
+int mbedtls_sha256_update_ret(mbedtls_sha256_context* context, const unsigned char* input, size_t length);
+int mbedtls_sha256_finish_ret(mbedtls_sha256_context* context, unsigned char output[32]);
@@ -0,0 +1,23 @@
+// Host stand-in for NVS: a single in-memory store, see HostNvs.hpp for what tests can inspect.
+#pragma once
+
+#include "esp_err.h"
+#include <cstddef>
+
+typedef uint32_t nvs_handle;
+typedef enum { NVS_READONLY, NVS_READWRITE } nvs_open_mode;
+
+#define ESP_ERR_NVS_BASE 0x1100
+#define ESP_ERR_NVS_NOT_FOUND (ESP_ERR_NVS_BASE + 0x02)
+#define ESP_ERR_NVS_INVALID_LENGTH (ESP_ERR_NVS_BASE + 0x0c)
+#define ESP_ERR_NVS_NO_FREE_PAGES (ESP_ERR_NVS_BASE + 0x0d)
+#define ESP_ERR_NVS_NEW_VERSION_FOUND (ESP_ERR_NVS_BASE + 0x10)
+
+esp_err_t nvs_open(const char* name, nvs_open_mode mode, nvs_handle* handle);
+esp_err_t nvs_commit(nvs_handle handle);
+esp_err_t nvs_erase_all(nvs_handle handle);
+esp_err_t nvs_erase_key(nvs_handle handle, const char* key);
+esp_err_t nvs_set_str(nvs_handle handle, const char* key, const char* value);
+esp_err_t nvs_get_str(nvs_handle handle, const char* key, char* value, size_t* length);
+esp_err_t nvs_set_i32(nvs_handle handle, const char* key, int32_t value);
+esp_err_t nvs_get_i32(nvs_handle handle, const char* key, int32_t* value);
@@ -0,0 +1,35 @@
+// Host stand-in for the parts of the miniz inflater in ROM (tinfl) used by the library, decompressing raw deflate data
+// with zlib. Unlike tinfl, zlib keeps a window of its own, so the output buffer does not have to hold the last 32 KB.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <zlib.h>
+
+typedef uint8_t mz_uint8;
+typedef uint32_t mz_uint32;
+
+#define TINFL_LZ_DICT_SIZE 32768
+#define TINFL_FLAG_HAS_MORE_INPUT 2
+
+typedef enum {
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+struct tinfl_decompressor {
+    z_stream stream = {};
+    bool initialized = false;
+
+    ~tinfl_decompressor() {
+        if (initialized)
+            inflateEnd(&stream);
+    }
+};
+
+void tinfl_init(tinfl_decompressor* decompressor);
+// the whole output buffer is the window (has to be TINFL_LZ_DICT_SIZE), output goes to outNext
+tinfl_status tinfl_decompress(tinfl_decompressor* decompressor, const mz_uint8* inNext, size_t* inSize, mz_uint8* outStart,
+                              mz_uint8* outNext, size_t* outSize, const mz_uint32 flags);
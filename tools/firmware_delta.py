@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+#
+# Esp32IotBase - ESP32 library to simplify the basics of IoT projects
+# by Felix Storm (http://github.com/felixstorm)
+# Licensed under GPLv3. See LICENSE for details.
+#
+# Creates patches between two firmware images for delta updates (see src/FirmwareDelta.hpp for the format), e.g.
+#   firmware_delta.py diff old.bin new.bin update.patch
+#   curl --digest -u admin:<password> -H "Content-Type: application/octet-stream" --data-binary @update.patch http://<device>/update
+# The device has to run exactly old.bin, otherwise the patch gets refused before anything is written.
+# Patches (as well as full images) may be uploaded gzip compressed, which shrinks the add data considerably (see bench).
+#
+#   firmware_delta.py apply old.bin update.patch new.bin    applies a patch the way the device does
+#   firmware_delta.py bench old1.bin new1.bin [old2.bin new2.bin ...]
+#                                                           creates, applies and verifies patches between build pairs and
+#                                                           reports their sizes
+
+import argparse
+import gzip
+import hashlib
+import struct
+import sys
+
+MAGIC = b'IBD1'
+HEADER = struct.Struct('<4sI32sI32s')
+
+END = 0x00
+COPY = 0x01
+ADD = 0x02
+INSERT = 0x03
+
+KEY_LENGTH = 16         # bytes of the old image indexed per position
+KEY_STEP = 4            # old image positions indexed (code is 4 byte aligned anyway)
+MAX_CANDIDATES = 8      # old positions kept per key
+MIN_MATCH = 24          # shorter (approximate) matches are not worth a command
+MIN_COPY = 12           # shorter exact runs within a match stay in the add data
+FAST_BLOCK = 64         # compared as a whole while extending matches
+GIVE_UP = 32            # stop extending after as many bytes without any improvement
+
+
+class PatchError(Exception):
+    pass
+
+
+def build_index(old):
+    index = {}
+    for offset in range(0, len(old) - KEY_LENGTH + 1, KEY_STEP):
+        candidates = index.setdefault(old[offset:offset + KEY_LENGTH], [])
+        if len(candidates) < MAX_CANDIDATES:
+            candidates.append(offset)
+    return index
+
+
+def extend_forward(old, new, old_offset, new_offset):
+    """Length of the approximate match, i.e. as long as it matches at least half of the bytes."""
+    limit = min(len(old) - old_offset, len(new) - new_offset)
+    length = matches = best_length = best_score = 0
+    while length < limit:
+        if length + FAST_BLOCK <= limit and \
+                old[old_offset + length:old_offset + length + FAST_BLOCK] == new[new_offset + length:new_offset + length + FAST_BLOCK]:
+            length += FAST_BLOCK
+            matches += FAST_BLOCK
+        else:
+            if old[old_offset + length] == new[new_offset + length]:
+                matches += 1
+            length += 1
+        score = 2 * matches - length
+        if score > best_score:
+            best_score, best_length = score, length
+        elif length - best_length > GIVE_UP:
+            break
+    return best_length
+
+
+def extend_backward(old, new, old_offset, new_offset, new_start):
+    """Number of bytes matching exactly before the given positions (not going back beyond new_start)."""
+    length = 0
+    while old_offset - length > 0 and new_offset - length > new_start and \
+            old[old_offset - length - 1] == new[new_offset - length - 1]:
+        length += 1
+    return length
+
+
+def find_match(old, new, index, position, new_start, last_shift):
+    """Best (old offset, new offset, length) covering position, None if there is none worth it."""
+    candidates = list(index.get(new[position:position + KEY_LENGTH], ()))
+    # code moved as a whole keeps the same shift for a while
+    if last_shift is not None and 0 <= position + last_shift < len(old):
+        candidates.append(position + last_shift)
+
+    best = None
+    for old_offset in candidates:
+        forward = extend_forward(old, new, old_offset, position)
+        backward = extend_backward(old, new, old_offset, position, new_start)
+        if best is None or forward + backward > best[2]:
+            best = (old_offset - backward, position - backward, forward + backward)
+    if best is None or best[2] < MIN_MATCH:
+        return None
+    return best
+
+
+def encode_match(old, new, old_offset, new_offset, length):
+    """Splits an approximate match into copies (exact runs) and adds (everything else)."""
+    commands = []
+    add_start = 0
+    position = 0
+    while position < length:
+        if old[old_offset + position] != new[new_offset + position]:
+            position += 1
+            continue
+        run = position
+        while run < length and old[old_offset + run] == new[new_offset + run]:
+            run += 1
+        if run - position >= MIN_COPY:
+            if position > add_start:
+                commands.append(encode_add(old, new, old_offset + add_start, new_offset + add_start, position - add_start))
+            commands.append(struct.pack('<BII', COPY, old_offset + position, run - position))
+            add_start = run
+        position = run
+    if length > add_start:
+        commands.append(encode_add(old, new, old_offset + add_start, new_offset + add_start, length - add_start))
+    return commands
+
+
+def encode_add(old, new, old_offset, new_offset, length):
+    data = bytes((new[new_offset + i] - old[old_offset + i]) & 0xff for i in range(length))
+    return struct.pack('<BII', ADD, old_offset, length) + data
+
+
+def diff(old, new):
+    index = build_index(old)
+    commands = [HEADER.pack(MAGIC, len(old), hashlib.sha256(old).digest(), len(new), hashlib.sha256(new).digest())]
+
+    insert_start = position = 0
+    last_shift = None
+    while position < len(new):
+        match = find_match(old, new, index, position, insert_start, last_shift)
+        if match is None:
+            position += 1
+            continue
+        old_offset, new_offset, length = match
+        if new_offset > insert_start:
+            commands.append(struct.pack('<BI', INSERT, new_offset - insert_start) + new[insert_start:new_offset])
+        commands.extend(encode_match(old, new, old_offset, new_offset, length))
+        last_shift = old_offset - new_offset
+        insert_start = position = new_offset + length
+    if len(new) > insert_start:
+        commands.append(struct.pack('<BI', INSERT, len(new) - insert_start) + new[insert_start:])
+
+    commands.append(bytes([END]))
+    return b''.join(commands)
+
+
+def apply(old, patch):
+    """Applies a patch like the device does, including all of its checks."""
+    if len(patch) < HEADER.size:
+        raise PatchError('Incomplete header.')
+    magic, old_size, old_sha256, new_size, new_sha256 = HEADER.unpack_from(patch)
+    if magic != MAGIC:
+        raise PatchError('Not a firmware patch.')
+    if old_size > len(old) or hashlib.sha256(old[:old_size]).digest() != old_sha256:
+        raise PatchError('The old image is not the one expected.')
+    old = old[:old_size]
+
+    def source(offset, length):
+        if offset + length > old_size:
+            raise PatchError('Reading beyond the old image.')
+        return old[offset:offset + length]
+
+    def data(offset, length):
+        if offset + length > len(patch):
+            raise PatchError('Incomplete patch.')
+        return patch[offset:offset + length]
+
+    new = bytearray()
+    position = HEADER.size
+    while True:
+        command = data(position, 1)[0]
+        position += 1
+        if command == END:
+            break
+        elif command == COPY:
+            offset, length = struct.unpack('<II', data(position, 8))
+            position += 8
+            new += source(offset, length)
+        elif command == ADD:
+            offset, length = struct.unpack('<II', data(position, 8))
+            position += 8
+            new += bytes((a + b) & 0xff for a, b in zip(source(offset, length), data(position, length)))
+            position += length
+        elif command == INSERT:
+            length, = struct.unpack('<I', data(position, 4))
+            position += 4
+            new += data(position, length)
+            position += length
+        else:
+            raise PatchError('Unknown patch command.')
+        if len(new) > new_size:
+            raise PatchError('Patch produces more than the image size.')
+
+    if position != len(patch):
+        raise PatchError('Data after the end of the patch.')
+    if len(new) != new_size or hashlib.sha256(new).digest() != new_sha256:
+        raise PatchError('The new image does not match its hash.')
+    return bytes(new)
+
+
+def read(path):
+    with open(path, 'rb') as file:
+        return file.read()
+
+
+def write(path, data):
+    with open(path, 'wb') as file:
+        file.write(data)
+
+
+def command_diff(args):
+    old, new = read(args.old), read(args.new)
+    patch = diff(old, new)
+    if apply(old, patch) != new:
+        raise PatchError('Verification failed.')
+    write(args.patch, patch)
+    print('%s: %u bytes (%.1f%% of %u bytes)' % (args.patch, len(patch), 100.0 * len(patch) / len(new), len(new)))
+    if len(patch) >= len(new):
+        print('Warning: the images hardly have anything in common, a full update is smaller.')
+
+
+def command_apply(args):
+    write(args.new, apply(read(args.old), read(args.patch)))
+
+
+def command_bench(args):
+    if not args.images or len(args.images) % 2:
+        raise PatchError('Expecting pairs of old and new images.')
+
+    print('%-40s %10s %10s %10s %10s %8s %8s' % ('old -> new', 'image', 'image.gz', 'patch', 'patch.gz', 'ratio', 'ratio.gz'))
+    total_image = total_patch = total_patch_gz = 0
+    for old_path, new_path in zip(args.images[0::2], args.images[1::2]):
+        old, new = read(old_path), read(new_path)
+        patch = diff(old, new)
+        if apply(old, patch) != new:
+            raise PatchError('Verification failed for %s -> %s.' % (old_path, new_path))
+        image_gz = len(gzip.compress(new, 9))
+        patch_gz = len(gzip.compress(patch, 9))
+        total_image += len(new)
+        total_patch += len(patch)
+        total_patch_gz += patch_gz
+        name = '%s -> %s' % (old_path, new_path)
+        print('%-40s %10u %10u %10u %10u %7.1f%% %7.1f%%' % (name[-40:], len(new), image_gz, len(patch), patch_gz,
+                                                           100.0 * len(patch) / len(new), 100.0 * patch_gz / len(new)))
+    print('%-40s %10u %10s %10u %10u %7.1f%% %7.1f%%' % ('total', total_image, '', total_patch, total_patch_gz,
+                                                       100.0 * total_patch / total_image, 100.0 * total_patch_gz / total_image))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Delta updates for Esp32IotBase firmware images')
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    parser_diff = subparsers.add_parser('diff', help='create a patch (and verify it)')
+    parser_diff.add_argument('old')
+    parser_diff.add_argument('new')
+    parser_diff.add_argument('patch')
+    parser_diff.set_defaults(func=command_diff)
+
+    parser_apply = subparsers.add_parser('apply', help='apply a patch')
+    parser_apply.add_argument('old')
+    parser_apply.add_argument('patch')
+    parser_apply.add_argument('new')
+    parser_apply.set_defaults(func=command_apply)
+
+    parser_bench = subparsers.add_parser('bench', help='create, apply and verify patches between pairs of builds')
+    parser_bench.add_argument('images', nargs='+', metavar='old new')
+    parser_bench.set_defaults(func=command_bench)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except PatchError as error:
+        print('Error: %s' % error, file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()